@@ -0,0 +1,36 @@
+#pragma software(instanced_tint)
+
+#if defined(VERTEX_SECTION)
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+layout(location = 2) in vec3 i_Offset; // per instance
+layout(location = 3) in vec4 i_Color;  // per instance
+
+layout(std140) uniform Frame { mat4 u_Camera; };
+layout(std140) uniform Draw { mat4 u_Transform; };
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+void main()
+{
+	v_TexCoord = a_TexCoord;
+	v_Color = i_Color;
+	gl_Position = u_Camera * u_Transform * vec4(a_Position + i_Offset, 1.0);
+}
+#endif // defined(VERTEX_SECTION)
+
+#if defined(FRAGMENT_SECTION)
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+layout(std140) uniform Material { vec4 u_Color; };
+uniform sampler2D u_Texture;
+
+layout(location = 0) out vec4 color;
+
+void main()
+{
+	color = texture(u_Texture, v_TexCoord) * u_Color * v_Color;
+}
+#endif // defined(FRAGMENT_SECTION)
@@ -1,9 +1,11 @@
+#pragma software(texture_tint)
+
 #if defined(VERTEX_SECTION)
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
 
-uniform mat4 u_Camera;
-uniform mat4 u_Transform;
+layout(std140) uniform Frame { mat4 u_Camera; };
+layout(std140) uniform Draw { mat4 u_Transform; };
 
 out vec2 v_TexCoord;
 
@@ -17,7 +19,7 @@ void main()
 #if defined(FRAGMENT_SECTION)
 in vec2 v_TexCoord;
 
-uniform vec4 u_Color = vec4(1, 1, 1, 1);
+layout(std140) uniform Material { vec4 u_Color; };
 uniform sampler2D u_Texture;
 
 layout(location = 0) out vec4 color;
@@ -10,17 +10,28 @@ struct Asset_Shader {
 
 struct Asset_Texture {
 	u8 * data; size_t length;
+	svec2 size;
 	enum Data_Type type; u8 channels;
 	enum Texture_Type kind;
 	enum Filter_Type filter_mipmap, filter_min, filter_max;
 	enum Wrap_Type wrap_x, wrap_y;
 };
 
+#define ASSET_MESH_ATTRIBUTES 8
+
+// interleaved vertices, `attributes` lists the components count per location, a zero ends the list
+// - a non-zero `divisor` makes an instance stream, its elements advance once per `divisor` instances
+//   and feed the locations from `location` on, over the mesh it is drawn with
+// - a `transient` one is drawn only in the frame it is loaded, its vertices may go through a per frame ring;
+//   `engine_rendering_vm_end_frame` invalidates it, drawing it later is an error until it is loaded again
 struct Asset_Mesh {
 	u8 * data; size_t length;
 	enum Data_Type type;
+	u8 attributes[ASSET_MESH_ATTRIBUTES];
+	u32 divisor; u8 location;
 	enum Mesh_Frequency frequency;
 	enum Mesh_Access access;
+	bool transient;
 };
 
 #endif // ENGINE_ASSET_TYPES
@@ -3,7 +3,11 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
 #include <intrin.h>
+#endif // _MSC_VER
 
 #if !defined(ENGINE_MALLOC)
 #define ENGINE_MALLOC(size)         malloc(size)
@@ -5,5 +5,6 @@
 
 u64    engine_file_time(cstring path);
 size_t engine_file_read(cstring path, u8 ** buffer, size_t * size);
+bool   engine_file_write(cstring path, u8 const * buffer, size_t size);
 
 #endif // ENGINE_PLATFORM_FILE
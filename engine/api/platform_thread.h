@@ -0,0 +1,18 @@
+#if !defined(ENGINE_PLATFORM_THREAD)
+#define ENGINE_PLATFORM_THREAD
+
+#include "engine/api/primitive_types.h"
+
+typedef void Engine_Thread_Proc(void * data);
+
+struct Engine_Thread;
+struct Engine_Thread * engine_thread_create(Engine_Thread_Proc * proc, void * data);
+void engine_thread_join(struct Engine_Thread * thread); // waits the thread, then frees it
+
+struct Engine_Semaphore;
+struct Engine_Semaphore * engine_semaphore_create(u32 count);
+void engine_semaphore_destroy(struct Engine_Semaphore * semaphore);
+void engine_semaphore_wait(struct Engine_Semaphore * semaphore);
+void engine_semaphore_signal(struct Engine_Semaphore * semaphore);
+
+#endif // ENGINE_PLATFORM_THREAD
@@ -12,6 +12,7 @@ void engine_window_init_context(struct Engine_Window * window);
 void engine_window_deinit_context(struct Engine_Window * window);
 
 void engine_window_update(struct Engine_Window * window);
+void engine_window_display(struct Engine_Window * window); // on the thread of the context
 
 svec2 engine_window_mouse_delta(struct Engine_Window * window);
 svec2 engine_window_mouse_display_position(struct Engine_Window * window);
@@ -0,0 +1,33 @@
+#if !defined(ENGINE_REF_POOL)
+#define ENGINE_REF_POOL
+
+#include "engine/api/ref.h"
+
+#include <stddef.h>
+
+// a generational slot map of fixed size entries, addressed by `Ref`
+// - `acquire` and `release` are O(1), the freed slots are recycled first
+// - `release` bumps the slot generation; stale refs to it fail `get`
+// - grows by chunks; entries never move, their pointers stay valid until released
+// - `claim` takes the slot of a ref chosen elsewhere, e.g. the rendering VM mirrors the pool its stream was recorded with
+// - live refs are kept dense for iteration; `release` reorders them
+// - a zero `entry_size` makes a pool of bare refs
+
+#define ENGINE_REF_POOL_CHUNK_SIZE 64
+#define ENGINE_REF_POOL_MAX_ID (1u << 20) // ids stay below it, so a corrupt `claim` can't grow the pool unbounded
+
+struct Ref_Pool;
+struct Ref_Pool * engine_ref_pool_create(size_t entry_size);
+void engine_ref_pool_destroy(struct Ref_Pool * pool);
+
+struct Ref engine_ref_pool_acquire(struct Ref_Pool * pool); // returns an empty ref when the ids run out
+void * engine_ref_pool_claim(struct Ref_Pool * pool, struct Ref ref); // returns a zeroed entry; NULL for a live slot or an id out of range
+bool engine_ref_pool_release(struct Ref_Pool * pool, struct Ref ref); // returns false for a stale ref
+
+void * engine_ref_pool_get(struct Ref_Pool const * pool, struct Ref ref); // returns NULL for a stale ref
+bool engine_ref_pool_is_valid(struct Ref_Pool const * pool, struct Ref ref);
+
+u32 engine_ref_pool_get_count(struct Ref_Pool const * pool);
+struct Ref engine_ref_pool_get_ref(struct Ref_Pool const * pool, u32 index); // of the live ones
+
+#endif // ENGINE_REF_POOL
@@ -0,0 +1,26 @@
+#if !defined(ENGINE_RENDERING_BATCH)
+#define ENGINE_RENDERING_BATCH
+
+#include "engine/api/primitive_types.h"
+
+// merges rendering buffers recorded in parallel into one ordered submission, copying no instructions
+// - collects the key spans of each added buffer, then orders them by key
+// - equal keys keep the order of `add` calls, then the order of recording
+// - spans point into the buffers, which stay untouched until the batch is submitted
+
+struct Rendering_Buffer;
+struct Rendering_Batch;
+struct Rendering_Batch * engine_rendering_batch_create(void);
+void engine_rendering_batch_destroy(struct Rendering_Batch * batch);
+void engine_rendering_batch_reset(struct Rendering_Batch * batch);
+
+void engine_rendering_batch_add(struct Rendering_Batch * batch, struct Rendering_Buffer const * buffer);
+void engine_rendering_batch_sort(struct Rendering_Batch * batch);
+
+u32 engine_rendering_batch_get_spans_count(struct Rendering_Batch const * batch);
+u8 const * engine_rendering_batch_get_span(struct Rendering_Batch const * batch, u32 index, size_t * length);
+
+// sorts, then feeds the spans to `engine_rendering_vm_update` in order
+void engine_rendering_batch_submit(struct Rendering_Batch * batch);
+
+#endif // ENGINE_RENDERING_BATCH
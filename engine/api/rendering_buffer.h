@@ -0,0 +1,46 @@
+#if !defined(ENGINE_RENDERING_BUFFER)
+#define ENGINE_RENDERING_BUFFER
+
+#include "engine/api/rendering_vm.h"
+
+// a per-frame linear arena of rendering VM instructions
+// - grows by chunks; written instructions never move
+// - `reset` rewinds all the chunks for reuse, freeing nothing
+// - feed each chunk to `engine_rendering_vm_update` in order
+// - a buffer is owned by one thread at a time; record several in parallel, then merge them with a `Rendering_Batch`
+// - `set_key` tags the instructions that follow; contiguous runs of a key are exposed as spans
+
+#define ENGINE_RENDERING_BUFFER_CHUNK_SIZE (64 * 1024)
+
+struct Rendering_Buffer;
+struct Rendering_Buffer * engine_rendering_buffer_create(size_t chunk_size);
+void engine_rendering_buffer_destroy(struct Rendering_Buffer * buffer);
+void engine_rendering_buffer_reset(struct Rendering_Buffer * buffer);
+
+u32 engine_rendering_buffer_get_chunks_count(struct Rendering_Buffer const * buffer);
+u8 const * engine_rendering_buffer_get_chunk(struct Rendering_Buffer const * buffer, u32 index, size_t * length);
+u32 engine_rendering_buffer_get_instructions_count(struct Rendering_Buffer const * buffer); // the next one's index, e.g. a bundle slot
+
+void engine_rendering_buffer_set_key(struct Rendering_Buffer * buffer, u64 key);
+u32 engine_rendering_buffer_get_spans_count(struct Rendering_Buffer const * buffer);
+u8 const * engine_rendering_buffer_get_span(struct Rendering_Buffer const * buffer, u32 index, u64 * key, size_t * length);
+
+#define REGISTRY_RVM_INSTRUCTION(name, scope) void engine_rendering_buffer_emit_ ## name(struct Rendering_Buffer * buffer, struct RVM_ ## name payload);
+#include "engine/registry/rendering_vm_instruction.h"
+
+// `Shader_Uniform` with its values inlined into the stream
+void engine_rendering_buffer_emit_uniform(struct Rendering_Buffer * buffer, struct RVM_Shader_Uniform payload, void const * data, size_t size);
+
+// `Render_Draw_Indirect` with its `count` arguments inlined into the stream
+void engine_rendering_buffer_emit_draws(struct Rendering_Buffer * buffer, struct RVM_Render_Draw_Indirect payload, struct RVM_Draw_Arguments const * arguments);
+
+// `Bundle_Allocate` with the instructions of another buffer inlined into the stream
+void engine_rendering_buffer_emit_bundle(struct Rendering_Buffer * buffer, struct RVM_Bundle_Allocate payload, struct Rendering_Buffer const * bundle);
+
+// `Bundle_Patch` with the single instruction of another buffer inlined into the stream
+void engine_rendering_buffer_emit_patch(struct Rendering_Buffer * buffer, struct RVM_Bundle_Patch payload, struct Rendering_Buffer const * instruction);
+
+// fills `arguments` from single instance sub-ranges of a mesh, merging the adjacent ones; returns the arguments count
+u32 engine_rendering_buffer_fill_draws(struct RVM_Draw_Arguments * arguments, struct RVM_Render_Draw const * ranges, u32 count);
+
+#endif // ENGINE_RENDERING_BUFFER
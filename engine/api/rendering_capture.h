@@ -0,0 +1,36 @@
+#if !defined(ENGINE_RENDERING_CAPTURE)
+#define ENGINE_RENDERING_CAPTURE
+
+#include "engine/api/primitive_types.h"
+
+// records every stream fed to `engine_rendering_vm_update` into a single file, for a deterministic replay
+// - asset payloads of the `Shader_Load`, `Mesh_*`, `Texture_*` instructions are copied into the file
+// - `begin` ... `end` brackets a recording, the file is written at `end`
+// - `frame` marks a frame boundary, call it after the last stream of the frame
+// - a capture is bound to the ABI it was recorded with
+// - a capture begun on a VM with live resources misses their allocations, it is loaded but not replayed
+
+void engine_rendering_capture_begin(cstring path);
+void engine_rendering_capture_end(void);
+void engine_rendering_capture_frame(void);
+bool engine_rendering_capture_is_active(void);
+
+void engine_rendering_capture_record(u8 const * buffer, size_t buffer_length);
+
+struct Rendering_Capture;
+struct Rendering_Capture * engine_rendering_capture_load(cstring path);
+void engine_rendering_capture_free(struct Rendering_Capture * capture);
+
+u32 engine_rendering_capture_get_frames_count(struct Rendering_Capture const * capture);
+u32 engine_rendering_capture_get_streams_count(struct Rendering_Capture const * capture, u32 frame);
+u8 const * engine_rendering_capture_get_stream(struct Rendering_Capture const * capture, u32 frame, u32 index, size_t * length);
+
+bool engine_rendering_capture_is_complete(struct Rendering_Capture const * capture); // began on a VM without live resources
+
+// feeds the frame streams to `engine_rendering_vm_update` and ends the frame, without any pacing
+void engine_rendering_capture_replay(struct Rendering_Capture const * capture, u32 frame);
+
+// frees what the replayed frames left allocated and ends the frame, so the capture replays again
+void engine_rendering_capture_release(struct Rendering_Capture const * capture);
+
+#endif // ENGINE_RENDERING_CAPTURE
@@ -0,0 +1,63 @@
+#if !defined(ENGINE_RENDERING_GRAPH)
+#define ENGINE_RENDERING_GRAPH
+
+#include "engine/api/rendering_vm.h"
+
+// a per-frame graph of passes over render targets, compiled into a stream of rendering VM instructions
+// - a pass draws into one target and reads any number of them; its callback records the instructions
+// - a pass goes after every other writer of the targets it reads, writers of one target keep the order of `add_pass` calls
+// - passes writing no imported target and feeding no kept pass are culled, unless `keep` says otherwise
+// - transient targets live from their first pass to their last one; the ones of equal formats
+//   and disjoint lifetimes are placed into one VM target, which is resized in place when needed
+// - placed VM targets are kept across frames and freed after a few unused ones
+// - the contents of a transient target are undefined before its first pass draws into it
+
+#define RENDERING_GRAPH_NONE UINT32_MAX
+
+struct Rendering_Graph_Target {
+	svec2 size; u32 samples;
+	u32 count; struct Rendering_Graph_Attachment {
+		enum Texture_Type kind; enum Data_Type type; u8 channels;
+		bool sampled; // has a texture ref, see `get_texture`
+	} attachments[RVM_TARGET_ATTACHMENTS]; // colors, and at most one depth or stencil
+};
+
+struct Rendering_Graph_Stats {
+	u32 passes, passes_culled;
+	u32 targets, targets_placed; // transient ones of the frame, then the VM targets they took
+	u64 bytes, bytes_placed;     // the same, estimated
+	u32 targets_kept;            // VM targets alive across frames
+};
+
+struct Rendering_Graph;
+struct Rendering_Buffer;
+struct Ref_Pool;
+
+// the callback records into `buffer` with its target already in use
+typedef void Rendering_Graph_Pass(struct Rendering_Graph const * graph, struct Rendering_Buffer * buffer, void * context);
+
+// VM targets and their textures take refs from the given pools, shared with the rest of the stream
+struct Rendering_Graph * engine_rendering_graph_create(struct Ref_Pool * targets, struct Ref_Pool * textures);
+void engine_rendering_graph_destroy(struct Rendering_Graph * graph);
+void engine_rendering_graph_reset(struct Rendering_Graph * graph);
+
+// handles are valid until `reset` or `flush`
+u32 engine_rendering_graph_create_target(struct Rendering_Graph * graph, struct Rendering_Graph_Target const * desc);
+u32 engine_rendering_graph_import_target(struct Rendering_Graph * graph, struct Ref ref); // an empty ref is the window
+
+u32 engine_rendering_graph_add_pass(struct Rendering_Graph * graph, u32 target, Rendering_Graph_Pass * callback, void * context);
+void engine_rendering_graph_read(struct Rendering_Graph * graph, u32 pass, u32 target);
+void engine_rendering_graph_keep(struct Rendering_Graph * graph, u32 pass); // has side effects besides its target
+
+// the texture ref of a sampled attachment of a transient target, known during `flush` only; empty otherwise
+struct Ref engine_rendering_graph_get_texture(struct Rendering_Graph const * graph, u32 target, u32 attachment);
+
+// compiles the frame, emits it with the window in use at the end, then resets
+void engine_rendering_graph_flush(struct Rendering_Graph * graph, struct Rendering_Buffer * buffer);
+
+// emits the frees of all the kept VM targets, e.g. before destroying the graph
+void engine_rendering_graph_release(struct Rendering_Graph * graph, struct Rendering_Buffer * buffer);
+
+struct Rendering_Graph_Stats engine_rendering_graph_get_stats(struct Rendering_Graph const * graph); // of the last flush
+
+#endif // ENGINE_RENDERING_GRAPH
@@ -0,0 +1,37 @@
+#if !defined(ENGINE_RENDERING_OPTIMIZER)
+#define ENGINE_RENDERING_OPTIMIZER
+
+#include "engine/api/rendering_vm.h"
+
+// rewrites a stream of rendering VM instructions into an equivalent shorter one, ahead of `engine_rendering_vm_update`
+// - `*_Set_*`, `Shader_Use` and `Mesh_Use` are held until a draw or a clear consumes them:
+//   the ones overwritten meanwhile are dropped, and so are the ones repeating the state already in effect
+// - in a run of draws that re-sets invariant state, only the setting at the head of the run stays
+// - consecutive `Render_Clear`s are merged into one
+// - the state before the stream is unknown, the first setting of each kind is kept; the ones pending at its end are kept too
+// - instructions touching resources, pipelines or bundles end the tracking, nothing is moved across them
+// - works on any contiguous stream: the recorded instructions of a bundle, or a chunk of a per-frame buffer
+// - instructions are renumbered; for the recorded instructions of a bundle, `slots` keeps the `Bundle_Patch` targets
+
+struct Rendering_Optimizer_Report {
+	u64 instructions_in, instructions_out;
+	u64 bytes_in, bytes_out;
+	u32 removed[RVM_Instruction_Count]; // dropped or merged
+};
+
+// instruction indices, counted from the start of a single `run`
+// - `keep` lists input indices, ascending, that go through verbatim and in place; nothing is moved or merged across them
+// - `map`, if any, receives the output index of each input instruction, up to `map_capacity` of them;
+//   UINT32_MAX for a dropped one, a merged clear maps to the one it is merged into
+struct Rendering_Optimizer_Slots {
+	u32 const * keep; u32 keep_count;
+	u32 * map; u32 map_capacity;
+};
+
+// `output` holds at least `length` bytes and doesn't overlap `buffer`; returns the output length
+// - the report is accumulated, so it can span several streams
+// - a malformed tail is copied as is, for the VM to report
+// - `slots` may be NULL
+size_t engine_rendering_optimizer_run(u8 const * buffer, size_t length, u8 * output, struct Rendering_Optimizer_Report * report, struct Rendering_Optimizer_Slots * slots);
+
+#endif // ENGINE_RENDERING_OPTIMIZER
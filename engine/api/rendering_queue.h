@@ -0,0 +1,36 @@
+#if !defined(ENGINE_RENDERING_QUEUE)
+#define ENGINE_RENDERING_QUEUE
+
+#include "engine/api/rendering_vm.h"
+
+// an optional pass before the rendering VM: collects draws, sorts them by a 64 bit key, emits the stream
+// - layers go in ascending order, opaque draws before translucent ones within a layer
+// - opaque draws are grouped by shader, texture, mesh, then go front to back
+// - translucent draws go back to front, then are grouped by shader, texture, mesh
+// - the emitted stream carries only the state that differs from the previous draw
+// - consecutive draws of equal state go as one `Render_Draw_Indirect`, adjacent ranges merged
+
+struct Rendering_Queue_Draw {
+	u8 layer;
+	r32 depth; // normalized view distance, [0 .. 1]
+	//
+	struct Ref shader, texture, mesh; // the texture goes to unit 0
+	enum RVM_Color_Blend blend;       // anything but opaque is translucent
+	bool depth_read, depth_write;
+	enum RVM_Face_Cull cull;
+	//
+	struct RVM_Render_Draw draw;
+};
+
+struct Rendering_Buffer;
+struct Rendering_Queue;
+struct Rendering_Queue * engine_rendering_queue_create(void);
+void engine_rendering_queue_destroy(struct Rendering_Queue * queue);
+void engine_rendering_queue_reset(struct Rendering_Queue * queue);
+
+void engine_rendering_queue_push(struct Rendering_Queue * queue, struct Rendering_Queue_Draw const * draw);
+void engine_rendering_queue_flush(struct Rendering_Queue * queue, struct Rendering_Buffer * buffer);
+
+u64 engine_rendering_queue_get_key(struct Rendering_Queue_Draw const * draw);
+
+#endif // ENGINE_RENDERING_QUEUE
@@ -0,0 +1,42 @@
+#if !defined(ENGINE_RENDERING_SOFTWARE)
+#define ENGINE_RENDERING_SOFTWARE
+
+#include "engine/api/math_types.h"
+#include "engine/api/rendering_vm.h"
+
+// the CPU backend of the rendering VM, built with `ENGINE_RVM_SOFTWARE` defined
+// - renders into its own RGBA8 color, r32 depth and u8 stencil buffers, rows go bottom up
+// - triangles are binned into tiles, tiles are shaded in parallel by `threads` workers
+// - `Shader_Load` picks a native shader by `#pragma software(<name>)` in the shader source
+// - meshes are non-indexed triangle lists of r32 attributes; textures are sampled without mipmaps
+
+struct Settings_Software {
+	svec2 size;
+	u32 threads; // additional to the VM thread
+};
+
+extern struct Settings_Software hint_settings_software;
+
+u32 const * engine_rendering_software_get_color(svec2 * size); // flushes pending work
+
+//
+// native shaders
+//
+
+#define SOFTWARE_VARYINGS_MAX 16
+
+struct Software_Draw;
+
+// NULL unless the uniform was set for the shader
+void const * engine_rendering_software_get_uniform(struct Software_Draw const * draw, enum RVM_Uniform uniform);
+vec4 engine_rendering_software_sample(struct Software_Draw const * draw, u32 unit, vec2 uv);
+
+// `attributes[location]` points at the components of a vertex
+struct Software_Shader {
+	cstring name;
+	u32 varyings_count;
+	vec4 (* vertex)(struct Software_Draw const * draw, r32 const * const * attributes, r32 * varyings);
+	vec4 (* fragment)(struct Software_Draw const * draw, r32 const * varyings);
+};
+
+#endif // ENGINE_RENDERING_SOFTWARE
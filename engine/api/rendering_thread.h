@@ -0,0 +1,27 @@
+#if !defined(ENGINE_RENDERING_THREAD)
+#define ENGINE_RENDERING_THREAD
+
+#include "engine/api/primitive_types.h"
+
+// a dedicated thread that owns the rendering context and the rendering VM
+// - frames go through a ring of `ENGINE_RENDERING_THREAD_FRAMES` rendering buffers
+// - `begin_frame` blocks while `frames_in_flight` frames are still pending, bounding the latency
+// - the window context is created and destroyed on the thread; destroy the thread before the window
+// - asset `data` pointers of a frame are dereferenced on the thread, up to `frames_in_flight` frames after its `end_frame`;
+//   keep them alive until as many `begin_frame` calls return, or until `destroy`
+
+#define ENGINE_RENDERING_THREAD_FRAMES 3
+
+struct Engine_Window;
+struct Rendering_Buffer;
+struct Rendering_Thread;
+struct Rendering_Thread * engine_rendering_thread_create(struct Engine_Window * window, u32 frames_in_flight); // NULL if the thread can't be started
+void engine_rendering_thread_destroy(struct Rendering_Thread * thread); // completes the pending frames
+
+struct Rendering_Buffer * engine_rendering_thread_begin_frame(struct Rendering_Thread * thread);
+void engine_rendering_thread_end_frame(struct Rendering_Thread * thread);
+
+// starts or ends a capture with the frame being recorded
+void engine_rendering_thread_toggle_capture(struct Rendering_Thread * thread, cstring path);
+
+#endif // ENGINE_RENDERING_THREAD
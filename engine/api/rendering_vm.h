@@ -2,14 +2,58 @@
 #define ENGINE_RENDERING_VM
 
 #include "engine/api/primitive_types.h"
+#include "engine/api/math_types.h"
+#include "engine/api/asset_types.h"
+#include "engine/api/graphics_types.h"
+#include "engine/api/ref.h"
 
 void engine_rendering_vm_init(void);
 void engine_rendering_vm_deinit(void);
-void engine_rendering_vm_update(u8 const * buffer, size_t buffer_length);
+size_t engine_rendering_vm_update(u8 const * buffer, size_t buffer_length); // returns consumed bytes
+void engine_rendering_vm_end_frame(void); // after the last update of a frame, its streamed data and freed resources are fenced
+
+// driver calls made and dropped as redundant by the state cache, and instructions rejected as malformed
+// - `bytes_streamed` went through the per frame ring, `stalls` counts the waits for the GPU to release it
+struct RVM_Stats {
+	u64 calls_issued, calls_skipped;
+	u64 errors;
+	u64 bytes_streamed, stalls;
+};
+
+struct RVM_Stats engine_rendering_vm_get_stats(void);
+void engine_rendering_vm_reset_stats(void);
+
+u32 engine_rendering_vm_get_resources_count(void); // live shaders, meshes, textures and the like
 
 enum RVM_Instruction {
-	#define REGISTRY_RVM_INSTRUCTION(name) RVM_Instruction_ ## name,
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_Instruction_ ## name,
 	#include "engine/registry/rendering_vm_instruction.h"
+	RVM_Instruction_Count,
+};
+
+// where an instruction may go, per the registry
+enum RVM_Scope {
+	RVM_Scope_Stream, // streams only, they own the resources and the bundles
+	RVM_Scope_Bundle, // recorded into bundles too
+};
+
+// a stream is a sequence of instructions, each is a header followed by its payload
+// - payloads start and end at `RVM_ALIGNMENT`, so they are read in place
+// - `size` covers the payload with its padding; it may exceed `RVM_PAYLOAD_SIZE` for trailing data
+struct RVM_Header {
+	u32 instruction; // enum RVM_Instruction
+	u32 size;
+};
+
+#define RVM_ALIGNMENT 8
+#define RVM_ALIGN(size) (((size) + (RVM_ALIGNMENT - 1)) & ~(size_t)(RVM_ALIGNMENT - 1))
+#define RVM_PAYLOAD_SIZE(name) (u32)RVM_ALIGN(sizeof(struct RVM_ ## name))
+
+// shader uniforms are known by name ahead of time, and grouped into blocks
+enum RVM_Uniform {
+	#define REGISTRY_RVM_UNIFORM(name, block) RVM_Uniform_ ## name,
+	#include "engine/registry/rendering_vm_uniform.h"
+	RVM_Uniform_Count,
 };
 
 enum RVM_Comparison {
@@ -32,6 +76,7 @@ enum RVM_Color_Write {
 	RVM_Color_Write_G = (1 << 1),
 	RVM_Color_Write_B = (1 << 2),
 	RVM_Color_Write_A = (1 << 3),
+	RVM_Color_Write_All = RVM_Color_Write_R | RVM_Color_Write_G | RVM_Color_Write_B | RVM_Color_Write_A,
 };
 
 enum RVM_Color_Blend {
@@ -55,4 +100,132 @@ enum RVM_Face_Front {
 	RVM_Face_Front_CW,
 };
 
+enum RVM_Clear {
+	RVM_Clear_None = 0,
+	RVM_Clear_Color   = (1 << 0),
+	RVM_Clear_Depth   = (1 << 1),
+	RVM_Clear_Stencil = (1 << 2),
+	RVM_Clear_All = RVM_Clear_Color | RVM_Clear_Depth | RVM_Clear_Stencil,
+};
+
+// instruction payloads, `struct RVM_<name>` for each `RVM_Instruction_<name>`
+
+// Common
+struct RVM_Common_Set_Clip     { bool lower_left, zero_one; };
+struct RVM_Common_Set_Viewport { svec2 pos, size; };
+
+// Color
+struct RVM_Color_Set_Write { enum RVM_Color_Write value; };
+struct RVM_Color_Set_Clear { vec4 value; };
+struct RVM_Color_Set_Blend { enum RVM_Color_Blend value; };
+
+// Depth
+struct RVM_Depth_Set_Read       { bool value; };
+struct RVM_Depth_Set_Write      { bool value; };
+struct RVM_Depth_Set_Clear      { r32 value; };
+struct RVM_Depth_Set_Comparison { enum RVM_Comparison value; };
+struct RVM_Depth_Set_Range      { vec2 value; };
+
+// Stencil
+struct RVM_Stencil_Set_Read       { bool value; };
+struct RVM_Stencil_Set_Write      { u8 value; };
+struct RVM_Stencil_Set_Clear      { u8 value; };
+struct RVM_Stencil_Set_Comparison { enum RVM_Comparison comparison; u8 reference, mask; };
+struct RVM_Stencil_Set_Operation  {
+	enum RVM_Operation stencil_fail__depth_any;
+	enum RVM_Operation stencil_success__depth_fail;
+	enum RVM_Operation stencil_success__depth_success;
+};
+
+// Face
+struct RVM_Face_Set_Cull  { enum RVM_Face_Cull value; };
+struct RVM_Face_Set_Front { enum RVM_Face_Front value; };
+
+// Shader
+struct RVM_Shader_Allocate { struct Ref ref; };
+struct RVM_Shader_Free     { struct Ref ref; };
+struct RVM_Shader_Load     { struct Ref ref; struct Asset_Shader asset; };
+struct RVM_Shader_Use      { struct Ref ref; };
+struct RVM_Shader_Uniform  { struct Ref ref; enum RVM_Uniform uniform; enum Data_Type type; u32 count; }; // values follow the payload
+
+// Mesh
+struct RVM_Mesh_Allocate { struct Ref ref; struct Asset_Mesh asset; };
+struct RVM_Mesh_Free     { struct Ref ref; };
+struct RVM_Mesh_Load     { struct Ref ref; struct Asset_Mesh asset; };
+struct RVM_Mesh_Use      { struct Ref ref; };
+
+// Texture, allocated with its data loaded
+// - a load may reach the GPU over the next few frames, the rows not in yet sample undefined
+struct RVM_Texture_Allocate { struct Ref ref; struct Asset_Texture asset; };
+struct RVM_Texture_Free     { struct Ref ref; };
+struct RVM_Texture_Load     { struct Ref ref; struct Asset_Texture asset; };
+
+// Sampler, filtering and wrapping a unit samples with in place of its texture's own settings
+// - equal settings are shared, with the ones of the textures too; a GL sampler object each
+// - `anisotropy` above 1 is the maximum anisotropic filtering, clamped to the context's limit
+struct RVM_Sampler {
+	enum Filter_Type filter_mipmap, filter_min, filter_max;
+	enum Wrap_Type wrap_x, wrap_y;
+	u32 anisotropy;
+};
+struct RVM_Sampler_Allocate { struct Ref ref; struct RVM_Sampler value; };
+struct RVM_Sampler_Free     { struct Ref ref; };
+struct RVM_Sampler_Use      { u32 unit; struct Ref ref; }; // stays across `Unit_Allocate`s; an empty ref goes back to the texture's settings
+
+// Unit
+struct RVM_Unit_Allocate { u32 unit; struct Ref texture; };
+struct RVM_Unit_Free     { u32 unit; };
+
+// Render
+struct RVM_Render_Clear { enum RVM_Clear mask; };
+struct RVM_Render_Draw  { u32 offset, length; };
+struct RVM_Render_Draw_Instanced { u32 offset, length; struct Ref instances; u32 instances_offset, count; }; // `instances` is a mesh with a divisor
+struct RVM_Render_Draw_Indirect  { struct Ref instances; u32 count; }; // `RVM_Draw_Arguments` follow the payload, `instances` is optional
+
+// Pipeline, the state of the `*_Set_*` instructions that goes with a shader, baked once
+// - equal ones are shared, `Pipeline_Use` applies only what differs from the current state
+struct RVM_Pipeline {
+	struct RVM_Shader_Use shader;
+	struct RVM_Color_Set_Write color_write;
+	struct RVM_Color_Set_Blend blend;
+	struct RVM_Depth_Set_Read depth_read;
+	struct RVM_Depth_Set_Write depth_write;
+	struct RVM_Depth_Set_Comparison depth_comparison;
+	struct RVM_Stencil_Set_Read stencil_read;
+	struct RVM_Stencil_Set_Write stencil_write;
+	struct RVM_Stencil_Set_Comparison stencil_comparison;
+	struct RVM_Stencil_Set_Operation stencil_operation;
+	struct RVM_Face_Set_Cull cull;
+	struct RVM_Face_Set_Front front;
+};
+struct RVM_Pipeline_Allocate { struct Ref ref; struct RVM_Pipeline value; };
+struct RVM_Pipeline_Free     { struct Ref ref; };
+struct RVM_Pipeline_Use      { struct Ref ref; };
+
+// Bundle, instructions recorded once and replayed by `Bundle_Call`, validated and decoded on allocation
+// - only state, bindings and draws are recorded; resources are allocated, loaded and freed by the stream
+// - a slot is the index of a recorded instruction; `Bundle_Patch` replaces it with one of the same kind and size
+struct RVM_Bundle_Allocate { struct Ref ref; }; // the recorded instructions follow the payload
+struct RVM_Bundle_Free     { struct Ref ref; };
+struct RVM_Bundle_Call     { struct Ref ref; };
+struct RVM_Bundle_Patch    { struct Ref ref; u32 slot; }; // the replacing instruction follows the payload
+
+// Target, attachments drawn into in place of the window once used; an empty ref uses the window again
+// - an attachment with a texture ref is sampled through it, the ref is claimed and freed along with the target
+// - a transient target is taken from a pool of equal size, formats and samples, and goes back to it when freed
+// - a multisampled target is resolved into its textures when another one is used, or when the frame ends with it in use
+#define RVM_TARGET_ATTACHMENTS 4
+struct RVM_Target_Attachment { struct Ref texture; enum Texture_Type kind; enum Data_Type type; u8 channels; };
+struct RVM_Target_Allocate {
+	struct Ref ref; svec2 size; u32 samples; bool transient;
+	u32 count; struct RVM_Target_Attachment attachments[RVM_TARGET_ATTACHMENTS]; // colors, and at most one depth or stencil
+};
+struct RVM_Target_Free  { struct Ref ref; };
+struct RVM_Target_Load  { struct Ref ref; svec2 size; }; // the contents are lost
+struct RVM_Target_Use   { struct Ref ref; };
+struct RVM_Target_Clear { u32 attachment; vec4 color; r32 depth; u8 stencil; }; // of the current target, masked as `Render_Clear`
+
+// a draw of the current mesh, laid out as GL's `DrawArraysIndirectCommand`, so it is uploaded as is
+struct RVM_Draw_Arguments { u32 length, count, offset, instances_offset; };
+
 #endif // ENGINE_RENDERING_VM
@@ -0,0 +1,1103 @@
+#include "engine/api/code.h"
+#include "engine/api/ref_pool.h"
+#include "engine/api/math_types.h"
+#include "engine/api/asset_types.h"
+#include "engine/api/graphics_types.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_capture.h"
+
+// decodes and validates the stream, tracks the state and the resources, but renders nothing
+// - build with `ENGINE_RVM_NULL` defined, to measure the VM layer itself or to run without a GPU
+// - `calls_issued` and `calls_skipped` count the RVM state that changed or repeated, not driver binds;
+//   there are no uniform blocks or bind points to shadow, so the skipped share isn't comparable to the GL backend's
+
+#define VM_TEXTURE_UNITS 16
+
+#define REGISTRY_RVM_INSTRUCTION(name, scope) static void impl_ ## name(struct RVM_ ## name const * payload);
+#include "engine/registry/rendering_vm_instruction.h"
+
+typedef void RVM_Handler(void const * payload);
+
+// payloads are aligned, so the handlers read them in place
+#define REGISTRY_RVM_INSTRUCTION(name, scope) static void impl_dispatch_ ## name(void const * payload) { impl_ ## name(payload); }
+#include "engine/registry/rendering_vm_instruction.h"
+
+static RVM_Handler * const impl_handlers[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) impl_dispatch_ ## name,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static u32 const impl_payload_sizes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_PAYLOAD_SIZE(name),
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static enum RVM_Scope const impl_scopes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_Scope_ ## scope,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+// RVM values as they are
+struct VM_State {
+	bool lower_left, zero_one;
+	svec2 viewport_pos, viewport_size;
+	//
+	enum RVM_Color_Write color_write;
+	vec4 color_clear;
+	enum RVM_Color_Blend blend;
+	//
+	bool depth_test, depth_write;
+	r32 depth_clear;
+	enum RVM_Comparison depth_comparison;
+	vec2 depth_range;
+	//
+	bool stencil_test;
+	u8 stencil_write, stencil_clear;
+	enum RVM_Comparison stencil_comparison; u8 stencil_reference, stencil_mask;
+	enum RVM_Operation stencil_fail, stencil_depth_fail, stencil_depth_pass;
+	//
+	enum RVM_Face_Cull cull_mode;
+	enum RVM_Face_Front front_face;
+	//
+	struct VM_Shader const * shader; struct VM_Mesh const * mesh; // resources never move, until freed
+	struct VM_Texture const * textures[VM_TEXTURE_UNITS];
+	struct VM_Sampler const * samplers[VM_TEXTURE_UNITS]; // NULL for the settings of the texture
+	struct VM_Target const * target; // NULL for the window
+};
+
+static void impl_reset_state(struct VM_State * state);
+static void impl_resources_init(void);
+static void impl_resources_free(void);
+
+//
+// API
+//
+
+struct Rendering_VM {
+	struct Ref_Pool * shaders;  // of `VM_Shader`
+	struct Ref_Pool * meshes;   // of `VM_Mesh`
+	struct Ref_Pool * textures; // of `VM_Texture`
+	struct Ref_Pool * pipelines; // of `VM_Pipeline`
+	struct Ref_Pool * bundles;   // of `VM_Bundle`
+	struct Ref_Pool * targets;   // of `VM_Target`
+	struct Ref_Pool * samplers;  // of `VM_Sampler`
+	//
+	struct VM_State state;
+	struct RVM_Stats stats;
+	u32 payload_size; // of the current instruction, with its trailing data
+	u32 frame;
+};
+static struct Rendering_VM * rvm;
+
+void engine_rendering_vm_init(void) {
+	struct Rendering_VM * rendering_vm = ENGINE_MALLOC(sizeof(*rvm));
+	memset(rendering_vm, 0, sizeof(*rendering_vm));
+
+	impl_reset_state(&rendering_vm->state);
+
+	rvm = rendering_vm;
+
+	impl_resources_init();
+}
+
+void engine_rendering_vm_deinit(void) {
+	impl_resources_free();
+	engine_ref_pool_destroy(rvm->shaders);
+	engine_ref_pool_destroy(rvm->meshes);
+	engine_ref_pool_destroy(rvm->textures);
+	engine_ref_pool_destroy(rvm->pipelines);
+	engine_ref_pool_destroy(rvm->bundles);
+	engine_ref_pool_destroy(rvm->targets);
+	engine_ref_pool_destroy(rvm->samplers);
+	ENGINE_FREE(rvm);
+}
+
+struct RVM_Stats engine_rendering_vm_get_stats(void) {
+	return rvm->stats;
+}
+
+void engine_rendering_vm_reset_stats(void) {
+	rvm->stats = (struct RVM_Stats){0};
+}
+
+u32 engine_rendering_vm_get_resources_count(void) {
+	return engine_ref_pool_get_count(rvm->shaders)
+	     + engine_ref_pool_get_count(rvm->meshes)
+	     + engine_ref_pool_get_count(rvm->textures)
+	     + engine_ref_pool_get_count(rvm->pipelines)
+	     + engine_ref_pool_get_count(rvm->bundles)
+	     + engine_ref_pool_get_count(rvm->targets)
+	     + engine_ref_pool_get_count(rvm->samplers);
+}
+
+void engine_rendering_vm_end_frame(void) {
+	// nothing is streamed, there is no GPU to wait for; transient meshes go stale as with the GL backend
+	rvm->frame++;
+}
+
+size_t engine_rendering_vm_update(u8 const * buffer, size_t buffer_length) {
+	u8 const * const buffer_start = buffer;
+	u8 const * const buffer_end = buffer + buffer_length;
+	while ((size_t)(buffer_end - buffer) >= sizeof(struct RVM_Header)) {
+		struct RVM_Header const * header = (void const *)buffer;
+		u8 const * payload = buffer + sizeof(*header);
+
+		if (header->instruction >= RVM_Instruction_Count) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size < impl_payload_sizes[header->instruction]) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size > (size_t)(buffer_end - payload)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size % RVM_ALIGNMENT) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+
+		rvm->payload_size = header->size;
+		impl_handlers[header->instruction](payload);
+		buffer = payload + header->size;
+	}
+
+	size_t const consumed = (size_t)(buffer - buffer_start);
+	engine_rendering_capture_record(buffer_start, consumed);
+	return consumed;
+}
+
+//
+// internal implementation
+//
+
+struct VM_Shader {
+	bool loaded;
+	u32 uniforms_set; // a bit per `RVM_Uniform`
+};
+
+struct VM_Mesh {
+	u32 vertices_count; // UINT32_MAX without an attributes list
+	u32 divisor;
+	bool transient; u32 frame; // a transient one is valid in the `frame` it is loaded only
+};
+
+struct VM_Texture {
+	svec2 size;
+	bool attachment; // of a target, freed along with it
+};
+
+struct VM_Pipeline {
+	struct RVM_Pipeline value;
+};
+
+// what the GL backend resets to on an empty pipeline ref
+static struct RVM_Pipeline const impl_pipeline_defaults = {
+	.shader = {.ref = {.id = REF_EMPTY_ID}},
+	.color_write = {.value = RVM_Color_Write_All},
+	.blend = {.value = RVM_Color_Blend_Opaque},
+	.depth_write = {.value = true},
+	.depth_comparison = {.value = RVM_Comparison_Less},
+	.stencil_write = {.value = 0xff},
+	.stencil_comparison = {.comparison = RVM_Comparison_True, .reference = 0, .mask = 0xff},
+	.cull = {.value = RVM_Face_Cull_None},
+	.front = {.value = RVM_Face_Front_CCW},
+};
+
+// a recorded instruction, `offset` is of its payload
+struct VM_Bundle_Op {
+	u32 instruction;
+	u32 offset, size;
+};
+
+// decoded operations, followed by the recorded data in the same allocation
+struct VM_Bundle {
+	struct VM_Bundle_Op * ops; u32 count;
+	u8 * data;
+};
+
+struct VM_Target {
+	svec2 size; u32 count;
+	enum Texture_Type kinds[RVM_TARGET_ATTACHMENTS];
+	struct Ref textures[RVM_TARGET_ATTACHMENTS]; // of the sampled attachments
+};
+
+struct VM_Sampler {
+	struct RVM_Sampler value;
+};
+
+static void impl_reset_state(struct VM_State * state) {
+	// the defaults of a fresh context
+	*state = (struct VM_State){
+		.lower_left = true, .zero_one = false,
+		//
+		.color_write = RVM_Color_Write_All,
+		.blend = RVM_Color_Blend_Opaque,
+		//
+		.depth_write = true,
+		.depth_clear = 1,
+		.depth_comparison = RVM_Comparison_Less,
+		.depth_range = VEC2(0, 1),
+		//
+		.stencil_write = 0xff,
+		.stencil_comparison = RVM_Comparison_True, .stencil_mask = 0xff,
+		.stencil_fail = RVM_Operation_Keep, .stencil_depth_fail = RVM_Operation_Keep, .stencil_depth_pass = RVM_Operation_Keep,
+		//
+		.cull_mode = RVM_Face_Cull_Back, .front_face = RVM_Face_Front_CCW,
+		//
+	};
+}
+
+static bool impl_state_changed(bool changed) {
+	if (changed) { rvm->stats.calls_issued++; }
+	else { rvm->stats.calls_skipped++; }
+	return changed;
+}
+
+// validation
+static bool impl_valid(bool value) {
+	if (!value) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); }
+	return value;
+}
+
+static bool impl_valid_bool(bool const * value) {
+	u8 raw; memcpy(&raw, value, sizeof(raw));
+	return impl_valid(raw <= 1);
+}
+
+static bool impl_valid_comparison(enum RVM_Comparison value) {
+	return impl_valid((u32)value <= RVM_Comparison_GEqual);
+}
+
+static bool impl_valid_operation(enum RVM_Operation value) {
+	return impl_valid((u32)value <= RVM_Operation_Decr_Wrap);
+}
+
+static bool impl_valid_data_type(enum Data_Type value) {
+	return impl_valid((u32)value <= Data_Type_unit_id);
+}
+
+static bool impl_valid_filter(enum Filter_Type value) {
+	return impl_valid((u32)value <= Filter_Type_Linear);
+}
+
+static bool impl_valid_wrap(enum Wrap_Type value) {
+	return impl_valid((u32)value <= Wrap_Type_MRepeat);
+}
+
+static u32 impl_data_type_size(enum Data_Type value) {
+	switch (value) {
+		case Data_Type_s8:  return sizeof(s8);
+		case Data_Type_s16: return sizeof(s16);
+		case Data_Type_s32: return sizeof(s32);
+		//
+		case Data_Type_u8:  return sizeof(u8);
+		case Data_Type_u16: return sizeof(u16);
+		case Data_Type_u32: return sizeof(u32);
+		//
+		case Data_Type_r32: return sizeof(r32);
+		case Data_Type_r64: return sizeof(r64);
+		//
+		case Data_Type_vec2: return sizeof(vec2);
+		case Data_Type_vec3: return sizeof(vec3);
+		case Data_Type_vec4: return sizeof(vec4);
+		//
+		case Data_Type_svec2: return sizeof(svec2);
+		case Data_Type_svec3: return sizeof(svec3);
+		case Data_Type_svec4: return sizeof(svec4);
+		//
+		case Data_Type_uvec2: return sizeof(uvec2);
+		case Data_Type_uvec3: return sizeof(uvec3);
+		case Data_Type_uvec4: return sizeof(uvec4);
+		//
+		case Data_Type_mat2: return sizeof(r32) * 2 * 2;
+		case Data_Type_mat3: return sizeof(r32) * 3 * 3;
+		case Data_Type_mat4: return sizeof(mat4);
+		//
+		case Data_Type_unit_id: return sizeof(s32);
+	}
+	return 0;
+}
+
+// bytes per texel of the data, 0 for a combination the GL backend has no format for
+static u32 impl_texel_size(enum Texture_Type kind, enum Data_Type type, u8 channels) {
+	switch (kind) {
+		case Texture_Type_Color: switch (type) {
+			case Data_Type_u8: case Data_Type_u16: case Data_Type_u32: case Data_Type_r32:
+				return channels * impl_data_type_size(type);
+			default: return 0;
+		}
+
+		case Texture_Type_Depth: switch (type) {
+			case Data_Type_u16: case Data_Type_u32: case Data_Type_r32:
+				return impl_data_type_size(type);
+			default: return 0;
+		}
+
+		// packed as 24 bits of depth and 8 of stencil, or as a float and 8 bits in 64
+		case Texture_Type_DStencil: switch (type) {
+			case Data_Type_u32: return 4;
+			case Data_Type_r32: return 8;
+			default: return 0;
+		}
+
+		case Texture_Type_Stencil: return (type == Data_Type_u8) ? 1 : 0;
+	}
+	return 0;
+}
+
+static bool impl_valid_texture_asset(struct Asset_Texture const * asset) {
+	if (!(impl_valid_data_type(asset->type)
+		&& impl_valid(asset->channels >= 1 && asset->channels <= 4)
+		&& impl_valid((u32)asset->kind <= Texture_Type_DStencil)
+		&& impl_valid_filter(asset->filter_mipmap)
+		&& impl_valid_filter(asset->filter_min)
+		&& impl_valid_filter(asset->filter_max)
+		&& impl_valid_wrap(asset->wrap_x)
+		&& impl_valid_wrap(asset->wrap_y)
+		&& impl_valid(asset->size.x > 0 && asset->size.y > 0)
+	)) { return false; }
+
+	// the data covers the whole size, as the GL backend requires
+	u32 const texel_size = impl_texel_size(asset->kind, asset->type, asset->channels);
+	if (!impl_valid(texel_size != 0)) { return false; }
+	return impl_valid(!asset->data || asset->length / texel_size / (size_t)asset->size.x >= (size_t)asset->size.y);
+}
+
+static bool impl_valid_sampler(struct RVM_Sampler const * value) {
+	return impl_valid_filter(value->filter_mipmap)
+		&& impl_valid_filter(value->filter_min)
+		&& impl_valid_filter(value->filter_max)
+		&& impl_valid_wrap(value->wrap_x)
+		&& impl_valid_wrap(value->wrap_y);
+}
+
+// colors, and at most one depth or stencil
+static bool impl_valid_target(struct RVM_Target_Allocate const * payload) {
+	if (!impl_valid(payload->size.x > 0 && payload->size.y > 0)) { return false; }
+	if (!impl_valid(payload->count >= 1 && payload->count <= RVM_TARGET_ATTACHMENTS)) { return false; }
+	if (!impl_valid_bool(&payload->transient)) { return false; }
+
+	u32 depth_stencil_count = 0;
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Target_Attachment const * attachment = payload->attachments + i;
+		if (!impl_valid((u32)attachment->kind <= Texture_Type_DStencil)) { return false; }
+		if (!impl_valid_data_type(attachment->type)) { return false; }
+		if (attachment->kind == Texture_Type_Color) {
+			if (!impl_valid(attachment->channels >= 1 && attachment->channels <= 4)) { return false; }
+		}
+		else { depth_stencil_count++; }
+	}
+	return impl_valid(depth_stencil_count <= 1);
+}
+
+static bool impl_valid_pipeline(struct RVM_Pipeline const * value) {
+	return impl_valid(((u32)value->color_write.value & ~(u32)RVM_Color_Write_All) == 0)
+		&& impl_valid((u32)value->blend.value <= RVM_Color_Blend_PMAdditive)
+		&& impl_valid_bool(&value->depth_read.value)
+		&& impl_valid_bool(&value->depth_write.value)
+		&& impl_valid_comparison(value->depth_comparison.value)
+		&& impl_valid_bool(&value->stencil_read.value)
+		&& impl_valid_comparison(value->stencil_comparison.comparison)
+		&& impl_valid_operation(value->stencil_operation.stencil_fail__depth_any)
+		&& impl_valid_operation(value->stencil_operation.stencil_success__depth_fail)
+		&& impl_valid_operation(value->stencil_operation.stencil_success__depth_success)
+		&& impl_valid((u32)value->cull.value <= RVM_Face_Cull_Both)
+		&& impl_valid((u32)value->front.value <= RVM_Face_Front_CW);
+}
+
+static bool impl_valid_mesh_asset(struct Asset_Mesh const * asset) {
+	return impl_valid_data_type(asset->type)
+		&& impl_valid((u32)asset->frequency <= Mesh_Frequency_Stream)
+		&& impl_valid((u32)asset->access <= Mesh_Access_Copy)
+		&& impl_valid(asset->location < ASSET_MESH_ATTRIBUTES)
+		&& impl_valid_bool(&asset->transient);
+}
+
+static bool impl_mesh_is_fresh(struct VM_Mesh const * mesh) {
+	return !mesh->transient || mesh->frame == rvm->frame;
+}
+
+static u32 impl_mesh_vertices_count(struct Asset_Mesh const * asset) {
+	u32 stride = 0;
+	for (u32 i = 0; i < ASSET_MESH_ATTRIBUTES && asset->attributes[i]; ++i) {
+		stride += asset->attributes[i];
+	}
+	stride *= impl_data_type_size(asset->type);
+	return stride ? (u32)(asset->length / stride) : UINT32_MAX;
+}
+
+static void impl_resources_init(void) {
+	rvm->shaders  = engine_ref_pool_create(sizeof(struct VM_Shader));
+	rvm->meshes   = engine_ref_pool_create(sizeof(struct VM_Mesh));
+	rvm->textures = engine_ref_pool_create(sizeof(struct VM_Texture));
+	rvm->pipelines = engine_ref_pool_create(sizeof(struct VM_Pipeline));
+	rvm->bundles   = engine_ref_pool_create(sizeof(struct VM_Bundle));
+	rvm->targets   = engine_ref_pool_create(sizeof(struct VM_Target));
+	rvm->samplers  = engine_ref_pool_create(sizeof(struct VM_Sampler));
+}
+
+static void impl_resources_free(void) {
+	u32 const bundles_count = engine_ref_pool_get_count(rvm->bundles);
+	for (u32 i = 0; i < bundles_count; ++i) {
+		struct VM_Bundle const * bundle = engine_ref_pool_get(rvm->bundles, engine_ref_pool_get_ref(rvm->bundles, i));
+		ENGINE_FREE(bundle->ops);
+	}
+}
+
+// a live resource of a matching generation, or NULL
+static struct VM_Shader * impl_find_shader(struct Ref ref) {
+	struct VM_Shader * shader = engine_ref_pool_get(rvm->shaders, ref);
+	if (!impl_valid(shader != NULL)) { return NULL; }
+	return shader;
+}
+
+static struct VM_Mesh * impl_find_mesh(struct Ref ref) {
+	struct VM_Mesh * mesh = engine_ref_pool_get(rvm->meshes, ref);
+	if (!impl_valid(mesh != NULL)) { return NULL; }
+	return mesh;
+}
+
+static struct VM_Texture * impl_find_texture(struct Ref ref) {
+	struct VM_Texture * texture = engine_ref_pool_get(rvm->textures, ref);
+	if (!impl_valid(texture != NULL)) { return NULL; }
+	return texture;
+}
+
+static struct VM_Pipeline * impl_find_pipeline(struct Ref ref) {
+	struct VM_Pipeline * pipeline = engine_ref_pool_get(rvm->pipelines, ref);
+	if (!impl_valid(pipeline != NULL)) { return NULL; }
+	return pipeline;
+}
+
+static struct VM_Bundle * impl_find_bundle(struct Ref ref) {
+	struct VM_Bundle * bundle = engine_ref_pool_get(rvm->bundles, ref);
+	if (!impl_valid(bundle != NULL)) { return NULL; }
+	return bundle;
+}
+
+static struct VM_Target * impl_find_target(struct Ref ref) {
+	struct VM_Target * target = engine_ref_pool_get(rvm->targets, ref);
+	if (!impl_valid(target != NULL)) { return NULL; }
+	return target;
+}
+
+static struct VM_Sampler * impl_find_sampler(struct Ref ref) {
+	struct VM_Sampler * sampler = engine_ref_pool_get(rvm->samplers, ref);
+	if (!impl_valid(sampler != NULL)) { return NULL; }
+	return sampler;
+}
+
+// counts the recorded instructions, filling `ops` if any; UINT32_MAX for a malformed record
+static u32 impl_bundle_decode(u8 const * data, u32 length, struct VM_Bundle_Op * ops) {
+	u32 count = 0;
+	for (u32 offset = 0; offset < length; count++) {
+		if (length - offset < sizeof(struct RVM_Header)) { return UINT32_MAX; }
+		struct RVM_Header const * header = (void const *)(data + offset);
+		offset += sizeof(*header);
+
+		if (header->instruction >= RVM_Instruction_Count || impl_scopes[header->instruction] != RVM_Scope_Bundle) { return UINT32_MAX; }
+		if (header->size < impl_payload_sizes[header->instruction]) { return UINT32_MAX; }
+		if (header->size > length - offset) { return UINT32_MAX; }
+		if (header->size % RVM_ALIGNMENT) { return UINT32_MAX; }
+
+		if (ops) { ops[count] = (struct VM_Bundle_Op){.instruction = header->instruction, .offset = offset, .size = header->size}; }
+		offset += header->size;
+	}
+	return count;
+}
+
+// Common
+static void impl_Common_Set_Clip(struct RVM_Common_Set_Clip const * payload) {
+	if (!impl_valid_bool(&payload->lower_left) || !impl_valid_bool(&payload->zero_one)) { return; }
+	if (!impl_state_changed(rvm->state.lower_left != payload->lower_left || rvm->state.zero_one != payload->zero_one)) { return; }
+	rvm->state.lower_left = payload->lower_left;
+	rvm->state.zero_one = payload->zero_one;
+}
+
+static void impl_Common_Set_Viewport(struct RVM_Common_Set_Viewport const * payload) {
+	svec2 const pos = payload->pos, size = payload->size;
+	if (!impl_valid(size.x >= 0 && size.y >= 0)) { return; }
+	if (!impl_state_changed(
+		rvm->state.viewport_pos.x  != pos.x  || rvm->state.viewport_pos.y  != pos.y ||
+		rvm->state.viewport_size.x != size.x || rvm->state.viewport_size.y != size.y
+	)) { return; }
+	rvm->state.viewport_pos = pos; rvm->state.viewport_size = size;
+}
+
+// Color
+static void impl_Color_Set_Write(struct RVM_Color_Set_Write const * payload) {
+	if (!impl_valid(((u32)payload->value & ~(u32)RVM_Color_Write_All) == 0)) { return; }
+	if (!impl_state_changed(rvm->state.color_write != payload->value)) { return; }
+	rvm->state.color_write = payload->value;
+}
+
+static void impl_Color_Set_Clear(struct RVM_Color_Set_Clear const * payload) {
+	// floats are compared bitwise, as the GL backend does
+	vec4 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.color_clear, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.color_clear = value;
+}
+
+static void impl_Color_Set_Blend(struct RVM_Color_Set_Blend const * payload) {
+	if (!impl_valid((u32)payload->value <= RVM_Color_Blend_PMAdditive)) { return; }
+	if (!impl_state_changed(rvm->state.blend != payload->value)) { return; }
+	rvm->state.blend = payload->value;
+}
+
+// Depth
+static void impl_Depth_Set_Read(struct RVM_Depth_Set_Read const * payload) {
+	if (!impl_valid_bool(&payload->value)) { return; }
+	if (!impl_state_changed(rvm->state.depth_test != payload->value)) { return; }
+	rvm->state.depth_test = payload->value;
+}
+
+static void impl_Depth_Set_Write(struct RVM_Depth_Set_Write const * payload) {
+	if (!impl_valid_bool(&payload->value)) { return; }
+	if (!impl_state_changed(rvm->state.depth_write != payload->value)) { return; }
+	rvm->state.depth_write = payload->value;
+}
+
+static void impl_Depth_Set_Clear(struct RVM_Depth_Set_Clear const * payload) {
+	if (!impl_state_changed(memcmp(&rvm->state.depth_clear, &payload->value, sizeof(payload->value)) != 0)) { return; }
+	rvm->state.depth_clear = payload->value;
+}
+
+static void impl_Depth_Set_Comparison(struct RVM_Depth_Set_Comparison const * payload) {
+	if (!impl_valid_comparison(payload->value)) { return; }
+	if (!impl_state_changed(rvm->state.depth_comparison != payload->value)) { return; }
+	rvm->state.depth_comparison = payload->value;
+}
+
+static void impl_Depth_Set_Range(struct RVM_Depth_Set_Range const * payload) {
+	vec2 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.depth_range, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.depth_range = value;
+}
+
+// Stencil
+static void impl_Stencil_Set_Read(struct RVM_Stencil_Set_Read const * payload) {
+	if (!impl_valid_bool(&payload->value)) { return; }
+	if (!impl_state_changed(rvm->state.stencil_test != payload->value)) { return; }
+	rvm->state.stencil_test = payload->value;
+}
+
+static void impl_Stencil_Set_Write(struct RVM_Stencil_Set_Write const * payload) {
+	if (!impl_state_changed(rvm->state.stencil_write != payload->value)) { return; }
+	rvm->state.stencil_write = payload->value;
+}
+
+static void impl_Stencil_Set_Clear(struct RVM_Stencil_Set_Clear const * payload) {
+	if (!impl_state_changed(rvm->state.stencil_clear != payload->value)) { return; }
+	rvm->state.stencil_clear = payload->value;
+}
+
+static void impl_Stencil_Set_Comparison(struct RVM_Stencil_Set_Comparison const * payload) {
+	if (!impl_valid_comparison(payload->comparison)) { return; }
+	if (!impl_state_changed(
+		rvm->state.stencil_comparison != payload->comparison ||
+		rvm->state.stencil_reference != payload->reference ||
+		rvm->state.stencil_mask != payload->mask
+	)) { return; }
+	rvm->state.stencil_comparison = payload->comparison;
+	rvm->state.stencil_reference = payload->reference;
+	rvm->state.stencil_mask = payload->mask;
+}
+
+static void impl_Stencil_Set_Operation(struct RVM_Stencil_Set_Operation const * payload) {
+	if (!impl_valid_operation(payload->stencil_fail__depth_any)) { return; }
+	if (!impl_valid_operation(payload->stencil_success__depth_fail)) { return; }
+	if (!impl_valid_operation(payload->stencil_success__depth_success)) { return; }
+	if (!impl_state_changed(
+		rvm->state.stencil_fail != payload->stencil_fail__depth_any ||
+		rvm->state.stencil_depth_fail != payload->stencil_success__depth_fail ||
+		rvm->state.stencil_depth_pass != payload->stencil_success__depth_success
+	)) { return; }
+	rvm->state.stencil_fail = payload->stencil_fail__depth_any;
+	rvm->state.stencil_depth_fail = payload->stencil_success__depth_fail;
+	rvm->state.stencil_depth_pass = payload->stencil_success__depth_success;
+}
+
+// Vertex
+static void impl_Face_Set_Cull(struct RVM_Face_Set_Cull const * payload) {
+	if (!impl_valid((u32)payload->value <= RVM_Face_Cull_Both)) { return; }
+	if (!impl_state_changed(rvm->state.cull_mode != payload->value)) { return; }
+	rvm->state.cull_mode = payload->value;
+}
+
+static void impl_Face_Set_Front(struct RVM_Face_Set_Front const * payload) {
+	if (!impl_valid((u32)payload->value <= RVM_Face_Front_CW)) { return; }
+	if (!impl_state_changed(rvm->state.front_face != payload->value)) { return; }
+	rvm->state.front_face = payload->value;
+}
+
+// Shader
+static void impl_Shader_Allocate(struct RVM_Shader_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+
+	// a live slot or an id out of range is refused; any generation fits a free slot
+	if (!impl_valid(engine_ref_pool_claim(rvm->shaders, ref) != NULL)) { return; }
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Shader_Free(struct RVM_Shader_Free const * payload) {
+	struct VM_Shader * shader = impl_find_shader(payload->ref);
+	if (!shader) { return; }
+
+	if (rvm->state.shader == shader) { rvm->state.shader = NULL; }
+	engine_ref_pool_release(rvm->shaders, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Shader_Load(struct RVM_Shader_Load const * payload) {
+	struct VM_Shader * shader = impl_find_shader(payload->ref);
+	if (!shader) { return; }
+	if (!impl_valid(payload->asset.data && payload->asset.length)) { return; }
+
+	shader->loaded = true;
+	shader->uniforms_set = 0;
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Shader_Use(struct RVM_Shader_Use const * payload) {
+	struct VM_Shader const * shader = NULL;
+	if (payload->ref.id != REF_EMPTY_ID) {
+		shader = impl_find_shader(payload->ref);
+		if (!shader) { return; }
+	}
+
+	if (!impl_state_changed(rvm->state.shader != shader)) { return; }
+	rvm->state.shader = shader;
+}
+
+static void impl_Shader_Uniform(struct RVM_Shader_Uniform const * payload) {
+	struct VM_Shader * shader = impl_find_shader(payload->ref);
+	if (!shader) { return; }
+	if (!impl_valid((u32)payload->uniform < RVM_Uniform_Count)) { return; }
+	if (!impl_valid_data_type(payload->type)) { return; }
+
+	// values follow the payload
+	u64 const size = (u64)impl_data_type_size(payload->type) * payload->count;
+	if (!impl_valid(size <= rvm->payload_size - impl_payload_sizes[RVM_Instruction_Shader_Uniform])) { return; }
+
+	shader->uniforms_set |= 1u << payload->uniform;
+	rvm->stats.calls_issued++;
+}
+
+// Mesh
+static void impl_Mesh_Allocate(struct RVM_Mesh_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+	if (!impl_valid_mesh_asset(&payload->asset)) { return; }
+
+	struct VM_Mesh * mesh = engine_ref_pool_claim(rvm->meshes, ref);
+	if (!impl_valid(mesh != NULL)) { return; }
+
+	*mesh = (struct VM_Mesh){
+		.vertices_count = impl_mesh_vertices_count(&payload->asset),
+		.divisor = payload->asset.divisor,
+		.transient = payload->asset.transient, .frame = rvm->frame,
+	};
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Mesh_Free(struct RVM_Mesh_Free const * payload) {
+	struct VM_Mesh * mesh = impl_find_mesh(payload->ref);
+	if (!mesh) { return; }
+
+	if (rvm->state.mesh == mesh) { rvm->state.mesh = NULL; }
+	engine_ref_pool_release(rvm->meshes, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Mesh_Load(struct RVM_Mesh_Load const * payload) {
+	struct VM_Mesh * mesh = impl_find_mesh(payload->ref);
+	if (!mesh) { return; }
+	if (!impl_valid_mesh_asset(&payload->asset)) { return; }
+
+	mesh->vertices_count = impl_mesh_vertices_count(&payload->asset);
+	mesh->divisor = payload->asset.divisor;
+	mesh->transient = payload->asset.transient;
+	mesh->frame = rvm->frame;
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Mesh_Use(struct RVM_Mesh_Use const * payload) {
+	struct VM_Mesh const * mesh = NULL;
+	if (payload->ref.id != REF_EMPTY_ID) {
+		mesh = impl_find_mesh(payload->ref);
+		if (!mesh) { return; }
+	}
+
+	if (!impl_state_changed(rvm->state.mesh != mesh)) { return; }
+	rvm->state.mesh = mesh;
+}
+
+// Texture
+static void impl_Texture_Allocate(struct RVM_Texture_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+	if (!impl_valid_texture_asset(&payload->asset)) { return; }
+
+	struct VM_Texture * texture = engine_ref_pool_claim(rvm->textures, ref);
+	if (!impl_valid(texture != NULL)) { return; }
+
+	*texture = (struct VM_Texture){
+		.size = payload->asset.size,
+	};
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Texture_Free(struct RVM_Texture_Free const * payload) {
+	struct VM_Texture * texture = impl_find_texture(payload->ref);
+	if (!texture) { return; }
+	if (!impl_valid(!texture->attachment)) { return; }
+
+	for (u32 i = 0; i < VM_TEXTURE_UNITS; ++i) {
+		if (rvm->state.textures[i] == texture) { rvm->state.textures[i] = NULL; }
+	}
+	engine_ref_pool_release(rvm->textures, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Texture_Load(struct RVM_Texture_Load const * payload) {
+	struct VM_Texture * texture = impl_find_texture(payload->ref);
+	if (!texture) { return; }
+	if (!impl_valid_texture_asset(&payload->asset)) { return; }
+
+	texture->size = payload->asset.size;
+	rvm->stats.calls_issued++;
+}
+
+// Sampler
+static void impl_Sampler_Allocate(struct RVM_Sampler_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+	if (!impl_valid_sampler(&payload->value)) { return; }
+
+	struct VM_Sampler * sampler = engine_ref_pool_claim(rvm->samplers, ref);
+	if (!impl_valid(sampler != NULL)) { return; }
+
+	*sampler = (struct VM_Sampler){
+		.value = payload->value,
+	};
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Sampler_Free(struct RVM_Sampler_Free const * payload) {
+	struct VM_Sampler * sampler = impl_find_sampler(payload->ref);
+	if (!sampler) { return; }
+
+	for (u32 i = 0; i < VM_TEXTURE_UNITS; ++i) {
+		if (rvm->state.samplers[i] == sampler) { rvm->state.samplers[i] = NULL; }
+	}
+	engine_ref_pool_release(rvm->samplers, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Sampler_Use(struct RVM_Sampler_Use const * payload) {
+	if (!impl_valid(payload->unit < VM_TEXTURE_UNITS)) { return; }
+
+	struct VM_Sampler const * sampler = NULL;
+	if (payload->ref.id != REF_EMPTY_ID) {
+		sampler = impl_find_sampler(payload->ref);
+		if (!sampler) { return; }
+	}
+
+	if (!impl_state_changed(rvm->state.samplers[payload->unit] != sampler)) { return; }
+	rvm->state.samplers[payload->unit] = sampler;
+}
+
+// Unit
+static void impl_Unit_Allocate(struct RVM_Unit_Allocate const * payload) {
+	if (!impl_valid(payload->unit < VM_TEXTURE_UNITS)) { return; }
+
+	struct VM_Texture const * texture = NULL;
+	if (payload->texture.id != REF_EMPTY_ID) {
+		texture = impl_find_texture(payload->texture);
+		if (!texture) { return; }
+	}
+
+	if (!impl_state_changed(rvm->state.textures[payload->unit] != texture)) { return; }
+	rvm->state.textures[payload->unit] = texture;
+}
+
+static void impl_Unit_Free(struct RVM_Unit_Free const * payload) {
+	if (!impl_valid(payload->unit < VM_TEXTURE_UNITS)) { return; }
+	if (!impl_state_changed(rvm->state.textures[payload->unit] != NULL)) { return; }
+	rvm->state.textures[payload->unit] = NULL;
+}
+
+// Render
+static void impl_Render_Clear(struct RVM_Render_Clear const * payload) {
+	if (!impl_valid(((u32)payload->mask & ~(u32)RVM_Clear_All) == 0)) { return; }
+	if (payload->mask) { rvm->stats.calls_issued++; }
+}
+
+static void impl_Render_Draw(struct RVM_Render_Draw const * payload) {
+	struct VM_Shader const * shader = rvm->state.shader;
+	struct VM_Mesh const * mesh = rvm->state.mesh;
+	if (!impl_valid(shader && mesh)) { return; }
+	if (!impl_valid(shader->loaded && impl_mesh_is_fresh(mesh))) { return; }
+	if (!impl_valid(payload->offset <= mesh->vertices_count && payload->length <= mesh->vertices_count - payload->offset)) { return; }
+
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Render_Draw_Instanced(struct RVM_Render_Draw_Instanced const * payload) {
+	struct VM_Shader const * shader = rvm->state.shader;
+	struct VM_Mesh const * mesh = rvm->state.mesh;
+	if (!impl_valid(shader && mesh)) { return; }
+	if (!impl_valid(shader->loaded && impl_mesh_is_fresh(mesh))) { return; }
+	if (!impl_valid(payload->offset <= mesh->vertices_count && payload->length <= mesh->vertices_count - payload->offset)) { return; }
+
+	struct VM_Mesh const * instances = impl_find_mesh(payload->instances);
+	if (!instances) { return; }
+	if (!impl_valid(instances->divisor > 0 && impl_mesh_is_fresh(instances))) { return; }
+
+	u32 const elements = (payload->count + instances->divisor - 1) / instances->divisor;
+	if (!impl_valid(payload->instances_offset <= instances->vertices_count && elements <= instances->vertices_count - payload->instances_offset)) { return; }
+
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Render_Draw_Indirect(struct RVM_Render_Draw_Indirect const * payload) {
+	struct VM_Shader const * shader = rvm->state.shader;
+	struct VM_Mesh const * mesh = rvm->state.mesh;
+	if (!impl_valid(shader && mesh)) { return; }
+	if (!impl_valid(shader->loaded && impl_mesh_is_fresh(mesh))) { return; }
+
+	// arguments follow the payload
+	struct RVM_Draw_Arguments const * arguments = (void const *)((u8 const *)payload + impl_payload_sizes[RVM_Instruction_Render_Draw_Indirect]);
+	if (!impl_valid((u64)payload->count * sizeof(*arguments) <= rvm->payload_size - impl_payload_sizes[RVM_Instruction_Render_Draw_Indirect])) { return; }
+
+	struct VM_Mesh const * instances = NULL;
+	if (payload->instances.id != REF_EMPTY_ID) {
+		instances = impl_find_mesh(payload->instances);
+		if (!instances) { return; }
+		if (!impl_valid(instances->divisor > 0 && impl_mesh_is_fresh(instances))) { return; }
+	}
+
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Draw_Arguments const * draw = arguments + i;
+		if (!impl_valid(draw->offset <= mesh->vertices_count && draw->length <= mesh->vertices_count - draw->offset)) { return; }
+		if (!instances) { continue; }
+
+		u32 const elements = (draw->count + instances->divisor - 1) / instances->divisor;
+		if (!impl_valid(draw->instances_offset <= instances->vertices_count && elements <= instances->vertices_count - draw->instances_offset)) { return; }
+	}
+
+	rvm->stats.calls_issued++;
+}
+
+// Pipeline
+static void impl_Pipeline_Allocate(struct RVM_Pipeline_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+	if (!impl_valid_pipeline(&payload->value)) { return; }
+
+	struct VM_Pipeline * pipeline = engine_ref_pool_claim(rvm->pipelines, ref);
+	if (!impl_valid(pipeline != NULL)) { return; }
+
+	pipeline->value = payload->value;
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Pipeline_Free(struct RVM_Pipeline_Free const * payload) {
+	if (!impl_find_pipeline(payload->ref)) { return; }
+
+	engine_ref_pool_release(rvm->pipelines, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Pipeline_Use(struct RVM_Pipeline_Use const * payload) {
+	struct Ref const ref = payload->ref;
+
+	// an empty ref resets to the defaults
+	struct RVM_Pipeline const * value = &impl_pipeline_defaults;
+	if (ref.id != REF_EMPTY_ID) {
+		struct VM_Pipeline const * pipeline = impl_find_pipeline(ref);
+		if (!pipeline) { return; }
+		value = &pipeline->value;
+	}
+
+	impl_Shader_Use(&value->shader);
+
+	// as the GL backend diffs its packed pipeline word: one skip for an equal state, the differing fields otherwise
+	struct VM_State const * state = &rvm->state;
+	bool const color_write = state->color_write != value->color_write.value;
+	bool const blend = state->blend != value->blend.value;
+	bool const depth_read = state->depth_test != value->depth_read.value;
+	bool const depth_write = state->depth_write != value->depth_write.value;
+	bool const depth_comparison = state->depth_comparison != value->depth_comparison.value;
+	bool const stencil_read = state->stencil_test != value->stencil_read.value;
+	bool const stencil_write = state->stencil_write != value->stencil_write.value;
+	bool const stencil_comparison =
+		state->stencil_comparison != value->stencil_comparison.comparison ||
+		state->stencil_reference != value->stencil_comparison.reference ||
+		state->stencil_mask != value->stencil_comparison.mask;
+	bool const stencil_operation =
+		state->stencil_fail != value->stencil_operation.stencil_fail__depth_any ||
+		state->stencil_depth_fail != value->stencil_operation.stencil_success__depth_fail ||
+		state->stencil_depth_pass != value->stencil_operation.stencil_success__depth_success;
+	bool const cull = state->cull_mode != value->cull.value;
+	bool const front = state->front_face != value->front.value;
+
+	if (!(
+		color_write || blend ||
+		depth_read || depth_write || depth_comparison ||
+		stencil_read || stencil_write || stencil_comparison || stencil_operation ||
+		cull || front
+	)) { rvm->stats.calls_skipped++; return; }
+
+	if (color_write)        { impl_Color_Set_Write(&value->color_write); }
+	if (blend)              { impl_Color_Set_Blend(&value->blend); }
+	if (depth_read)         { impl_Depth_Set_Read(&value->depth_read); }
+	if (depth_write)        { impl_Depth_Set_Write(&value->depth_write); }
+	if (depth_comparison)   { impl_Depth_Set_Comparison(&value->depth_comparison); }
+	if (stencil_read)       { impl_Stencil_Set_Read(&value->stencil_read); }
+	if (stencil_write)      { impl_Stencil_Set_Write(&value->stencil_write); }
+	if (stencil_comparison) { impl_Stencil_Set_Comparison(&value->stencil_comparison); }
+	if (stencil_operation)  { impl_Stencil_Set_Operation(&value->stencil_operation); }
+	if (cull)               { impl_Face_Set_Cull(&value->cull); }
+	if (front)              { impl_Face_Set_Front(&value->front); }
+}
+
+// Bundle
+static void impl_Bundle_Allocate(struct RVM_Bundle_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Bundle_Allocate];
+	u32 const length = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Bundle_Allocate];
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+
+	u32 const count = impl_bundle_decode(data, length, NULL);
+	if (!impl_valid(count != UINT32_MAX)) { return; }
+
+	struct VM_Bundle * bundle = engine_ref_pool_claim(rvm->bundles, ref);
+	if (!impl_valid(bundle != NULL)) { return; }
+
+	size_t const ops_size = RVM_ALIGN(count * sizeof(*bundle->ops));
+	bundle->ops = ENGINE_MALLOC(ops_size + length);
+	if (!bundle->ops && ops_size + length) { ENGINE_DEBUG_BREAK(); return; }
+	bundle->data = (u8 *)bundle->ops + ops_size;
+	bundle->count = count;
+	if (length) { memcpy(bundle->data, data, length); }
+	impl_bundle_decode(bundle->data, length, bundle->ops);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Bundle_Free(struct RVM_Bundle_Free const * payload) {
+	struct VM_Bundle const * bundle = impl_find_bundle(payload->ref);
+	if (!bundle) { return; }
+
+	ENGINE_FREE(bundle->ops);
+	engine_ref_pool_release(rvm->bundles, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Bundle_Call(struct RVM_Bundle_Call const * payload) {
+	struct VM_Bundle const * bundle = impl_find_bundle(payload->ref);
+	if (!bundle) { return; }
+
+	for (u32 i = 0; i < bundle->count; ++i) {
+		struct VM_Bundle_Op const * op = bundle->ops + i;
+		rvm->payload_size = op->size;
+		impl_handlers[op->instruction](bundle->data + op->offset);
+	}
+}
+
+static void impl_Bundle_Patch(struct RVM_Bundle_Patch const * payload) {
+	struct VM_Bundle const * bundle = impl_find_bundle(payload->ref);
+	if (!bundle) { return; }
+
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Bundle_Patch];
+	u32 const length = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Bundle_Patch];
+	if (!impl_valid(payload->slot < bundle->count)) { return; }
+	if (!impl_valid(length >= sizeof(struct RVM_Header))) { return; }
+
+	// only a payload of the same kind and size fits in place
+	struct VM_Bundle_Op const * op = bundle->ops + payload->slot;
+	struct RVM_Header const * header = (void const *)data;
+	if (!impl_valid(header->instruction == op->instruction && header->size == op->size)) { return; }
+	if (!impl_valid(header->size <= length - sizeof(*header))) { return; }
+
+	memcpy(bundle->data + op->offset, data + sizeof(*header), op->size);
+	rvm->stats.calls_issued++;
+}
+
+// Target
+static void impl_Target_Allocate(struct RVM_Target_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (!impl_valid(ref.id != REF_EMPTY_ID)) { return; }
+	if (!impl_valid_target(payload)) { return; }
+
+	struct VM_Target * target = engine_ref_pool_claim(rvm->targets, ref);
+	if (!impl_valid(target != NULL)) { return; }
+
+	target->size = payload->size;
+	target->count = payload->count;
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Target_Attachment const * attachment = payload->attachments + i;
+		target->kinds[i] = attachment->kind;
+		target->textures[i] = (struct Ref){.id = REF_EMPTY_ID};
+		if (attachment->texture.id == REF_EMPTY_ID) { continue; }
+
+		// the sampled attachments are textures of the stream, owned by the target
+		struct VM_Texture * texture = engine_ref_pool_claim(rvm->textures, attachment->texture);
+		if (!impl_valid(texture != NULL)) { continue; }
+
+		*texture = (struct VM_Texture){.size = payload->size, .attachment = true};
+		target->textures[i] = attachment->texture;
+	}
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Target_Free(struct RVM_Target_Free const * payload) {
+	struct VM_Target const * target = impl_find_target(payload->ref);
+	if (!target) { return; }
+
+	if (rvm->state.target == target) { rvm->state.target = NULL; }
+	for (u32 i = 0; i < target->count; ++i) {
+		struct VM_Texture const * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (!texture) { continue; }
+		for (u32 unit = 0; unit < VM_TEXTURE_UNITS; ++unit) {
+			if (rvm->state.textures[unit] == texture) { rvm->state.textures[unit] = NULL; }
+		}
+		engine_ref_pool_release(rvm->textures, target->textures[i]);
+	}
+	engine_ref_pool_release(rvm->targets, payload->ref);
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Target_Load(struct RVM_Target_Load const * payload) {
+	struct VM_Target * target = impl_find_target(payload->ref);
+	if (!target) { return; }
+	if (!impl_valid(payload->size.x > 0 && payload->size.y > 0)) { return; }
+
+	target->size = payload->size;
+	for (u32 i = 0; i < target->count; ++i) {
+		struct VM_Texture * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (texture) { texture->size = payload->size; }
+	}
+	rvm->stats.calls_issued++;
+}
+
+static void impl_Target_Use(struct RVM_Target_Use const * payload) {
+	struct VM_Target const * target = NULL;
+	if (payload->ref.id != REF_EMPTY_ID) {
+		target = impl_find_target(payload->ref);
+		if (!target) { return; }
+	}
+
+	if (!impl_state_changed(rvm->state.target != target)) { return; }
+	rvm->state.target = target;
+}
+
+static void impl_Target_Clear(struct RVM_Target_Clear const * payload) {
+	struct VM_Target const * target = rvm->state.target;
+	if (!impl_valid(target != NULL)) { return; }
+	if (!impl_valid(payload->attachment < target->count)) { return; }
+
+	rvm->stats.calls_issued++;
+}
+
+//
+#undef VM_TEXTURE_UNITS
@@ -1,89 +1,506 @@
 #include "engine/api/code.h"
-#include "engine/api/ref.h"
+#include "engine/api/ref_pool.h"
 #include "engine/api/math_types.h"
 #include "engine/api/asset_types.h"
 #include "engine/api/graphics_types.h"
 #include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_capture.h"
 #include "opengl.h"
 
-#define GET_VALUE(type, name) type name; memcpy(&name, buffer, sizeof(name)); buffer += sizeof(name);
 #define OGL_VERSION(major, minor) (major * 10 + minor)
+#define VM_TEXTURE_UNITS 16
+#define VM_STREAM_SIZE (4 * 1024 * 1024)
+#define VM_STREAM_FRAMES 4
+#define VM_STREAM_ALIGNMENT 16
+#define VM_UPLOAD_SIZE (8 * 1024 * 1024)
+#define VM_UPLOAD_BUDGET (2 * 1024 * 1024)
+#define VM_RETIRE_FRAMES 4
+#define VM_TARGET_FRAMES 4
+
+#define REGISTRY_RVM_INSTRUCTION(name, scope) static void impl_ ## name(struct RVM_ ## name const * payload);
+#include "engine/registry/rendering_vm_instruction.h"
+
+#define REGISTRY_RVM_OPENGL(name, major, minor) static void impl_ ## name ## _ ## major ## minor(struct RVM_ ## name const * payload);
+#include "engine/registry/rendering_vm_opengl.h"
 
-#define REGISTRY_RVM_INSTRUCTION(name) static void impl_ ## name(u8 const * buffer);
+typedef void RVM_Handler(void const * payload);
+
+// payloads are aligned, so the handlers read them in place
+#define REGISTRY_RVM_INSTRUCTION(name, scope) static void impl_dispatch_ ## name(void const * payload) { impl_ ## name(payload); }
 #include "engine/registry/rendering_vm_instruction.h"
 
+#define REGISTRY_RVM_OPENGL(name, major, minor) static void impl_dispatch_ ## name ## _ ## major ## minor(void const * payload) { impl_ ## name ## _ ## major ## minor(payload); }
+#include "engine/registry/rendering_vm_opengl.h"
+
+// the oldest context's handlers; `engine_rendering_vm_init` replaces them with the variants its context supports
+static RVM_Handler * const impl_handlers[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) impl_dispatch_ ## name,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static u32 const impl_payload_sizes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_PAYLOAD_SIZE(name),
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static enum RVM_Scope const impl_scopes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_Scope_ ## scope,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+// uniform blocks are bound at the points of the same index
+enum VM_Block {
+	VM_Block_Frame,
+	VM_Block_Material,
+	VM_Block_Draw,
+	VM_Block_Count,
+	VM_Block_None = VM_Block_Count,
+};
+
+static cstring const impl_block_names[] = {"Frame", "Material", "Draw"};
+
+static cstring const impl_uniform_names[] = {
+	#define REGISTRY_RVM_UNIFORM(name, block) # name,
+	#include "engine/registry/rendering_vm_uniform.h"
+};
+
+static enum VM_Block const impl_uniform_blocks[] = {
+	#define REGISTRY_RVM_UNIFORM(name, block) VM_Block_ ## block,
+	#include "engine/registry/rendering_vm_uniform.h"
+};
+
+// shadow copy of the GL state, in GL terms; a few RVM values can map onto the same GL state
+struct VM_State {
+	bool blend, depth_test, stencil_test, cull_face;
+	//
+	GLenum clip_origin, clip_depth;
+	svec2 viewport_pos, viewport_size;
+	//
+	enum RVM_Color_Write color_write;
+	vec4 color_clear;
+	GLenum blend_src, blend_dst;
+	//
+	bool depth_write;
+	r32 depth_clear;
+	GLenum depth_func;
+	vec2 depth_range;
+	//
+	GLuint stencil_write;
+	GLint stencil_clear;
+	GLenum stencil_func; GLint stencil_reference; GLuint stencil_mask;
+	GLenum stencil_fail, stencil_depth_fail, stencil_depth_pass;
+	//
+	GLenum cull_mode, front_face;
+	//
+	GLuint program, vertex_array, framebuffer;
+	GLuint active_unit, textures[VM_TEXTURE_UNITS], samplers[VM_TEXTURE_UNITS];
+	//
+	struct VM_Block_Range { GLuint buffer; size_t offset, size; } blocks[VM_Block_Count];
+};
+
+// a ring for the data that lives a frame, each frame fences its share once submitted
+// - >= 4.4 it is mapped persistently, >= 3.2 mapped per write, unsynchronized; older ones orphan it on wrap
+// - a write waits on the oldest fence only when the ring has wrapped onto the frame it guards
+struct VM_Stream {
+	GLuint buffer; GLenum target;
+	size_t size;
+	u8 * mapped;
+	size_t head, used; // `used` spans the frames in flight and the current one
+	size_t frame_size;
+	GLsync fences[VM_STREAM_FRAMES]; size_t sizes[VM_STREAM_FRAMES];
+	u32 fences_first, fences_count;
+};
+
+// GL objects freed by the stream, deleted once the GPU is done with the frames that could still use them
+// - a frame's share is fenced at its end and deleted in batches, a call per kind, when the fence signals
+// - before 3.2 there are no fences, a share waits out `VM_RETIRE_FRAMES` frames instead
+// - names stay reserved until then, so the state cache never mistakes a new object for a deleted one
+enum VM_Retire_Kind {
+	VM_Retire_Program,
+	VM_Retire_Vertex_Array,
+	VM_Retire_Buffer,
+	VM_Retire_Texture,
+	VM_Retire_Renderbuffer,
+	VM_Retire_Framebuffer,
+	VM_Retire_Sampler,
+	VM_Retire_Count,
+};
+struct VM_Retire_Share {
+	GLsync fence; u32 frame;
+	struct VM_Retire_List { GLuint * ids; u32 count, capacity; } lists[VM_Retire_Count];
+};
+struct VM_Retire {
+	struct VM_Retire_Share shares[VM_RETIRE_FRAMES + 1]; // in flight, then the current one
+	u32 first, count;
+};
+
+// the state of the `*_Set_*` instructions a pipeline covers, as RVM values packed into a word
+// - the setters keep the word of the current state, `Pipeline_Use` diffs it against a baked one
+// - a field spans up to the next one; the stencil comparison and operation pack their members in order
+enum VM_Pipeline_Field {
+	VM_Pipeline_Color_Write,
+	VM_Pipeline_Blend,
+	VM_Pipeline_Depth_Read,
+	VM_Pipeline_Depth_Write,
+	VM_Pipeline_Depth_Comparison,
+	VM_Pipeline_Stencil_Read,
+	VM_Pipeline_Stencil_Write,
+	VM_Pipeline_Stencil_Comparison,
+	VM_Pipeline_Stencil_Operation,
+	VM_Pipeline_Cull,
+	VM_Pipeline_Front,
+	VM_Pipeline_Count,
+};
+
+static u8 const impl_pipeline_shifts[VM_Pipeline_Count + 1] = {0, 4, 7, 8, 9, 12, 13, 21, 40, 49, 51, 52};
+
+// what a fresh context has, as `impl_reset_state` sets it
+static struct RVM_Pipeline const impl_pipeline_defaults = {
+	.shader = {.ref = {.id = REF_EMPTY_ID}},
+	.color_write = {.value = RVM_Color_Write_All},
+	.blend = {.value = RVM_Color_Blend_Opaque},
+	.depth_write = {.value = true},
+	.depth_comparison = {.value = RVM_Comparison_Less},
+	.stencil_write = {.value = 0xff},
+	.stencil_comparison = {.comparison = RVM_Comparison_True, .reference = 0, .mask = 0xff},
+	.cull = {.value = RVM_Face_Cull_None},
+	.front = {.value = RVM_Face_Front_CCW},
+};
+
+static void impl_reset_state(struct VM_State * state);
+static u64 impl_pipeline_pack(struct RVM_Pipeline const * value);
+static u32 impl_hash_name(GLchar const * name, size_t length);
+static void impl_free_shaders(void);
+static void impl_free_bundles(void);
+static void impl_free_samplers(void);
+static void impl_resources_init(void);
+static void impl_stream_init(struct VM_Stream * stream, GLenum target, size_t size);
+static void impl_stream_free(struct VM_Stream * stream);
+static void impl_stream_fence(struct VM_Stream * stream);
+static void impl_stream_unbind(struct VM_Stream const * stream);
+static void impl_free_uploads(void);
+static void impl_uploads_pump(void);
+static void impl_retire_free(void);
+static void impl_retire_fence(void);
+static void impl_framebuffers_age(void);
+static void impl_target_resolve_bound(void);
+
 //
 // API
 //
 
 struct VM_Shader;
+struct VM_Shader_Reflection;
 struct VM_Mesh;
 struct VM_Texture;
-// struct VM_Sampler;
-// struct VM_Target;
+struct VM_Pipeline_State;
+struct VM_Target;
+struct VM_Framebuffer;
+struct VM_Sampler;
+struct VM_Sampler_State;
+struct VM_Upload;
 struct Rendering_VM {
 	GLint version;
+	RVM_Handler * handlers[RVM_Instruction_Count];
+	//
+	struct Ref_Pool * shaders;     // of `VM_Shader`
+	struct Ref_Pool * reflections; // of `VM_Shader_Reflection`, cold halves of the `shaders` under the same refs
+	struct Ref_Pool * meshes;      // of `VM_Mesh`
+	struct Ref_Pool * textures;    // of `VM_Texture`
+	struct Ref_Pool * pipelines;   // of `VM_Pipeline`
+	struct Ref_Pool * bundles;     // of `VM_Bundle`
+	struct Ref_Pool * targets;     // of `VM_Target`
+	struct Ref_Pool * samplers;    // of `VM_Sampler`
+	//
+	struct VM_State state;
+	struct RVM_Stats stats;
+	struct VM_Stream stream;
+	struct VM_Retire retire;
+	//
+	struct VM_Stream uploads; // of texture data, in bands of rows
+	struct VM_Upload * upload_queue; u32 upload_queue_count, upload_queue_capacity; // the loads the budget has deferred, in order
+	size_t upload_budget; // the bytes the frame may still upload
 	//
-	struct VM_Shader  * shaders;  size_t shaders_capacity;
-	struct VM_Mesh    * meshes;   size_t meshes_capacity;
-	struct VM_Texture * textures; size_t textures_capacity;
-	// struct VM_Sampler * samplers; size_t sampler_capacity;
-	// struct VM_Target  * targets;  size_t targets_capacity;
+	struct VM_Pipeline_State * pipeline_states; u32 pipeline_states_count, pipeline_states_capacity; // baked, shared by the equal pipelines
+	u64 pipeline_bits; // of the current state
 	//
-	u32 shader, mesh, texture;
+	struct VM_Framebuffer * framebuffers; u32 framebuffers_count, framebuffers_capacity; // of the targets, and the pooled transient ones
+	u32 target; // the framebuffer in use, UINT32_MAX for the window
+	GLint max_samples;
+	//
+	struct VM_Sampler_State * sampler_states; u32 sampler_states_count, sampler_states_capacity; // shared by the equal samplers and textures
+	struct VM_Unit { struct Ref texture, sampler; } units[VM_TEXTURE_UNITS]; // of `Unit_Allocate` and `Sampler_Use`
+	GLint max_anisotropy; // zero without anisotropic filtering
+	//
+	struct VM_Shader * shader; struct VM_Mesh * mesh; // of `Shader_Use` and `Mesh_Use`, their program and vertex array are the bound ones
+	u32 meshes_revision;
+	GLuint draws_buffer, draws_binding; // the fallback for arguments off the stream, the `GL_DRAW_INDIRECT_BUFFER` one
+	GLuint blocks_buffers[VM_Block_Count]; // the fallback for uniform blocks off the stream
+	size_t blocks_alignment;
+	u32 frame;
+	u32 uniform_hashes[RVM_Uniform_Count], block_hashes[VM_Block_Count];
+	//
+	u32 payload_size; // of the current instruction, with its trailing data
 };
 static struct Rendering_VM * rvm;
 
 void engine_rendering_vm_init(void) {
 	struct Rendering_VM * rendering_vm = ENGINE_MALLOC(sizeof(*rvm));
+	memset(rendering_vm, 0, sizeof(*rendering_vm));
 
 	GLint version_major, version_minor;
 	glGetIntegerv(GL_MAJOR_VERSION, &version_major);
 	glGetIntegerv(GL_MINOR_VERSION, &version_minor);
 	rendering_vm->version = OGL_VERSION(version_major, version_minor);
+	if (rendering_vm->version < OGL_VERSION(3, 3)) { printf("[err] GL 3.3 is required, the shaders are GLSL 330\n"); }
+
+	// features are chosen here once, the handlers don't branch on the version
+	memcpy(rendering_vm->handlers, impl_handlers, sizeof(impl_handlers));
+	#define REGISTRY_RVM_OPENGL(name, major, minor) \
+		if (rendering_vm->version >= OGL_VERSION(major, minor)) { rendering_vm->handlers[RVM_Instruction_ ## name] = impl_dispatch_ ## name ## _ ## major ## minor; }
+	#include "engine/registry/rendering_vm_opengl.h"
+
+	if (rendering_vm->version < OGL_VERSION(4, 5)) { printf("[wrn] no clip control, `Common_Set_Clip` is ignored\n"); }
+
+	GLint blocks_alignment = 0;
+	if (rendering_vm->version >= OGL_VERSION(3, 1)) {
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &blocks_alignment);
+	}
+	rendering_vm->blocks_alignment = (blocks_alignment > VM_STREAM_ALIGNMENT) ? (size_t)blocks_alignment : VM_STREAM_ALIGNMENT;
+
+	glGetIntegerv(GL_MAX_SAMPLES, &rendering_vm->max_samples);
+	rendering_vm->target = UINT32_MAX;
 
-	rendering_vm->shader  = REF_EMPTY_ID;
-	rendering_vm->mesh    = REF_EMPTY_ID;
-	rendering_vm->texture = REF_EMPTY_ID;
+	if (rendering_vm->version >= OGL_VERSION(4, 6)) {
+		glGetIntegerv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &rendering_vm->max_anisotropy);
+	}
+	for (u32 i = 0; i < VM_TEXTURE_UNITS; ++i) {
+		rendering_vm->units[i] = (struct VM_Unit){.texture = {.id = REF_EMPTY_ID}, .sampler = {.id = REF_EMPTY_ID}};
+	}
+
+	for (u32 i = 0; i < RVM_Uniform_Count; ++i) {
+		rendering_vm->uniform_hashes[i] = impl_hash_name(impl_uniform_names[i], strlen(impl_uniform_names[i]));
+	}
+	for (u32 i = 0; i < VM_Block_Count; ++i) {
+		rendering_vm->block_hashes[i] = impl_hash_name(impl_block_names[i], strlen(impl_block_names[i]));
+	}
+
+	impl_reset_state(&rendering_vm->state);
+	rendering_vm->pipeline_bits = impl_pipeline_pack(&impl_pipeline_defaults);
 
 	rvm = rendering_vm;
+
+	impl_resources_init();
+	impl_stream_init(&rvm->stream, GL_ARRAY_BUFFER, VM_STREAM_SIZE);
+	impl_stream_init(&rvm->uploads, GL_PIXEL_UNPACK_BUFFER, VM_UPLOAD_SIZE);
+	rvm->upload_budget = VM_UPLOAD_BUDGET;
+
+	// texture rows of any texel size are packed tight
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 }
 
 void engine_rendering_vm_deinit(void) {
+	impl_retire_free();
+	impl_stream_free(&rvm->stream);
+	impl_stream_free(&rvm->uploads);
+	if (rvm->draws_buffer) { glDeleteBuffers(1, &rvm->draws_buffer); }
+	for (u32 i = 0; i < VM_Block_Count; ++i) {
+		if (rvm->blocks_buffers[i]) { glDeleteBuffers(1, &rvm->blocks_buffers[i]); }
+	}
+	impl_free_shaders();
+	impl_free_bundles();
+	impl_free_samplers();
+	impl_free_uploads();
+	engine_ref_pool_destroy(rvm->shaders);
+	engine_ref_pool_destroy(rvm->reflections);
+	engine_ref_pool_destroy(rvm->meshes);
+	engine_ref_pool_destroy(rvm->textures);
+	engine_ref_pool_destroy(rvm->pipelines);
+	engine_ref_pool_destroy(rvm->bundles);
+	engine_ref_pool_destroy(rvm->targets);
+	engine_ref_pool_destroy(rvm->samplers);
+	ENGINE_FREE(rvm->pipeline_states);
+	ENGINE_FREE(rvm->framebuffers);
+	ENGINE_FREE(rvm->sampler_states);
+	ENGINE_FREE(rvm->upload_queue);
 	ENGINE_FREE(rvm);
 }
 
-void engine_rendering_vm_update(u8 const * buffer, size_t buffer_length) {
-	u8 const * buffer_end = buffer + buffer_length;
-	while (buffer < buffer_end) {
-		GET_VALUE(enum RVM_Instruction, instruction)
-		switch (instruction) {
-			#define REGISTRY_RVM_INSTRUCTION(name) case RVM_Instruction_ ## name: impl_ ## name(buffer); break;
-			#include "engine/registry/rendering_vm_instruction.h"
-		}
+struct RVM_Stats engine_rendering_vm_get_stats(void) {
+	return rvm->stats;
+}
+
+void engine_rendering_vm_reset_stats(void) {
+	rvm->stats = (struct RVM_Stats){0};
+}
+
+u32 engine_rendering_vm_get_resources_count(void) {
+	return engine_ref_pool_get_count(rvm->shaders)
+	     + engine_ref_pool_get_count(rvm->meshes)
+	     + engine_ref_pool_get_count(rvm->textures)
+	     + engine_ref_pool_get_count(rvm->pipelines)
+	     + engine_ref_pool_get_count(rvm->bundles)
+	     + engine_ref_pool_get_count(rvm->targets)
+	     + engine_ref_pool_get_count(rvm->samplers);
+}
+
+void engine_rendering_vm_end_frame(void) {
+	impl_target_resolve_bound();
+	impl_framebuffers_age();
+	impl_uploads_pump();
+	impl_stream_fence(&rvm->stream);
+	impl_stream_fence(&rvm->uploads);
+	impl_retire_fence();
+	rvm->upload_budget = VM_UPLOAD_BUDGET;
+	rvm->frame++;
+}
+
+size_t engine_rendering_vm_update(u8 const * buffer, size_t buffer_length) {
+	u8 const * const buffer_start = buffer;
+	u8 const * const buffer_end = buffer + buffer_length;
+	while ((size_t)(buffer_end - buffer) >= sizeof(struct RVM_Header)) {
+		struct RVM_Header const * header = (void const *)buffer;
+		u8 const * payload = buffer + sizeof(*header);
+
+		if (header->instruction >= RVM_Instruction_Count) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size < impl_payload_sizes[header->instruction]) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size > (size_t)(buffer_end - payload)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size % RVM_ALIGNMENT) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+
+		rvm->payload_size = header->size;
+		rvm->handlers[header->instruction](payload);
+		buffer = payload + header->size;
 	}
+
+	size_t const consumed = (size_t)(buffer - buffer_start);
+	engine_rendering_capture_record(buffer_start, consumed);
+	return consumed;
 }
 
 //
 // internal implementation
 //
 
+// the hot half of a shader, what uniforms and draws read, indexed by the registry IDs
 struct VM_Shader_Field {
-	GLint location;
-	u32 id;
+	GLint location; // in the default block, or -1
+	s32 offset; u16 array_stride, matrix_stride; // in its uniform block, or -1
+};
+struct VM_Shader_Block {
+	u8 * data; u32 size; // std140 values, uploaded whole; absent from the program when empty
+	u32 offset, frame; bool dirty; // of the last upload, into the stream
 };
 struct VM_Shader {
 	GLuint id;
-	// struct VM_Shader_Field attributes[10]; size_t attributes_count;
-	struct VM_Shader_Field uniforms[10];   size_t uniforms_count;
+	struct VM_Shader_Block blocks[VM_Block_Count];
+	struct VM_Shader_Field uniforms[RVM_Uniform_Count];
+};
+
+// the cold half, everything the program declares; only loading reads it
+// - each kind is sorted by name hash, names tell collisions apart
+struct VM_Shader_Symbol {
+	u32 hash, name; // `name` is an offset into the `names`
+	GLuint index; GLint block; // active index, its uniform block or -1
+	GLint location;
+	GLenum type; GLint size; // of an element and their count, or of a block in bytes
+};
+struct VM_Shader_Reflection {
+	struct VM_Shader_Symbol * symbols; // uniforms, attributes, then blocks
+	u32 uniforms_count, attributes_count, blocks_count;
+	GLchar * names;
 };
 
 struct VM_Mesh {
-	GLuint id;
+	GLuint id, buffer; // vertex array, vertex buffer
+	GLuint data_buffer; size_t data_offset; // where the vertices are: `buffer`, or the stream for a frame
+	bool transient; u32 frame; // a transient one is valid in the `frame` it is loaded only
+	GLenum type; u32 stride; // in bytes
+	u8 attributes[ASSET_MESH_ATTRIBUTES]; u32 attributes_count;
+	u32 vertices_count, revision;
+	// an instance stream
+	u32 divisor, location;
+	// the instance stream attached to this vertex array, stays until another replaces it
+	u32 instances, instances_revision, instances_offset;
 };
 
 struct VM_Texture {
 	GLuint id;
+	bool attachment; // of a target, freed along with it
+	u32 sampler;     // index into the `sampler_states`, its own settings
+	svec2 size; GLenum internal_format; // of its storage, kept by the loads that match
+};
+
+// the rows of a load not uploaded yet, they go through the `uploads` ring in bands under the frame's budget
+// - a load takes what is left of the budget at once; the rest is copied aside and goes in at the ends of the next frames
+// - the copies are kept with their queue slots, so a steady flow of loads allocates nothing
+struct VM_Upload {
+	struct Ref texture;
+	u8 const * data; // of the `row`, the next one to upload
+	u32 row, rows; size_t row_size;
+	GLsizei width; GLenum format, type;
+	bool mipmaps; // generated once the last row is in
+	u8 * copy; size_t capacity;
+};
+
+// a baked pipeline; the packed word and the shader are its key, an entry without users is free
+struct VM_Pipeline_State {
+	u64 bits; struct Ref shader;
+	u32 users;
+	struct RVM_Pipeline value;
+};
+
+struct VM_Pipeline {
+	u32 state; // index into the `pipeline_states`
+};
+
+// filtering and wrapping; the packed word is its key, an entry without users is free
+// - >= 3.3 it is a sampler object, made on first use and bound per unit
+// - before, it is written into the parameters of the texture a unit samples, when they hold other ones
+struct VM_Sampler_State {
+	u32 bits, users;
+	GLuint id;
+	struct RVM_Sampler value; // with the anisotropy clamped
+};
+
+struct VM_Sampler {
+	u32 state; // index into the `sampler_states`
+};
+
+// a recorded instruction, translated to the handler this context picked; `offset` is of its payload
+struct VM_Bundle_Op {
+	RVM_Handler * handler;
+	u32 offset, size;
+};
+
+// decoded operations, followed by the recorded data in the same allocation
+struct VM_Bundle {
+	struct VM_Bundle_Op * ops; u32 count;
+	u8 * data;
+};
+
+// what a framebuffer is made of; transient ones are pooled by it, so it is zeroed before filling and compared whole
+struct VM_Target_Desc {
+	svec2 size; u32 samples, count; // `samples` is zero when single-sampled
+	struct VM_Target_Format {
+		enum Texture_Type kind; enum Data_Type type; u8 channels;
+		bool sampled; // through a texture
+	} formats[RVM_TARGET_ATTACHMENTS];
+};
+
+// the GL side of a target, an entry without an id is free
+// - single-sampled, the sampled attachments are textures and the others renderbuffers
+// - multisampled, all are renderbuffers; the sampled ones are resolved into the textures of the `resolve` framebuffer
+struct VM_Framebuffer {
+	struct VM_Target_Desc desc;
+	GLuint id, resolve;
+	GLuint textures[RVM_TARGET_ATTACHMENTS], renderbuffers[RVM_TARGET_ATTACHMENTS];
+	bool transient, used;
+	u32 idle_frames; // of an unused transient one
+};
+
+struct VM_Target {
+	u32 framebuffer; // index into the `framebuffers`
+	struct Ref textures[RVM_TARGET_ATTACHMENTS];
 };
 
 // mapping
@@ -141,7 +558,7 @@ static GLenum get_filter_min(enum Filter_Type mipmap, enum Filter_Type type) {
 	switch (mipmap) {
 		case Filter_Type_None: switch (type) { // no mipmaps
 			case Filter_Type_None: return GL_NEAREST;
-			case Filter_Type_Point: return GL_POINT;
+			case Filter_Type_Point: return GL_NEAREST;
 			case Filter_Type_Linear: return GL_LINEAR;
 		} break;
 		case Filter_Type_Point: switch (type) { // single mipmap
@@ -216,6 +633,66 @@ static GLenum get_data_type(enum Data_Type value) {
 	return GL_NONE;
 }
 
+static u32 get_data_type_size(enum Data_Type value) {
+	switch (value) {
+		//
+		case Data_Type_s8:  return sizeof(s8);
+		case Data_Type_s16: return sizeof(s16);
+		case Data_Type_s32: return sizeof(s32);
+		//
+		case Data_Type_u8:  return sizeof(u8);
+		case Data_Type_u16: return sizeof(u16);
+		case Data_Type_u32: return sizeof(u32);
+		//
+		case Data_Type_r32: return sizeof(r32);
+		case Data_Type_r64: return sizeof(r64);
+		//
+		case Data_Type_vec2: return sizeof(vec2);
+		case Data_Type_vec3: return sizeof(vec3);
+		case Data_Type_vec4: return sizeof(vec4);
+		//
+		case Data_Type_svec2: return sizeof(svec2);
+		case Data_Type_svec3: return sizeof(svec3);
+		case Data_Type_svec4: return sizeof(svec4);
+		//
+		case Data_Type_uvec2: return sizeof(uvec2);
+		case Data_Type_uvec3: return sizeof(uvec3);
+		case Data_Type_uvec4: return sizeof(uvec4);
+		//
+		case Data_Type_mat2: return sizeof(mat2);
+		case Data_Type_mat3: return sizeof(mat3);
+		case Data_Type_mat4: return sizeof(mat4);
+		//
+		case Data_Type_unit_id: return sizeof(s32);
+	}
+	ENGINE_DEBUG_BREAK();
+	return 0;
+}
+
+static u32 get_data_type_columns(enum Data_Type value) {
+	switch (value) {
+		case Data_Type_mat2: return 2;
+		case Data_Type_mat3: return 3;
+		case Data_Type_mat4: return 4;
+		default: return 1;
+	}
+}
+
+static u32 get_component_size(GLenum type) {
+	switch (type) {
+		case GL_BYTE:           return sizeof(GLbyte);
+		case GL_SHORT:          return sizeof(GLshort);
+		case GL_INT:            return sizeof(GLint);
+		case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+		case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+		case GL_UNSIGNED_INT:   return sizeof(GLuint);
+		case GL_FLOAT:          return sizeof(GLfloat);
+		case GL_DOUBLE:         return sizeof(GLdouble);
+	}
+	ENGINE_DEBUG_BREAK();
+	return 0;
+}
+
 static GLenum get_texture_data_type(enum Texture_Type texture_type, enum Data_Type data_type) {
 	switch (texture_type) {
 		case Texture_Type_Color: switch (data_type) {
@@ -304,9 +781,15 @@ static GLenum get_texture_internal_format(enum Texture_Type texture_type, enum D
 	return GL_NONE;
 }
 
-static GLenum get_texture_data_format(enum Texture_Type texture_type, u8 channels) {
+static GLenum get_texture_data_format(enum Texture_Type texture_type, enum Data_Type data_type, u8 channels) {
 	switch (texture_type) {
-		case Texture_Type_Color: switch (channels) {
+		// `GL_R32UI` and the like take integer data
+		case Texture_Type_Color: if (data_type == Data_Type_u32) switch (channels) {
+			case 1: return GL_RED_INTEGER;
+			case 2: return GL_RG_INTEGER;
+			case 3: return GL_RGB_INTEGER;
+			case 4: return GL_RGBA_INTEGER;
+		} else switch (channels) {
 			case 1: return GL_RED;
 			case 2: return GL_RG;
 			case 3: return GL_RGB;
@@ -321,16 +804,26 @@ static GLenum get_texture_data_format(enum Texture_Type texture_type, u8 channel
 	return GL_NONE;
 }
 
-// static GLenum get_attachment_format(enum Texture_Type texture_type, u8 index) {
-// 	switch (texture_type) {
-// 		case Texture_Type_Color:    return GL_COLOR_ATTACHMENT0 + index;
-// 		case Texture_Type_Depth:    return GL_DEPTH_ATTACHMENT;
-// 		case Texture_Type_DStencil: return GL_DEPTH_STENCIL_ATTACHMENT;
-// 		case Texture_Type_Stencil:  return GL_STENCIL_ATTACHMENT;
-// 	}
-// 	ENGINE_DEBUG_BREAK();
-// 	return GL_NONE;
-// }
+static u32 get_texture_texel_size(enum Texture_Type texture_type, enum Data_Type data_type, u8 channels) {
+	GLenum const type = get_texture_data_type(texture_type, data_type);
+	switch (type) {
+		case GL_NONE: return 0;
+		case GL_UNSIGNED_INT_24_8: return 4;
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: return 8;
+	}
+	return (texture_type == Texture_Type_Color) ? channels * get_component_size(type) : get_component_size(type);
+}
+
+static GLenum get_attachment_format(enum Texture_Type texture_type, u8 index) {
+	switch (texture_type) {
+		case Texture_Type_Color:    return GL_COLOR_ATTACHMENT0 + index;
+		case Texture_Type_Depth:    return GL_DEPTH_ATTACHMENT;
+		case Texture_Type_DStencil: return GL_DEPTH_STENCIL_ATTACHMENT;
+		case Texture_Type_Stencil:  return GL_STENCIL_ATTACHMENT;
+	}
+	ENGINE_DEBUG_BREAK();
+	return GL_NONE;
+}
 
 static GLenum get_mesh_usage(enum Mesh_Frequency frequency, enum Mesh_Access access) {
 	switch (frequency) {
@@ -354,300 +847,2235 @@ static GLenum get_mesh_usage(enum Mesh_Frequency frequency, enum Mesh_Access acc
 	return GL_NONE;
 }
 
-// Common
-static void impl_Common_Set_Clip_45(u8 const * buffer) {
-	GET_VALUE(bool, lower_left)
-	GET_VALUE(bool, zero_one)
-	glClipControl(
-		lower_left ? GL_LOWER_LEFT : GL_UPPER_LEFT,
-		zero_one ? GL_ZERO_TO_ONE : GL_NEGATIVE_ONE_TO_ONE
-	);
+// state
+static void impl_reset_state(struct VM_State * state) {
+	// the defaults of a fresh context
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	*state = (struct VM_State){
+		.clip_origin = GL_LOWER_LEFT, .clip_depth = GL_NEGATIVE_ONE_TO_ONE,
+		.viewport_pos = SVEC2(viewport[0], viewport[1]), .viewport_size = SVEC2(viewport[2], viewport[3]),
+		//
+		.color_write = RVM_Color_Write_All,
+		.blend_src = GL_ONE, .blend_dst = GL_ZERO,
+		//
+		.depth_write = true,
+		.depth_clear = 1,
+		.depth_func = GL_LESS,
+		.depth_range = VEC2(0, 1),
+		//
+		.stencil_write = ~(GLuint)0,
+		.stencil_func = GL_ALWAYS, .stencil_mask = ~(GLuint)0,
+		.stencil_fail = GL_KEEP, .stencil_depth_fail = GL_KEEP, .stencil_depth_pass = GL_KEEP,
+		//
+		.cull_mode = GL_BACK, .front_face = GL_CCW,
+		//
+		.active_unit = 0,
+	};
 }
-static void impl_Common_Set_Clip(u8 const * buffer) {
-	if (rvm->version >= OGL_VERSION(4, 5)) {
-		impl_Common_Set_Clip_45(buffer); return;
-	}
-	printf("[wrn] no clip control");
+
+static bool impl_state_changed(bool changed) {
+	if (changed) { rvm->stats.calls_issued++; }
+	else { rvm->stats.calls_skipped++; }
+	return changed;
 }
 
-static void impl_Common_Set_Viewport(u8 const * buffer) {
-	GET_VALUE(svec2, pos)
-	GET_VALUE(svec2, size)
-	glViewport(pos.x, pos.y, size.x, size.y);
+static void impl_resources_init(void) {
+	rvm->shaders     = engine_ref_pool_create(sizeof(struct VM_Shader));
+	rvm->reflections = engine_ref_pool_create(sizeof(struct VM_Shader_Reflection));
+	rvm->meshes      = engine_ref_pool_create(sizeof(struct VM_Mesh));
+	rvm->textures    = engine_ref_pool_create(sizeof(struct VM_Texture));
+	rvm->pipelines   = engine_ref_pool_create(sizeof(struct VM_Pipeline));
+	rvm->bundles     = engine_ref_pool_create(sizeof(struct VM_Bundle));
+	rvm->targets     = engine_ref_pool_create(sizeof(struct VM_Target));
+	rvm->samplers    = engine_ref_pool_create(sizeof(struct VM_Sampler));
 }
 
-// Color
-static void impl_Color_Set_Write(u8 const * buffer) {
-	GET_VALUE(enum RVM_Color_Write, value)
-	glColorMask(
-		(value & RVM_Color_Write_R) == RVM_Color_Write_R,
-		(value & RVM_Color_Write_G) == RVM_Color_Write_G,
-		(value & RVM_Color_Write_B) == RVM_Color_Write_B,
-		(value & RVM_Color_Write_A) == RVM_Color_Write_A
-	);
+// resources; a stale ref or a double allocation is an error of the stream
+static void * impl_find(struct Ref_Pool const * pool, struct Ref ref) {
+	void * entry = engine_ref_pool_get(pool, ref);
+	if (!entry) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); }
+	return entry;
 }
 
-static void impl_Color_Set_Clear(u8 const * buffer) {
-	GET_VALUE(vec4, value)
-	glClearColor(value.x, value.y, value.z, value.w);
+static void * impl_claim(struct Ref_Pool * pool, struct Ref ref) {
+	void * entry = engine_ref_pool_claim(pool, ref);
+	if (!entry) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); }
+	return entry;
 }
 
-static void impl_Color_Set_Blend(u8 const * buffer) {
-	GET_VALUE(enum RVM_Color_Blend, value)
-	if (value == RVM_Color_Blend_Opaque) { glDisable(GL_BLEND); return; }
-	glEnable(GL_BLEND);
-	switch (value) {
-		case RVM_Color_Blend_Alpha:      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
-		case RVM_Color_Blend_Additive:   glBlendFunc(GL_SRC_ALPHA, GL_ONE);                 break;
-		case RVM_Color_Blend_Multiply:   glBlendFunc(GL_DST_COLOR, GL_ZERO);                break;
-		case RVM_Color_Blend_PMAlpha:    glBlendFunc(GL_ONE,       GL_ONE_MINUS_SRC_ALPHA); break;
-		case RVM_Color_Blend_PMAdditive: glBlendFunc(GL_ONE,       GL_ONE);                 break;
-		default: ENGINE_DEBUG_BREAK(); break;
-	}
+static void impl_set_switch(GLenum cap, bool * cached, bool value) {
+	if (!impl_state_changed(*cached != value)) { return; }
+	*cached = value;
+	if (value) { glEnable(cap); }
+	else { glDisable(cap); }
 }
 
-// Depth
-static void impl_Depth_Set_Read(u8 const * buffer) {
-	GET_VALUE(bool, value)
-	if (!value) { glDisable(GL_DEPTH_TEST); return; }
-	glEnable(GL_DEPTH_TEST);
+static void impl_bind_program(GLuint id) {
+	if (!impl_state_changed(rvm->state.program != id)) { return; }
+	rvm->state.program = id;
+	glUseProgram(id);
 }
 
-static void impl_Depth_Set_Write(u8 const * buffer) {
-	GET_VALUE(bool, value)
-	glDepthMask(value);
+static void impl_bind_vertex_array(GLuint id) {
+	if (!impl_state_changed(rvm->state.vertex_array != id)) { return; }
+	rvm->state.vertex_array = id;
+	glBindVertexArray(id);
 }
 
-static void impl_Depth_Set_Clear_41(u8 const * buffer) {
-	GET_VALUE(r32, value)
-	glClearDepthf(value);
+static void impl_set_active_unit(u32 unit) {
+	if (!impl_state_changed(rvm->state.active_unit != unit)) { return; }
+	rvm->state.active_unit = unit;
+	glActiveTexture(GL_TEXTURE0 + unit);
 }
-static void impl_Depth_Set_Clear_20(u8 const * buffer) {
-	GET_VALUE(r32, value)
-	glClearDepth((double)value);
+
+static void impl_bind_texture(u32 unit, GLuint id) {
+	if (unit >= VM_TEXTURE_UNITS) { ENGINE_DEBUG_BREAK(); return; }
+	if (!impl_state_changed(rvm->state.textures[unit] != id)) { return; }
+	rvm->state.textures[unit] = id;
+	impl_set_active_unit(unit);
+	glBindTexture(GL_TEXTURE_2D, id);
 }
-static void impl_Depth_Set_Clear(u8 const * buffer) {
-	if (rvm->version >= OGL_VERSION(4, 1)) {
-		impl_Depth_Set_Clear_41(buffer); return;
-	}
-	impl_Depth_Set_Clear_20(buffer);
+
+static void impl_bind_sampler(u32 unit, GLuint id) {
+	if (!impl_state_changed(rvm->state.samplers[unit] != id)) { return; }
+	rvm->state.samplers[unit] = id;
+	glBindSampler(unit, id);
 }
 
-static void impl_Depth_Set_Comparison(u8 const * buffer) {
-	GET_VALUE(enum RVM_Comparison, value)
-	glDepthFunc(get_comparison(value));
+static void impl_bind_framebuffer(GLuint id) {
+	if (!impl_state_changed(rvm->state.framebuffer != id)) { return; }
+	rvm->state.framebuffer = id;
+	glBindFramebuffer(GL_FRAMEBUFFER, id);
 }
 
-static void impl_Depth_Set_Range_41(u8 const * buffer) {
-	GET_VALUE(vec2, value)
-	glDepthRangef(value.x, value.y);
+// stream
+static void impl_stream_init(struct VM_Stream * stream, GLenum target, size_t size) {
+	stream->target = target;
+	stream->size = size;
+	glGenBuffers(1, &stream->buffer);
+	glBindBuffer(stream->target, stream->buffer);
+	if (rvm->version >= OGL_VERSION(4, 4)) {
+		// should the persistent map fail, writes map their ranges one by one
+		GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(stream->target, (GLsizeiptr)stream->size, NULL, flags);
+		stream->mapped = glMapBufferRange(stream->target, 0, (GLsizeiptr)stream->size, flags);
+	}
+	else {
+		glBufferData(stream->target, (GLsizeiptr)stream->size, NULL, GL_STREAM_DRAW);
+	}
+	impl_stream_unbind(stream);
 }
-static void impl_Depth_Set_Range_20(u8 const * buffer) {
-	GET_VALUE(vec2, value)
-	glDepthRange((double)value.x, (double)value.y);
+
+// a pixel unpack buffer left bound turns the null data of texture storage calls into offsets into it
+// - so the uploads ring is bound only around its own calls
+static void impl_stream_unbind(struct VM_Stream const * stream) {
+	if (stream->target == GL_PIXEL_UNPACK_BUFFER) { glBindBuffer(stream->target, 0); }
 }
-static void impl_Depth_Set_Range(u8 const * buffer) {
-	if (rvm->version >= OGL_VERSION(4, 1)) {
-		impl_Depth_Set_Range_41(buffer); return;
+
+static void impl_stream_free(struct VM_Stream * stream) {
+	for (u32 i = 0; i < stream->fences_count; ++i) {
+		glDeleteSync(stream->fences[(stream->fences_first + i) % VM_STREAM_FRAMES]);
+	}
+	if (stream->mapped) {
+		glBindBuffer(stream->target, stream->buffer);
+		glUnmapBuffer(stream->target);
+		impl_stream_unbind(stream);
 	}
-	impl_Depth_Set_Range_20(buffer);
+	glDeleteBuffers(1, &stream->buffer);
+	*stream = (struct VM_Stream){.buffer = 0};
 }
 
-// Stencil
-static void impl_Stencil_Set_Read(u8 const * buffer) {
-	GET_VALUE(bool, value)
-	if (!value) { glDisable(GL_STENCIL_TEST); return; }
-	glEnable(GL_STENCIL_TEST);
+static void impl_stream_retire(struct VM_Stream * stream) {
+	u32 const index = stream->fences_first % VM_STREAM_FRAMES;
+	if (glClientWaitSync(stream->fences[index], 0, 0) == GL_TIMEOUT_EXPIRED) {
+		rvm->stats.stalls++;
+		if (glClientWaitSync(stream->fences[index], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+			printf("[wrn] stream fence timed out\n");
+		}
+	}
+	glDeleteSync(stream->fences[index]);
+
+	stream->used -= stream->sizes[index];
+	stream->fences_first++; stream->fences_count--;
+	if (!stream->used) { stream->head = 0; }
 }
 
-static void impl_Stencil_Set_Write(u8 const * buffer) {
-	GET_VALUE(u8, value)
-	glStencilMask(value);
+static void impl_stream_fence(struct VM_Stream * stream) {
+	if (!stream->frame_size) { return; }
+	if (rvm->version < OGL_VERSION(3, 2)) { stream->frame_size = 0; return; }
+
+	if (stream->fences_count == VM_STREAM_FRAMES) { impl_stream_retire(stream); }
+	u32 const index = (stream->fences_first + stream->fences_count) % VM_STREAM_FRAMES;
+	stream->fences[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	stream->sizes[index] = stream->frame_size;
+	stream->fences_count++;
+	stream->frame_size = 0;
 }
 
-static void impl_Stencil_Set_Clear(u8 const * buffer) {
-	GET_VALUE(u8, value)
-	glClearStencil(value);
+// returns an offset into the stream buffer, valid until the frame ends; `SIZE_MAX` if the data is too large
+// or if the frame alone has filled the ring, its earlier data may still be drawn
+static size_t impl_stream_write(struct VM_Stream * stream, void const * data, size_t size, size_t alignment) {
+	if (size > stream->size / VM_STREAM_FRAMES) { return SIZE_MAX; }
+
+	size_t position, padding;
+	for (;;) {
+		position = (stream->head + alignment - 1) / alignment * alignment;
+		if (position + size > stream->size) { position = 0; }
+		padding = (position >= stream->head ? position : stream->size) - stream->head;
+		if (stream->used + padding + size <= stream->size) { break; }
+
+		// without fences the storage is orphaned, the driver keeps the old one alive for the GPU
+		if (rvm->version < OGL_VERSION(3, 2)) {
+			if (stream->frame_size) { return SIZE_MAX; }
+			glBindBuffer(stream->target, stream->buffer);
+			glBufferData(stream->target, (GLsizeiptr)stream->size, NULL, GL_STREAM_DRAW);
+			impl_stream_unbind(stream);
+			stream->head = 0; stream->used = 0;
+			continue;
+		}
+		if (!stream->fences_count) { return SIZE_MAX; }
+		impl_stream_retire(stream);
+	}
+
+	stream->head = position + size;
+	stream->used += padding + size;
+	stream->frame_size += padding + size;
+	rvm->stats.bytes_streamed += size;
+	if (!data || !size) { return position; }
+
+	if (stream->mapped) {
+		memcpy(stream->mapped + position, data, size);
+		return position;
+	}
+
+	glBindBuffer(stream->target, stream->buffer);
+	if (rvm->version >= OGL_VERSION(3, 2)) {
+		GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+		void * target = glMapBufferRange(stream->target, (GLintptr)position, (GLsizeiptr)size, flags);
+		if (target) { memcpy(target, data, size); glUnmapBuffer(stream->target); }
+	}
+	else {
+		glBufferSubData(stream->target, (GLintptr)position, (GLsizeiptr)size, data);
+	}
+	impl_stream_unbind(stream);
+	return position;
 }
 
-static void impl_Stencil_Set_Comparison(u8 const * buffer) {
-	GET_VALUE(enum RVM_Comparison, comparison)
-	GET_VALUE(u8, reference)
-	GET_VALUE(u8, mask)
-	glStencilFunc(get_comparison(comparison), reference, mask);
+// retirement
+static struct VM_Retire_Share * impl_retire_current(void) {
+	struct VM_Retire * retire = &rvm->retire;
+	return retire->shares + (retire->first + retire->count) % (VM_RETIRE_FRAMES + 1);
 }
 
-static void impl_Stencil_Set_Operation(u8 const * buffer) {
-	GET_VALUE(enum RVM_Operation, stencil_fail__depth_any)
-	GET_VALUE(enum RVM_Operation, stencil_success__depth_fail)
-	GET_VALUE(enum RVM_Operation, stencil_success__depth_success)
-	glStencilOp(
-		get_operation(stencil_fail__depth_any),
-		get_operation(stencil_success__depth_fail),
-		get_operation(stencil_success__depth_success)
-	);
+static void impl_retire(enum VM_Retire_Kind kind, GLuint id) {
+	if (!id) { return; }
+	struct VM_Retire_List * list = impl_retire_current()->lists + kind;
+	if (list->count == list->capacity) {
+		u32 capacity = list->capacity ? list->capacity * 2 : 16;
+		GLuint * ids = ENGINE_REALLOC(list->ids, capacity * sizeof(*ids));
+		if (!ids) { ENGINE_DEBUG_BREAK(); return; }
+		list->ids = ids;
+		list->capacity = capacity;
+	}
+	list->ids[list->count++] = id;
 }
 
-// Vertex
-static void impl_Face_Set_Cull(u8 const * buffer) {
-	GET_VALUE(enum RVM_Face_Cull, value)
-	if (value == RVM_Face_Cull_None) { glDisable(GL_CULL_FACE); return; }
-	glEnable(GL_CULL_FACE);
-	glCullFace(get_face_cull(value));
+static void impl_retire_delete(struct VM_Retire_Share * share) {
+	struct VM_Retire_List * programs = share->lists + VM_Retire_Program;
+	for (u32 i = 0; i < programs->count; ++i) { glDeleteProgram(programs->ids[i]); }
+
+	struct VM_Retire_List * vertex_arrays = share->lists + VM_Retire_Vertex_Array;
+	if (vertex_arrays->count) { glDeleteVertexArrays((GLsizei)vertex_arrays->count, vertex_arrays->ids); }
+
+	struct VM_Retire_List * buffers = share->lists + VM_Retire_Buffer;
+	if (buffers->count) { glDeleteBuffers((GLsizei)buffers->count, buffers->ids); }
+
+	struct VM_Retire_List * textures = share->lists + VM_Retire_Texture;
+	if (textures->count) { glDeleteTextures((GLsizei)textures->count, textures->ids); }
+
+	struct VM_Retire_List * renderbuffers = share->lists + VM_Retire_Renderbuffer;
+	if (renderbuffers->count) { glDeleteRenderbuffers((GLsizei)renderbuffers->count, renderbuffers->ids); }
+
+	struct VM_Retire_List * framebuffers = share->lists + VM_Retire_Framebuffer;
+	if (framebuffers->count) { glDeleteFramebuffers((GLsizei)framebuffers->count, framebuffers->ids); }
+
+	struct VM_Retire_List * samplers = share->lists + VM_Retire_Sampler;
+	if (samplers->count) { glDeleteSamplers((GLsizei)samplers->count, samplers->ids); }
+
+	// the lists keep their capacity for the next frames
+	for (u32 i = 0; i < VM_Retire_Count; ++i) { share->lists[i].count = 0; }
+	if (share->fence) { glDeleteSync(share->fence); share->fence = NULL; }
 }
 
-static void impl_Face_Set_Front(u8 const * buffer) {
-	GET_VALUE(enum RVM_Face_Front, value)
-	glCullFace(get_face_front(value));
+static bool impl_retire_ready(struct VM_Retire_Share const * share, bool wait) {
+	if (!share->fence) { return wait || rvm->frame - share->frame >= VM_RETIRE_FRAMES; }
+	if (glClientWaitSync(share->fence, 0, 0) != GL_TIMEOUT_EXPIRED) { return true; }
+	if (!wait) { return false; }
+
+	rvm->stats.stalls++;
+	if (glClientWaitSync(share->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+		printf("[wrn] retirement fence timed out\n");
+	}
+	return true;
 }
 
-// Shader
-static void impl_Shader_Allocate(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+static void impl_retire_drain(bool wait_oldest) {
+	struct VM_Retire * retire = &rvm->retire;
+	while (retire->count) {
+		struct VM_Retire_Share * share = retire->shares + retire->first;
+		if (!impl_retire_ready(share, wait_oldest)) { break; }
+		impl_retire_delete(share);
+		retire->first = (retire->first + 1) % (VM_RETIRE_FRAMES + 1);
+		retire->count--;
+		wait_oldest = false;
+	}
+}
 
-	if (ref.id == REF_EMPTY_ID) { return; }
-	if (ref.id >= rvm->shaders_capacity) {
-		size_t capacity = ref.id + 1;
-		struct VM_Shader * shaders = ENGINE_REALLOC(rvm->shaders, capacity * sizeof(*shaders));
+static void impl_retire_fence(void) {
+	struct VM_Retire * retire = &rvm->retire;
+	struct VM_Retire_Share * share = impl_retire_current();
+
+	bool empty = true;
+	for (u32 i = 0; i < VM_Retire_Count; ++i) { empty = empty && !share->lists[i].count; }
+	if (!empty) {
+		if (retire->count == VM_RETIRE_FRAMES) { impl_retire_drain(true); }
+		share->fence = (rvm->version >= OGL_VERSION(3, 2)) ? glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : NULL;
+		share->frame = rvm->frame;
+		retire->count++;
+	}
 
-		if (!shaders) { ENGINE_DEBUG_BREAK(); return; }
-		memset(shaders + rvm->shaders_capacity, 0, (capacity - rvm->shaders_capacity) * sizeof(*shaders));
+	impl_retire_drain(false);
+}
 
-		rvm->shaders = shaders;
-		rvm->shaders_capacity = capacity;
+static void impl_retire_free(void) {
+	// the context goes away with everything, nothing is waited for
+	struct VM_Retire * retire = &rvm->retire;
+	for (u32 i = 0; i <= retire->count; ++i) {
+		impl_retire_delete(retire->shares + (retire->first + i) % (VM_RETIRE_FRAMES + 1));
+	}
+	for (u32 i = 0; i < VM_RETIRE_FRAMES + 1; ++i) {
+		for (u32 kind = 0; kind < VM_Retire_Count; ++kind) {
+			ENGINE_FREE(retire->shares[i].lists[kind].ids);
+		}
 	}
+	*retire = (struct VM_Retire){.first = 0};
+}
 
-	struct VM_Shader * shader = rvm->shaders + ref.id;
-	if (shader->id) { return; }
+// samplers
+static bool impl_sampler_valid(struct RVM_Sampler const * value) {
+	return (u32)value->filter_mipmap <= Filter_Type_Linear
+	    && (u32)value->filter_min    <= Filter_Type_Linear
+	    && (u32)value->filter_max    <= Filter_Type_Linear
+	    && (u32)value->wrap_x        <= Wrap_Type_MRepeat
+	    && (u32)value->wrap_y        <= Wrap_Type_MRepeat;
+}
 
-	shader->id = glCreateProgram();
+// the entry of equal settings, with a user taken; UINT32_MAX for invalid ones
+static u32 impl_sampler_acquire(struct RVM_Sampler const * value) {
+	if (!impl_sampler_valid(value)) { return UINT32_MAX; }
+
+	// past the limit, and below two, the anisotropy makes no difference
+	struct RVM_Sampler key = *value;
+	if (key.anisotropy > (u32)rvm->max_anisotropy) { key.anisotropy = (u32)rvm->max_anisotropy; }
+	if (key.anisotropy < 2) { key.anisotropy = 0; }
+
+	u32 const bits = (u32)key.filter_mipmap
+	               | ((u32)key.filter_min << 2) | ((u32)key.filter_max << 4)
+	               | ((u32)key.wrap_x << 6) | ((u32)key.wrap_y << 8)
+	               | (key.anisotropy << 10);
+
+	u32 free_state = rvm->sampler_states_count;
+	for (u32 i = 0; i < rvm->sampler_states_count; ++i) {
+		struct VM_Sampler_State * state = rvm->sampler_states + i;
+		if (!state->users) { if (free_state == rvm->sampler_states_count) { free_state = i; } continue; }
+		if (state->bits == bits) { state->users++; return i; }
+	}
+
+	if (free_state == rvm->sampler_states_capacity) {
+		u32 const capacity = rvm->sampler_states_capacity ? rvm->sampler_states_capacity * 2 : 16;
+		struct VM_Sampler_State * states = ENGINE_REALLOC(rvm->sampler_states, capacity * sizeof(*states));
+		if (!states) { ENGINE_DEBUG_BREAK(); return UINT32_MAX; }
+		rvm->sampler_states = states;
+		rvm->sampler_states_capacity = capacity;
+	}
+	if (free_state == rvm->sampler_states_count) { rvm->sampler_states_count++; }
+
+	rvm->sampler_states[free_state] = (struct VM_Sampler_State){
+		.bits = bits, .users = 1,
+		.value = key,
+	};
+	return free_state;
 }
 
-static void impl_Shader_Free(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+static void impl_sampler_release(u32 state) {
+	if (state == UINT32_MAX) { return; }
+	struct VM_Sampler_State * entry = rvm->sampler_states + state;
+	if (--entry->users) { return; }
 
-	if (ref.id == REF_EMPTY_ID) { return; }
-	if (ref.id >= rvm->shaders_capacity) { return; }
+	// deleting a sampler unbinds it, the cache follows
+	for (u32 unit = 0; entry->id && unit < VM_TEXTURE_UNITS; ++unit) {
+		if (rvm->state.samplers[unit] == entry->id) { impl_bind_sampler(unit, 0); }
+	}
+	impl_retire(VM_Retire_Sampler, entry->id);
+	entry->id = 0;
+}
+
+// made on the first bind, settings only textures carry cost no object
+static GLuint impl_sampler_object(u32 state) {
+	struct VM_Sampler_State * entry = rvm->sampler_states + state;
+	if (entry->id) { return entry->id; }
+
+	struct RVM_Sampler const * value = &entry->value;
+	glGenSamplers(1, &entry->id);
+	glSamplerParameteri(entry->id, GL_TEXTURE_MIN_FILTER, (GLint)get_filter_min(value->filter_mipmap, value->filter_min));
+	glSamplerParameteri(entry->id, GL_TEXTURE_MAG_FILTER, (GLint)get_filter_max(value->filter_max));
+	glSamplerParameteri(entry->id, GL_TEXTURE_WRAP_S, (GLint)get_wrap_type(value->wrap_x));
+	glSamplerParameteri(entry->id, GL_TEXTURE_WRAP_T, (GLint)get_wrap_type(value->wrap_y));
+	if (value->anisotropy) { glSamplerParameteri(entry->id, GL_TEXTURE_MAX_ANISOTROPY, (GLint)value->anisotropy); }
+	return entry->id;
+}
+
+// of the texture bound to the active unit
+static void impl_texture_parameters(struct RVM_Sampler const * value) {
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)get_filter_min(value->filter_mipmap, value->filter_min));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)get_filter_max(value->filter_max));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)get_wrap_type(value->wrap_x));
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)get_wrap_type(value->wrap_y));
+}
 
-	struct VM_Shader * shader = rvm->shaders + ref.id;
+// the unit's own settings, or the ones of its texture; UINT32_MAX for neither
+static u32 impl_unit_sampler(u32 unit, struct VM_Texture const * texture) {
+	struct VM_Sampler const * sampler = engine_ref_pool_get(rvm->samplers, rvm->units[unit].sampler);
+	if (sampler) { return sampler->state; }
+	return texture ? texture->sampler : UINT32_MAX;
+}
 
-	if (ref.id == rvm->shader) { glUseProgram(0); rvm->shader = REF_EMPTY_ID; }
-	glDeleteProgram(shader->id);
+static void impl_free_samplers(void) {
+	for (u32 i = 0; i < rvm->sampler_states_count; ++i) {
+		GLuint const id = rvm->sampler_states[i].id;
+		if (id) { glDeleteSamplers(1, &id); }
+	}
+}
 
-	*shader = (struct VM_Shader){.id = 0};
+// textures
+static bool impl_texture_valid(struct Asset_Texture const * asset) {
+	if ((u32)asset->kind > Texture_Type_DStencil) { return false; }
+	if (asset->size.x <= 0 || asset->size.y <= 0) { return false; }
+	if (get_texture_internal_format(asset->kind, asset->type, asset->channels) == GL_NONE) { return false; }
+	size_t const texel_size = get_texture_texel_size(asset->kind, asset->type, asset->channels);
+	if (!texel_size) { return false; }
+	return !asset->data || asset->length / texel_size / (size_t)asset->size.x >= (size_t)asset->size.y;
 }
 
-static void impl_Shader_Load(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// uploads the bands the frame's budget and the ring allow into the texture bound to the active unit; true once done
+// - a frame with its budget untouched takes a row at least, however large
+// - a band too large for the ring goes from client memory, the way a plain upload would
+static bool impl_texture_upload(struct VM_Upload * upload) {
+	size_t const band_limit = rvm->uploads.size / VM_STREAM_FRAMES;
+	bool bound = false;
+	while (upload->row < upload->rows) {
+		size_t rows = rvm->upload_budget / upload->row_size;
+		if (!rows && rvm->upload_budget == VM_UPLOAD_BUDGET) { rows = 1; }
+		if (!rows) { break; }
+
+		size_t const band_rows = band_limit / upload->row_size;
+		if (band_rows && rows > band_rows) { rows = band_rows; }
+		if (rows > upload->rows - upload->row) { rows = upload->rows - upload->row; }
+
+		// the ring is full for the frame, the rest waits for the next one
+		size_t const size = rows * upload->row_size;
+		size_t const offset = impl_stream_write(&rvm->uploads, upload->data, size, VM_STREAM_ALIGNMENT);
+		if (offset == SIZE_MAX && upload->row_size <= band_limit) { break; }
+
+		GLuint const buffer = (offset != SIZE_MAX) ? rvm->uploads.buffer : 0;
+		if (buffer || bound) { glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer); bound = buffer != 0; }
+		glTexSubImage2D(
+			GL_TEXTURE_2D, 0,
+			0, (GLint)upload->row, upload->width, (GLsizei)rows,
+			upload->format, upload->type,
+			(offset != SIZE_MAX) ? (void const *)offset : upload->data
+		);
+
+		upload->row += (u32)rows;
+		upload->data += size;
+		rvm->upload_budget -= (size < rvm->upload_budget) ? size : rvm->upload_budget;
+	}
 
-	if (ref.id == REF_EMPTY_ID) { return; }
-	if (ref.id >= rvm->shaders_capacity) { return; }
+	// storage specified with a null pointer would be read from the buffer otherwise
+	if (bound) { glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); }
+	if (upload->row < upload->rows) { return false; }
+
+	if (upload->mipmaps) { glGenerateMipmap(GL_TEXTURE_2D); }
+	return true;
+}
 
-	struct VM_Shader * shader = rvm->shaders + ref.id;
-	(void)shader;
+// drops a pending upload; its slot goes last, keeping the copy for the next one
+static void impl_upload_cancel(struct Ref ref) {
+	for (u32 i = 0; i < rvm->upload_queue_count; ++i) {
+		struct Ref const texture = rvm->upload_queue[i].texture;
+		if (texture.id != ref.id || texture.gen != ref.gen) { continue; }
+
+		struct VM_Upload const slot = rvm->upload_queue[i];
+		memmove(rvm->upload_queue + i, rvm->upload_queue + i + 1, (rvm->upload_queue_count - i - 1) * sizeof(slot));
+		rvm->upload_queue[--rvm->upload_queue_count] = slot;
+		return;
+	}
 }
 
-static void impl_Shader_Use(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// copies the rows left aside, for `impl_uploads_pump` to take over
+static void impl_upload_defer(struct VM_Upload const * upload) {
+	if (rvm->upload_queue_count == rvm->upload_queue_capacity) {
+		u32 const capacity = rvm->upload_queue_capacity ? rvm->upload_queue_capacity * 2 : 8;
+		struct VM_Upload * queue = ENGINE_REALLOC(rvm->upload_queue, capacity * sizeof(*queue));
+		if (!queue) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+		memset(queue + rvm->upload_queue_capacity, 0, (capacity - rvm->upload_queue_capacity) * sizeof(*queue));
+		rvm->upload_queue = queue;
+		rvm->upload_queue_capacity = capacity;
+	}
 
-	if (ref.id == REF_EMPTY_ID) { glUseProgram(0); return; }
-	if (ref.id >= rvm->shaders_capacity) { glUseProgram(0); return; }
+	struct VM_Upload * slot = rvm->upload_queue + rvm->upload_queue_count;
+	size_t const size = (upload->rows - upload->row) * upload->row_size;
+	if (slot->capacity < size) {
+		u8 * copy = ENGINE_REALLOC(slot->copy, size);
+		if (!copy) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+		slot->copy = copy;
+		slot->capacity = size;
+	}
+	memcpy(slot->copy, upload->data, size);
 
-	struct VM_Shader const * shader = rvm->shaders + ref.id;
-	glUseProgram(shader->id);
+	u8 * const copy = slot->copy; size_t const capacity = slot->capacity;
+	*slot = *upload;
+	slot->data = copy;
+	slot->copy = copy; slot->capacity = capacity;
+	rvm->upload_queue_count++;
 }
 
-static void impl_Shader_Uniform(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// continues the pending uploads in order, with what the frame has left of its budget
+static void impl_uploads_pump(void) {
+	while (rvm->upload_queue_count && rvm->upload_budget) {
+		struct VM_Upload * upload = rvm->upload_queue;
+		struct VM_Texture const * texture = engine_ref_pool_get(rvm->textures, upload->texture);
+		if (!texture) { impl_upload_cancel(upload->texture); continue; }
+
+		u32 const unit = rvm->state.active_unit;
+		GLuint const previous = rvm->state.textures[unit];
+		impl_bind_texture(unit, texture->id);
+		bool const done = impl_texture_upload(upload);
+		impl_bind_texture(unit, previous);
+
+		if (!done) { break; }
+		impl_upload_cancel(upload->texture);
+	}
+}
 
-	if (ref.id == REF_EMPTY_ID) { return; }
-	if (ref.id >= rvm->shaders_capacity) { return; }
+static void impl_free_uploads(void) {
+	for (u32 i = 0; i < rvm->upload_queue_capacity; ++i) {
+		ENGINE_FREE(rvm->upload_queue[i].copy);
+	}
+}
+
+// specifies the storage when its size or format changes, then uploads what the budget allows and defers the rest
+static void impl_texture_load(struct Ref ref, struct VM_Texture * texture, struct Asset_Texture const * asset) {
+	GLenum const internal_format = get_texture_internal_format(asset->kind, asset->type, asset->channels);
+	GLenum const data_format = get_texture_data_format(asset->kind, asset->type, asset->channels);
+	GLenum const data_type = get_texture_data_type(asset->kind, asset->type);
+
+	impl_upload_cancel(ref);
+
+	// the unit keeps its texture, drawing doesn't rebind it
+	u32 const unit = rvm->state.active_unit;
+	GLuint const previous = rvm->state.textures[unit];
+	impl_bind_texture(unit, texture->id);
 
-	struct VM_Shader * shader = rvm->shaders + ref.id;
-	(void)shader;
+	if (texture->size.x != asset->size.x || texture->size.y != asset->size.y || texture->internal_format != internal_format) {
+		texture->size = asset->size;
+		texture->internal_format = internal_format;
+		glTexImage2D(GL_TEXTURE_2D, 0, (GLint)internal_format, asset->size.x, asset->size.y, 0, data_format, data_type, NULL);
+	}
+
+	// integer and depth formats have no filtered levels
+	bool const filterable = asset->kind == Texture_Type_Color && asset->type != Data_Type_u32;
+	struct VM_Upload upload = {
+		.texture = ref,
+		.data = asset->data,
+		.rows = asset->data ? (u32)asset->size.y : 0,
+		.row_size = (size_t)asset->size.x * get_texture_texel_size(asset->kind, asset->type, asset->channels),
+		.width = asset->size.x, .format = data_format, .type = data_type,
+		.mipmaps = filterable && asset->filter_mipmap != Filter_Type_None,
+	};
+	if (!impl_texture_upload(&upload)) { impl_upload_defer(&upload); }
+
+	impl_bind_texture(unit, previous);
 }
 
-// Mesh
-static void impl_Mesh_Allocate(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
-	
-	struct Asset_Mesh asset;
-	GLenum data_type = get_data_type(asset.type);
-	GLenum usage = get_mesh_usage(asset.frequency, asset.access);
+// targets
+static bool impl_target_desc(struct RVM_Target_Allocate const * payload, struct VM_Target_Desc * desc) {
+	memset(desc, 0, sizeof(*desc));
+	if (payload->size.x <= 0 || payload->size.y <= 0) { return false; }
+	if (payload->count == 0 || payload->count > RVM_TARGET_ATTACHMENTS) { return false; }
+	if (payload->samples > 1 && payload->samples > (u32)rvm->max_samples) { return false; }
+
+	desc->size = payload->size;
+	desc->samples = (payload->samples > 1) ? payload->samples : 0;
+	desc->count = payload->count;
+
+	u32 depth_stencil_count = 0;
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Target_Attachment const * attachment = payload->attachments + i;
+		if ((u32)attachment->kind > Texture_Type_DStencil) { return false; }
+		if (get_texture_internal_format(attachment->kind, attachment->type, attachment->channels) == GL_NONE) { return false; }
+		if (attachment->kind != Texture_Type_Color) { depth_stencil_count++; }
+
+		struct VM_Target_Format * format = desc->formats + i;
+		format->kind = attachment->kind;
+		format->type = attachment->type;
+		format->channels = attachment->channels;
+		format->sampled = attachment->texture.id != REF_EMPTY_ID;
+	}
+	return depth_stencil_count <= 1;
+}
 
-	(void)data_type;
-	(void)usage;
+static u32 impl_target_color_index(struct VM_Target_Desc const * desc, u32 attachment) {
+	u32 index = 0;
+	for (u32 i = 0; i < attachment; ++i) {
+		if (desc->formats[i].kind == Texture_Type_Color) { index++; }
+	}
+	return index;
 }
 
-static void impl_Mesh_Free(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// integer, depth and stencil values aren't filtered
+static struct RVM_Sampler impl_target_sampler(struct VM_Target_Format const * format) {
+	bool const filtered = format->kind == Texture_Type_Color && format->type != Data_Type_u32;
+	enum Filter_Type const filter = filtered ? Filter_Type_Linear : Filter_Type_None;
+	return (struct RVM_Sampler){
+		.filter_mipmap = Filter_Type_None, .filter_min = filter, .filter_max = filter,
+		.wrap_x = Wrap_Type_Clamp, .wrap_y = Wrap_Type_Clamp,
+	};
 }
 
-static void impl_Mesh_Load(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+static GLuint impl_target_texture(struct VM_Target_Format const * format, svec2 size) {
+	GLuint id;
+	glGenTextures(1, &id);
+	impl_bind_texture(rvm->state.active_unit, id);
+
+	struct RVM_Sampler const sampler = impl_target_sampler(format);
+	impl_texture_parameters(&sampler);
+	glTexImage2D(
+		GL_TEXTURE_2D, 0,
+		(GLint)get_texture_internal_format(format->kind, format->type, format->channels),
+		size.x, size.y, 0,
+		get_texture_data_format(format->kind, format->type, format->channels),
+		get_texture_data_type(format->kind, format->type),
+		NULL
+	);
+	return id;
 }
 
-static void impl_Mesh_Use(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+static bool impl_framebuffer_create(struct VM_Framebuffer * framebuffer) {
+	struct VM_Target_Desc const * desc = &framebuffer->desc;
+
+	glGenFramebuffers(1, &framebuffer->id);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->id);
+
+	GLenum colors[RVM_TARGET_ATTACHMENTS]; u32 colors_count = 0;
+	bool resolved = false;
+	for (u32 i = 0; i < desc->count; ++i) {
+		struct VM_Target_Format const * format = desc->formats + i;
+		GLenum const attachment = get_attachment_format(format->kind, (u8)colors_count);
+		if (format->kind == Texture_Type_Color) { colors[colors_count++] = attachment; }
+
+		if (format->sampled) { framebuffer->textures[i] = impl_target_texture(format, desc->size); }
+		if (format->sampled && !desc->samples) {
+			glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, framebuffer->textures[i], 0);
+			continue;
+		}
+		resolved = resolved || format->sampled;
+
+		glGenRenderbuffers(1, framebuffer->renderbuffers + i);
+		glBindRenderbuffer(GL_RENDERBUFFER, framebuffer->renderbuffers[i]);
+		glRenderbufferStorageMultisample(
+			GL_RENDERBUFFER, (GLsizei)desc->samples,
+			get_texture_internal_format(format->kind, format->type, format->channels),
+			desc->size.x, desc->size.y
+		);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, framebuffer->renderbuffers[i]);
+	}
+
+	// a depth or stencil only framebuffer draws and reads no colors
+	GLenum const none = GL_NONE;
+	glDrawBuffers(colors_count ? (GLsizei)colors_count : 1, colors_count ? colors : &none);
+	glReadBuffer(colors_count ? colors[0] : GL_NONE);
+	bool const complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+	// the textures sit at the same attachment points, a resolve picks its buffers per blit
+	if (resolved) {
+		glGenFramebuffers(1, &framebuffer->resolve);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->resolve);
+		colors_count = 0;
+		for (u32 i = 0; i < desc->count; ++i) {
+			struct VM_Target_Format const * format = desc->formats + i;
+			GLenum const attachment = get_attachment_format(format->kind, (u8)colors_count);
+			if (format->kind == Texture_Type_Color) { colors_count++; }
+			if (!format->sampled) { continue; }
+			glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, framebuffer->textures[i], 0);
+		}
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, rvm->state.framebuffer);
+	return complete;
 }
 
-// Target
-// static void impl_Target_Allocate(u8 const * buffer) { }
-// static void impl_Target_Free(u8 const * buffer) { }
-// static void impl_Target_Load(u8 const * buffer) { }
-// static void impl_Target_Use(u8 const * buffer) { }
-// static void impl_Target_Clear(u8 const * buffer) { }
+static void impl_framebuffer_delete(struct VM_Framebuffer * framebuffer) {
+	for (u32 i = 0; i < framebuffer->desc.count; ++i) {
+		GLuint const texture = framebuffer->textures[i];
+		for (u32 unit = 0; texture && unit < VM_TEXTURE_UNITS; ++unit) {
+			if (rvm->state.textures[unit] == texture) { impl_bind_texture(unit, 0); }
+		}
+		impl_retire(VM_Retire_Texture, texture);
+		impl_retire(VM_Retire_Renderbuffer, framebuffer->renderbuffers[i]);
+	}
+	impl_retire(VM_Retire_Framebuffer, framebuffer->id);
+	impl_retire(VM_Retire_Framebuffer, framebuffer->resolve);
+	memset(framebuffer, 0, sizeof(*framebuffer));
+}
 
-// Texture
-static void impl_Texture_Allocate(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// a pooled one of the same description for a transient target, a new one otherwise; UINT32_MAX if it can't be made
+// - creating framebuffers and their textures mid-frame stalls the driver, reuse skips it
+static u32 impl_framebuffer_acquire(struct VM_Target_Desc const * desc, bool transient) {
+	u32 index = UINT32_MAX;
+	for (u32 i = 0; i < rvm->framebuffers_count; ++i) {
+		struct VM_Framebuffer * framebuffer = rvm->framebuffers + i;
+		if (!framebuffer->id) { if (index == UINT32_MAX) { index = i; } continue; }
+		if (!transient || !framebuffer->transient || framebuffer->used) { continue; }
+		if (memcmp(&framebuffer->desc, desc, sizeof(*desc)) != 0) { continue; }
+
+		framebuffer->used = true;
+		framebuffer->idle_frames = 0;
+		rvm->stats.calls_skipped++;
+		return i;
+	}
 
-	struct Asset_Texture asset;
-	GLenum filter_min = get_filter_min(asset.filter_mipmap, asset.filter_min);
-	GLenum filter_max = get_filter_max(asset.filter_max);
-	GLenum wrap_x = get_wrap_type(asset.wrap_x);
-	GLenum wrap_y = get_wrap_type(asset.wrap_y);
-	GLenum texture_data_type = get_texture_data_type(asset.kind, asset.type);
-	GLenum texture_internal_format = get_texture_internal_format(asset.kind, asset.type, asset.channels);
-	GLenum texture_data_format = get_texture_data_format(asset.kind, asset.channels);
+	if (index == UINT32_MAX) {
+		if (rvm->framebuffers_count == rvm->framebuffers_capacity) {
+			u32 capacity = rvm->framebuffers_capacity ? rvm->framebuffers_capacity * 2 : 8;
+			struct VM_Framebuffer * framebuffers = ENGINE_REALLOC(rvm->framebuffers, capacity * sizeof(*framebuffers));
+			if (!framebuffers) { ENGINE_DEBUG_BREAK(); return UINT32_MAX; }
+			rvm->framebuffers = framebuffers;
+			rvm->framebuffers_capacity = capacity;
+		}
+		index = rvm->framebuffers_count++;
+	}
 
-	(void)filter_min;
-	(void)filter_max;
-	(void)wrap_x;
-	(void)wrap_y;
-	(void)texture_data_type;
-	(void)texture_internal_format;
-	(void)texture_data_format;
+	struct VM_Framebuffer * framebuffer = rvm->framebuffers + index;
+	memset(framebuffer, 0, sizeof(*framebuffer));
+	memcpy(&framebuffer->desc, desc, sizeof(*desc));
+	framebuffer->transient = transient;
+	framebuffer->used = true;
+	rvm->stats.calls_issued++;
+
+	if (!impl_framebuffer_create(framebuffer)) {
+		printf("[wrn] target is incomplete\n");
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		impl_framebuffer_delete(framebuffer);
+		return UINT32_MAX;
+	}
+	return index;
 }
 
-static void impl_Texture_Free(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// a transient framebuffer goes back to the pool as is, its contents are undefined for the next user
+static void impl_framebuffer_release(u32 index) {
+	struct VM_Framebuffer * framebuffer = rvm->framebuffers + index;
+	if (!framebuffer->transient) { impl_framebuffer_delete(framebuffer); return; }
+	framebuffer->used = false;
+	framebuffer->idle_frames = 0;
 }
 
-static void impl_Texture_Load(u8 const * buffer) {
-	GET_VALUE(struct Ref, ref)
+// the pooled ones nobody asked for in a while are deleted, the pool follows what recent frames use
+static void impl_framebuffers_age(void) {
+	for (u32 i = 0; i < rvm->framebuffers_count; ++i) {
+		struct VM_Framebuffer * framebuffer = rvm->framebuffers + i;
+		if (!framebuffer->id || !framebuffer->transient || framebuffer->used) { continue; }
+		if (++framebuffer->idle_frames >= VM_TARGET_FRAMES) { impl_framebuffer_delete(framebuffer); }
+	}
 }
 
-// Sampler
-// static void impl_Sampler_Allocate(u8 const * buffer) { }
-// static void impl_Sampler_Free(u8 const * buffer) { }
+// blits the sampled attachments of a multisampled framebuffer into its textures
+static void impl_framebuffer_resolve(struct VM_Framebuffer const * framebuffer) {
+	struct VM_Target_Desc const * desc = &framebuffer->desc;
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer->id);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer->resolve);
+
+	u32 colors_count = 0;
+	for (u32 i = 0; i < desc->count; ++i) {
+		struct VM_Target_Format const * format = desc->formats + i;
+		GLenum const attachment = get_attachment_format(format->kind, (u8)colors_count);
+		if (format->kind == Texture_Type_Color) { colors_count++; }
+		if (!format->sampled) { continue; }
+
+		// a blit writes its read buffer into every draw buffer, colors go one at a time
+		GLenum buffer = GL_NONE; GLbitfield mask = 0;
+		switch (format->kind) {
+			case Texture_Type_Color:    buffer = attachment; mask = GL_COLOR_BUFFER_BIT; break;
+			case Texture_Type_Depth:    mask = GL_DEPTH_BUFFER_BIT; break;
+			case Texture_Type_Stencil:  mask = GL_STENCIL_BUFFER_BIT; break;
+			case Texture_Type_DStencil: mask = GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT; break;
+		}
+		glReadBuffer(buffer);
+		glDrawBuffers(1, &buffer);
+		glBlitFramebuffer(
+			0, 0, desc->size.x, desc->size.y,
+			0, 0, desc->size.x, desc->size.y,
+			mask, GL_NEAREST
+		);
+	}
 
-// Unit
-static void impl_Unit_Allocate(u8 const * buffer) {
-	++buffer;
+	// both bindings are replaced with the next one, the cache only has to tell it apart
+	rvm->state.framebuffer = framebuffer->resolve;
 }
 
-static void impl_Unit_Free(u8 const * buffer) {
-	++buffer;
+// a frame may end with a multisampled target in use, its textures are sampled next frame; it stays bound
+static void impl_target_resolve_bound(void) {
+	if (rvm->target == UINT32_MAX) { return; }
+	struct VM_Framebuffer const * framebuffer = rvm->framebuffers + rvm->target;
+	if (!framebuffer->resolve) { return; }
+	impl_framebuffer_resolve(framebuffer);
+	impl_bind_framebuffer(framebuffer->id);
 }
 
-// Render
-static void impl_Render_Clear(u8 const * buffer) {
-	++buffer;
+// points the texture refs of a target at the textures of its framebuffer
+// - a pooled texture may hold the parameters a former user sampled it with
+static void impl_target_textures(struct VM_Target const * target) {
+	struct VM_Framebuffer const * framebuffer = rvm->framebuffers + target->framebuffer;
+	for (u32 i = 0; i < RVM_TARGET_ATTACHMENTS; ++i) {
+		struct VM_Texture * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (!texture) { continue; }
+		texture->id = framebuffer->textures[i];
+	}
 }
 
-static void impl_Render_Draw(u8 const * buffer) {
-	++buffer;
+static void impl_target_release_textures(struct VM_Target const * target) {
+	for (u32 i = 0; i < RVM_TARGET_ATTACHMENTS; ++i) {
+		struct VM_Texture const * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (!texture) { continue; }
+		impl_sampler_release(texture->sampler);
+		engine_ref_pool_release(rvm->textures, target->textures[i]);
+	}
 }
 
-#undef GET_VALUE
+// meshes
+static void impl_mesh_set_attributes(struct VM_Mesh const * mesh, u32 location, size_t offset, u32 divisor) {
+	size_t attribute_offset = offset;
+	for (u32 i = 0; i < mesh->attributes_count; ++i, ++location) {
+		if (location >= ASSET_MESH_ATTRIBUTES) { break; }
+		glEnableVertexAttribArray(location);
+		glVertexAttribPointer(location, mesh->attributes[i], mesh->type, GL_FALSE, (GLsizei)mesh->stride, (void const *)attribute_offset);
+		glVertexAttribDivisor(location, divisor);
+		attribute_offset += mesh->attributes[i] * get_component_size(mesh->type);
+	}
+}
+
+static void impl_mesh_load(struct VM_Mesh * mesh, struct Asset_Mesh const * asset) {
+	GLenum const type = get_data_type(asset->type);
+	GLenum const usage = get_mesh_usage(asset->frequency, asset->access);
+
+	u32 const previous_count = mesh->attributes_count;
+	u32 stride = 0, attributes_count = 0;
+	for (; attributes_count < ASSET_MESH_ATTRIBUTES && asset->attributes[attributes_count]; ++attributes_count) {
+		mesh->attributes[attributes_count] = asset->attributes[attributes_count];
+		stride += asset->attributes[attributes_count];
+	}
+	stride *= get_component_size(type);
+
+	mesh->type = type;
+	mesh->stride = stride;
+	mesh->attributes_count = attributes_count;
+	mesh->vertices_count = stride ? (u32)(asset->length / stride) : 0;
+	mesh->revision = ++rvm->meshes_revision;
+	mesh->divisor = asset->divisor;
+	mesh->location = asset->location;
+
+	mesh->transient = asset->transient;
+	mesh->frame = rvm->frame;
+
+	// transient vertices are drawn in the frame they are loaded, so they skip the buffer respecification
+	size_t const streamed = asset->transient
+		? impl_stream_write(&rvm->stream, asset->data, asset->length, VM_STREAM_ALIGNMENT)
+		: SIZE_MAX;
+	if (streamed != SIZE_MAX) {
+		mesh->data_buffer = rvm->stream.buffer;
+		mesh->data_offset = streamed;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->data_buffer);
+	}
+	else {
+		mesh->data_buffer = mesh->buffer;
+		mesh->data_offset = 0;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh->data_buffer);
+		glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)asset->length, asset->data, usage);
+	}
+
+	// instance streams are bound at draw time, per vertex ones live in their vertex array
+	if (mesh->divisor) { return; }
+
+	GLuint const vertex_array = rvm->state.vertex_array;
+	impl_bind_vertex_array(mesh->id);
+	for (u32 location = attributes_count; location < previous_count; ++location) {
+		glDisableVertexAttribArray(location);
+	}
+	impl_mesh_set_attributes(mesh, 0, mesh->data_offset, 0);
+	mesh->instances = REF_EMPTY_ID;
+	impl_bind_vertex_array(vertex_array);
+}
+
+// shaders
+static void impl_free_shader(struct VM_Shader * shader, struct VM_Shader_Reflection * reflection) {
+	for (u32 i = 0; i < VM_Block_Count; ++i) {
+		ENGINE_FREE(shader->blocks[i].data);
+	}
+	ENGINE_FREE(reflection->symbols);
+	ENGINE_FREE(reflection->names);
+}
+
+static void impl_free_shaders(void) {
+	for (u32 i = 0, count = engine_ref_pool_get_count(rvm->shaders); i < count; ++i) {
+		struct Ref const ref = engine_ref_pool_get_ref(rvm->shaders, i);
+		impl_free_shader(engine_ref_pool_get(rvm->shaders, ref), engine_ref_pool_get(rvm->reflections, ref));
+	}
+}
+
+static void impl_free_bundles(void) {
+	for (u32 i = 0, count = engine_ref_pool_get_count(rvm->bundles); i < count; ++i) {
+		struct VM_Bundle * bundle = engine_ref_pool_get(rvm->bundles, engine_ref_pool_get_ref(rvm->bundles, i));
+		ENGINE_FREE(bundle->ops);
+	}
+}
+
+// counts the recorded instructions, filling `ops` if any; UINT32_MAX for a malformed record
+static u32 impl_bundle_decode(u8 const * data, u32 length, struct VM_Bundle_Op * ops) {
+	u32 count = 0;
+	for (u32 offset = 0; offset < length; count++) {
+		if (length - offset < sizeof(struct RVM_Header)) { return UINT32_MAX; }
+		struct RVM_Header const * header = (void const *)(data + offset);
+		offset += sizeof(*header);
+
+		if (header->instruction >= RVM_Instruction_Count || impl_scopes[header->instruction] != RVM_Scope_Bundle) { return UINT32_MAX; }
+		if (header->size < impl_payload_sizes[header->instruction]) { return UINT32_MAX; }
+		if (header->size > length - offset) { return UINT32_MAX; }
+		if (header->size % RVM_ALIGNMENT) { return UINT32_MAX; }
+
+		if (ops) { ops[count] = (struct VM_Bundle_Op){.handler = rvm->handlers[header->instruction], .offset = offset, .size = header->size}; }
+		offset += header->size;
+	}
+	return count;
+}
+
+static u32 impl_hash_name(GLchar const * name, size_t length) {
+	// FNV-1a
+	u32 hash = 2166136261u;
+	for (size_t i = 0; i < length; ++i) {
+		hash = (hash ^ (u8)name[i]) * 16777619u;
+	}
+	return hash;
+}
+
+static GLuint impl_shader_compile(GLenum type, cstring section, struct Asset_Shader const * asset) {
+	// sections of a single source are told apart by the preprocessor
+	GLchar const * sources[] = {"#version 330 core\n", section, (GLchar const *)asset->data};
+	GLint const lengths[] = {-1, -1, (GLint)asset->length};
+
+	GLuint const id = glCreateShader(type);
+	glShaderSource(id, sizeof(sources) / sizeof(*sources), sources, lengths);
+	glCompileShader(id);
+
+	GLint status;
+	glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+	if (!status) {
+		GLchar log[1024]; log[0] = '\0';
+		glGetShaderInfoLog(id, sizeof(log), NULL, log);
+		printf("[wrn] can't compile %s\n%s\n", section, log);
+	}
+	return id;
+}
+
+static void impl_symbols_sort(struct VM_Shader_Symbol * symbols, u32 count) {
+	// programs declare a handful of each kind
+	for (u32 i = 1; i < count; ++i) {
+		struct VM_Shader_Symbol const symbol = symbols[i];
+		u32 j = i;
+		for (; j > 0 && symbols[j - 1].hash > symbol.hash; --j) { symbols[j] = symbols[j - 1]; }
+		symbols[j] = symbol;
+	}
+}
+
+static struct VM_Shader_Symbol const * impl_symbols_find(struct VM_Shader_Reflection const * reflection, struct VM_Shader_Symbol const * symbols, u32 count, cstring name, u32 hash) {
+	u32 low = 0, high = count;
+	while (low < high) {
+		u32 const middle = low + (high - low) / 2;
+		if (symbols[middle].hash < hash) { low = middle + 1; }
+		else { high = middle; }
+	}
+	for (; low < count && symbols[low].hash == hash; ++low) {
+		if (strcmp(reflection->names + symbols[low].name, name) == 0) { return symbols + low; }
+	}
+	return NULL;
+}
+
+static void impl_shader_reflect(GLuint program, struct VM_Shader_Reflection * reflection) {
+	GLint uniforms = 0, uniform_length = 0;
+	GLint attributes = 0, attribute_length = 0;
+	GLint blocks = 0, block_length = 0;
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniforms);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniform_length);
+	glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &attributes);
+	glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &attribute_length);
+	if (rvm->version >= OGL_VERSION(3, 1)) {
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blocks);
+		glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &block_length);
+	}
+
+	reflection->uniforms_count = reflection->attributes_count = reflection->blocks_count = 0;
+	if (uniforms < 0 || attributes < 0 || blocks < 0) { ENGINE_DEBUG_BREAK(); return; }
+
+	// the lengths count the terminators
+	size_t const count = (size_t)uniforms + (size_t)attributes + (size_t)blocks;
+	size_t const names_capacity = (size_t)uniforms * (size_t)(uniform_length + 1)
+		+ (size_t)attributes * (size_t)(attribute_length + 1)
+		+ (size_t)blocks * (size_t)(block_length + 1);
+
+	struct VM_Shader_Symbol * symbols = ENGINE_REALLOC(reflection->symbols, count * sizeof(*symbols) + 1);
+	if (!symbols) { ENGINE_DEBUG_BREAK(); return; }
+	reflection->symbols = symbols;
+
+	GLchar * names = ENGINE_REALLOC(reflection->names, names_capacity + 1);
+	if (!names) { ENGINE_DEBUG_BREAK(); return; }
+	reflection->names = names;
+
+	size_t names_size = 0;
+	for (GLint i = 0; i < uniforms; ++i) {
+		GLchar * name = names + names_size;
+		GLsizei length = 0; GLint size = 0; GLenum type = GL_NONE;
+		glGetActiveUniform(program, (GLuint)i, uniform_length + 1, &length, &size, &type, name);
+		name[length] = '\0';
+
+		// arrays go by their first element
+		if (length >= 3 && strcmp(name + length - 3, "[0]") == 0) { length -= 3; name[length] = '\0'; }
+
+		GLuint const index = (GLuint)i; GLint block = -1;
+		if (rvm->version >= OGL_VERSION(3, 1)) { glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &block); }
+
+		symbols[reflection->uniforms_count++] = (struct VM_Shader_Symbol){
+			.hash = impl_hash_name(name, (size_t)length), .name = (u32)names_size,
+			.index = index, .block = block,
+			.location = (block < 0) ? glGetUniformLocation(program, name) : -1,
+			.type = type, .size = size,
+		};
+		names_size += (size_t)length + 1;
+	}
+	symbols += reflection->uniforms_count;
+
+	for (GLint i = 0; i < attributes; ++i) {
+		GLchar * name = names + names_size;
+		GLsizei length = 0; GLint size = 0; GLenum type = GL_NONE;
+		glGetActiveAttrib(program, (GLuint)i, attribute_length + 1, &length, &size, &type, name);
+		name[length] = '\0';
+
+		symbols[reflection->attributes_count++] = (struct VM_Shader_Symbol){
+			.hash = impl_hash_name(name, (size_t)length), .name = (u32)names_size,
+			.index = (GLuint)i, .block = -1,
+			.location = glGetAttribLocation(program, name),
+			.type = type, .size = size,
+		};
+		names_size += (size_t)length + 1;
+	}
+	symbols += reflection->attributes_count;
+
+	for (GLint i = 0; i < blocks; ++i) {
+		GLchar * name = names + names_size;
+		GLsizei length = 0; GLint size = 0;
+		glGetActiveUniformBlockName(program, (GLuint)i, block_length + 1, &length, name);
+		glGetActiveUniformBlockiv(program, (GLuint)i, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+		name[length] = '\0';
+
+		symbols[reflection->blocks_count++] = (struct VM_Shader_Symbol){
+			.hash = impl_hash_name(name, (size_t)length), .name = (u32)names_size,
+			.index = (GLuint)i, .block = -1,
+			.location = -1,
+			.type = GL_UNIFORM_BUFFER, .size = size,
+		};
+		names_size += (size_t)length + 1;
+	}
+
+	impl_symbols_sort(reflection->symbols, reflection->uniforms_count);
+	impl_symbols_sort(reflection->symbols + reflection->uniforms_count, reflection->attributes_count);
+	impl_symbols_sort(reflection->symbols + reflection->uniforms_count + reflection->attributes_count, reflection->blocks_count);
+}
+
+static void impl_shader_resolve(struct VM_Shader * shader, struct VM_Shader_Reflection const * reflection) {
+	// registry IDs are resolved once per load, so uniforms and draws index the hot half directly
+	struct VM_Shader_Symbol const * uniforms = reflection->symbols;
+	struct VM_Shader_Symbol const * blocks = uniforms + reflection->uniforms_count + reflection->attributes_count;
+
+	GLint block_indices[VM_Block_Count];
+	for (u32 i = 0; i < VM_Block_Count; ++i) {
+		struct VM_Shader_Block * block = shader->blocks + i;
+		block->size = 0; block->dirty = true;
+		block_indices[i] = -1;
+
+		struct VM_Shader_Symbol const * symbol = impl_symbols_find(reflection, blocks, reflection->blocks_count, impl_block_names[i], rvm->block_hashes[i]);
+		if (!symbol) { continue; }
+
+		u8 * data = ENGINE_REALLOC(block->data, (size_t)symbol->size + 1);
+		if (!data) { ENGINE_DEBUG_BREAK(); continue; }
+		memset(data, 0, (size_t)symbol->size);
+
+		glUniformBlockBinding(shader->id, symbol->index, i);
+		block->data = data; block->size = (u32)symbol->size;
+		block_indices[i] = (GLint)symbol->index;
+	}
+
+	for (u32 i = 0; i < RVM_Uniform_Count; ++i) {
+		struct VM_Shader_Field * field = shader->uniforms + i;
+		*field = (struct VM_Shader_Field){.location = -1, .offset = -1};
+
+		struct VM_Shader_Symbol const * symbol = impl_symbols_find(reflection, uniforms, reflection->uniforms_count, impl_uniform_names[i], rvm->uniform_hashes[i]);
+		if (!symbol) { continue; }
+		if (symbol->block < 0) { field->location = symbol->location; continue; }
+
+		enum VM_Block const block = impl_uniform_blocks[i];
+		if (block == VM_Block_None || symbol->block != block_indices[block]) {
+			printf("[wrn] uniform \"%s\" is out of its block\n", impl_uniform_names[i]);
+			continue;
+		}
+
+		GLint offset = -1, array_stride = 0, matrix_stride = 0;
+		glGetActiveUniformsiv(shader->id, 1, &symbol->index, GL_UNIFORM_OFFSET, &offset);
+		glGetActiveUniformsiv(shader->id, 1, &symbol->index, GL_UNIFORM_ARRAY_STRIDE, &array_stride);
+		glGetActiveUniformsiv(shader->id, 1, &symbol->index, GL_UNIFORM_MATRIX_STRIDE, &matrix_stride);
+		field->offset = offset;
+		field->array_stride = (u16)array_stride;
+		field->matrix_stride = (u16)matrix_stride;
+	}
+}
+
+static void impl_uniform_stage(struct VM_Shader_Block * block, struct VM_Shader_Field const * field, enum Data_Type type, u32 count, u8 const * data) {
+	// std140 pads array elements and matrix columns, the stream packs them
+	u32 const columns = get_data_type_columns(type);
+	size_t const element_size = get_data_type_size(type), column_size = element_size / columns;
+	size_t const array_stride = field->array_stride > 0 ? (size_t)field->array_stride : element_size;
+	size_t const matrix_stride = field->matrix_stride > 0 ? (size_t)field->matrix_stride : column_size;
+	if (!count || !column_size) { return; }
+
+	size_t const end = (size_t)field->offset + (count - 1) * array_stride + (columns - 1) * matrix_stride + column_size;
+	if (end > block->size) { ENGINE_DEBUG_BREAK(); return; }
+
+	bool changed = false;
+	for (u32 element = 0; element < count; ++element) {
+		for (u32 column = 0; column < columns; ++column) {
+			u8 * target = block->data + (size_t)field->offset + element * array_stride + column * matrix_stride;
+			u8 const * source = data + element * element_size + column * column_size;
+			if (memcmp(target, source, column_size) == 0) { continue; }
+			memcpy(target, source, column_size);
+			changed = true;
+		}
+	}
+	if (impl_state_changed(changed)) { block->dirty = true; }
+}
+
+static void impl_uniform_upload_41(GLuint program, GLint location, enum Data_Type type, GLsizei count, void const * data) {
+	switch (type) {
+		case Data_Type_r32:  glProgramUniform1fv(program, location, count, data); return;
+		case Data_Type_vec2: glProgramUniform2fv(program, location, count, data); return;
+		case Data_Type_vec3: glProgramUniform3fv(program, location, count, data); return;
+		case Data_Type_vec4: glProgramUniform4fv(program, location, count, data); return;
+		//
+		case Data_Type_s32:     glProgramUniform1iv(program, location, count, data); return;
+		case Data_Type_unit_id: glProgramUniform1iv(program, location, count, data); return;
+		case Data_Type_svec2:   glProgramUniform2iv(program, location, count, data); return;
+		case Data_Type_svec3:   glProgramUniform3iv(program, location, count, data); return;
+		case Data_Type_svec4:   glProgramUniform4iv(program, location, count, data); return;
+		//
+		case Data_Type_u32:   glProgramUniform1uiv(program, location, count, data); return;
+		case Data_Type_uvec2: glProgramUniform2uiv(program, location, count, data); return;
+		case Data_Type_uvec3: glProgramUniform3uiv(program, location, count, data); return;
+		case Data_Type_uvec4: glProgramUniform4uiv(program, location, count, data); return;
+		//
+		case Data_Type_mat2: glProgramUniformMatrix2fv(program, location, count, GL_FALSE, data); return;
+		case Data_Type_mat3: glProgramUniformMatrix3fv(program, location, count, GL_FALSE, data); return;
+		case Data_Type_mat4: glProgramUniformMatrix4fv(program, location, count, GL_FALSE, data); return;
+		//
+		default: break;
+	}
+	ENGINE_DEBUG_BREAK();
+}
+static void impl_uniform_upload_20(GLint location, enum Data_Type type, GLsizei count, void const * data) {
+	switch (type) {
+		case Data_Type_r32:  glUniform1fv(location, count, data); return;
+		case Data_Type_vec2: glUniform2fv(location, count, data); return;
+		case Data_Type_vec3: glUniform3fv(location, count, data); return;
+		case Data_Type_vec4: glUniform4fv(location, count, data); return;
+		//
+		case Data_Type_s32:     glUniform1iv(location, count, data); return;
+		case Data_Type_unit_id: glUniform1iv(location, count, data); return;
+		case Data_Type_svec2:   glUniform2iv(location, count, data); return;
+		case Data_Type_svec3:   glUniform3iv(location, count, data); return;
+		case Data_Type_svec4:   glUniform4iv(location, count, data); return;
+		//
+		case Data_Type_u32:   glUniform1uiv(location, count, data); return;
+		case Data_Type_uvec2: glUniform2uiv(location, count, data); return;
+		case Data_Type_uvec3: glUniform3uiv(location, count, data); return;
+		case Data_Type_uvec4: glUniform4uiv(location, count, data); return;
+		//
+		case Data_Type_mat2: glUniformMatrix2fv(location, count, GL_FALSE, data); return;
+		case Data_Type_mat3: glUniformMatrix3fv(location, count, GL_FALSE, data); return;
+		case Data_Type_mat4: glUniformMatrix4fv(location, count, GL_FALSE, data); return;
+		//
+		default: break;
+	}
+	ENGINE_DEBUG_BREAK();
+}
+
+static void impl_bind_block(u32 binding, GLuint buffer, size_t offset, size_t size) {
+	struct VM_Block_Range * bound = rvm->state.blocks + binding;
+	if (!impl_state_changed(bound->buffer != buffer || bound->offset != offset || bound->size != size)) { return; }
+	*bound = (struct VM_Block_Range){.buffer = buffer, .offset = offset, .size = size};
+	glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, (GLintptr)offset, (GLsizeiptr)size);
+}
+
+static void impl_bind_blocks(void) {
+	struct VM_Shader * shader = rvm->shader;
+	if (!shader) { return; }
+	for (u32 i = 0; i < VM_Block_Count; ++i) {
+		struct VM_Shader_Block * block = shader->blocks + i;
+		if (!block->size) { continue; }
+
+		// a block is streamed once per change and frame, the draws in between share its range
+		if (block->dirty || block->frame != rvm->frame || block->offset == UINT32_MAX) {
+			size_t const offset = impl_stream_write(&rvm->stream, block->data, block->size, rvm->blocks_alignment);
+			block->offset = (offset != SIZE_MAX) ? (u32)offset : UINT32_MAX;
+			block->dirty = false; block->frame = rvm->frame;
+		}
+		if (block->offset != UINT32_MAX) {
+			impl_bind_block(i, rvm->stream.buffer, block->offset, block->size);
+			continue;
+		}
+
+		// off the stream, the block is respecified for every draw
+		if (!rvm->blocks_buffers[i]) { glGenBuffers(1, &rvm->blocks_buffers[i]); }
+		glBindBuffer(GL_UNIFORM_BUFFER, rvm->blocks_buffers[i]);
+		glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)block->size, block->data, GL_STREAM_DRAW);
+		impl_bind_block(i, rvm->blocks_buffers[i], 0, block->size);
+	}
+}
+
+// pipeline
+static u64 impl_pipeline_mask(enum VM_Pipeline_Field field) {
+	u32 const width = (u32)(impl_pipeline_shifts[field + 1] - impl_pipeline_shifts[field]);
+	return (((u64)1 << width) - 1) << impl_pipeline_shifts[field];
+}
+
+static u64 impl_pipeline_field(enum VM_Pipeline_Field field, u64 value) {
+	return (value << impl_pipeline_shifts[field]) & impl_pipeline_mask(field);
+}
+
+static u64 impl_pipeline_stencil_comparison(struct RVM_Stencil_Set_Comparison const * value) {
+	return (u64)(u32)value->comparison | ((u64)value->reference << 3) | ((u64)value->mask << 11);
+}
+
+static u64 impl_pipeline_stencil_operation(struct RVM_Stencil_Set_Operation const * value) {
+	return (u64)(u32)value->stencil_fail__depth_any
+	     | ((u64)(u32)value->stencil_success__depth_fail << 3)
+	     | ((u64)(u32)value->stencil_success__depth_success << 6);
+}
+
+static u64 impl_pipeline_pack(struct RVM_Pipeline const * value) {
+	return impl_pipeline_field(VM_Pipeline_Color_Write,        (u32)value->color_write.value)
+	     | impl_pipeline_field(VM_Pipeline_Blend,              (u32)value->blend.value)
+	     | impl_pipeline_field(VM_Pipeline_Depth_Read,         value->depth_read.value)
+	     | impl_pipeline_field(VM_Pipeline_Depth_Write,        value->depth_write.value)
+	     | impl_pipeline_field(VM_Pipeline_Depth_Comparison,   (u32)value->depth_comparison.value)
+	     | impl_pipeline_field(VM_Pipeline_Stencil_Read,       value->stencil_read.value)
+	     | impl_pipeline_field(VM_Pipeline_Stencil_Write,      value->stencil_write.value)
+	     | impl_pipeline_field(VM_Pipeline_Stencil_Comparison, impl_pipeline_stencil_comparison(&value->stencil_comparison))
+	     | impl_pipeline_field(VM_Pipeline_Stencil_Operation,  impl_pipeline_stencil_operation(&value->stencil_operation))
+	     | impl_pipeline_field(VM_Pipeline_Cull,               (u32)value->cull.value)
+	     | impl_pipeline_field(VM_Pipeline_Front,              (u32)value->front.value);
+}
+
+// the word holds any valid value as is
+static bool impl_pipeline_valid(struct RVM_Pipeline const * value) {
+	return ((u32)value->color_write.value & ~(u32)RVM_Color_Write_All) == 0
+	    && (u32)value->blend.value                                      <= RVM_Color_Blend_PMAdditive
+	    && (u32)value->depth_comparison.value                           <= RVM_Comparison_GEqual
+	    && (u32)value->stencil_comparison.comparison                    <= RVM_Comparison_GEqual
+	    && (u32)value->stencil_operation.stencil_fail__depth_any        <= RVM_Operation_Decr_Wrap
+	    && (u32)value->stencil_operation.stencil_success__depth_fail    <= RVM_Operation_Decr_Wrap
+	    && (u32)value->stencil_operation.stencil_success__depth_success <= RVM_Operation_Decr_Wrap
+	    && (u32)value->cull.value                                       <= RVM_Face_Cull_Both
+	    && (u32)value->front.value                                      <= RVM_Face_Front_CW;
+}
+
+static void impl_pipeline_track(enum VM_Pipeline_Field field, u64 value) {
+	rvm->pipeline_bits = (rvm->pipeline_bits & ~impl_pipeline_mask(field)) | impl_pipeline_field(field, value);
+}
+
+static u32 impl_pipeline_bake(struct RVM_Pipeline const * value) {
+	u64 const bits = impl_pipeline_pack(value);
+	struct Ref const shader = value->shader.ref;
+
+	u32 free_state = rvm->pipeline_states_count;
+	for (u32 i = 0; i < rvm->pipeline_states_count; ++i) {
+		struct VM_Pipeline_State const * state = rvm->pipeline_states + i;
+		if (!state->users) { if (free_state == rvm->pipeline_states_count) { free_state = i; } continue; }
+		if (state->bits == bits && state->shader.id == shader.id && state->shader.gen == shader.gen) { return i; }
+	}
+
+	if (free_state == rvm->pipeline_states_capacity) {
+		u32 const capacity = rvm->pipeline_states_capacity ? rvm->pipeline_states_capacity * 2 : 16;
+		struct VM_Pipeline_State * states = ENGINE_REALLOC(rvm->pipeline_states, capacity * sizeof(*states));
+		if (!states) { ENGINE_DEBUG_BREAK(); return UINT32_MAX; }
+		rvm->pipeline_states = states;
+		rvm->pipeline_states_capacity = capacity;
+	}
+	if (free_state == rvm->pipeline_states_count) { rvm->pipeline_states_count++; }
+
+	rvm->pipeline_states[free_state] = (struct VM_Pipeline_State){
+		.bits = bits, .shader = shader,
+		.value = *value,
+	};
+	return free_state;
+}
+
+// Common
+static void impl_Common_Set_Clip_45(struct RVM_Common_Set_Clip const * payload) {
+	GLenum const origin = payload->lower_left ? GL_LOWER_LEFT : GL_UPPER_LEFT;
+	GLenum const depth = payload->zero_one ? GL_ZERO_TO_ONE : GL_NEGATIVE_ONE_TO_ONE;
+	if (!impl_state_changed(rvm->state.clip_origin != origin || rvm->state.clip_depth != depth)) { return; }
+	rvm->state.clip_origin = origin; rvm->state.clip_depth = depth;
+	glClipControl(origin, depth);
+}
+static void impl_Common_Set_Clip(struct RVM_Common_Set_Clip const * payload) {
+	(void)payload; // no clip control, warned about at init
+}
+
+static void impl_Common_Set_Viewport(struct RVM_Common_Set_Viewport const * payload) {
+	svec2 const pos = payload->pos, size = payload->size;
+	if (!impl_state_changed(
+		rvm->state.viewport_pos.x  != pos.x  || rvm->state.viewport_pos.y  != pos.y ||
+		rvm->state.viewport_size.x != size.x || rvm->state.viewport_size.y != size.y
+	)) { return; }
+	rvm->state.viewport_pos = pos; rvm->state.viewport_size = size;
+	glViewport(pos.x, pos.y, size.x, size.y);
+}
+
+// Color
+static void impl_Color_Set_Write(struct RVM_Color_Set_Write const * payload) {
+	impl_pipeline_track(VM_Pipeline_Color_Write, (u32)payload->value);
+	if (!impl_state_changed(rvm->state.color_write != payload->value)) { return; }
+	rvm->state.color_write = payload->value;
+	glColorMask(
+		(payload->value & RVM_Color_Write_R) == RVM_Color_Write_R,
+		(payload->value & RVM_Color_Write_G) == RVM_Color_Write_G,
+		(payload->value & RVM_Color_Write_B) == RVM_Color_Write_B,
+		(payload->value & RVM_Color_Write_A) == RVM_Color_Write_A
+	);
+}
+
+static void impl_Color_Set_Clear(struct RVM_Color_Set_Clear const * payload) {
+	// floats are compared bitwise, a negative zero at worst costs a redundant call
+	vec4 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.color_clear, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.color_clear = value;
+	glClearColor(value.x, value.y, value.z, value.w);
+}
+
+static void impl_Color_Set_Blend(struct RVM_Color_Set_Blend const * payload) {
+	impl_pipeline_track(VM_Pipeline_Blend, (u32)payload->value);
+	if (payload->value == RVM_Color_Blend_Opaque) { impl_set_switch(GL_BLEND, &rvm->state.blend, false); return; }
+	impl_set_switch(GL_BLEND, &rvm->state.blend, true);
+
+	GLenum src, dst;
+	switch (payload->value) {
+		case RVM_Color_Blend_Alpha:      src = GL_SRC_ALPHA; dst = GL_ONE_MINUS_SRC_ALPHA; break;
+		case RVM_Color_Blend_Additive:   src = GL_SRC_ALPHA; dst = GL_ONE;                 break;
+		case RVM_Color_Blend_Multiply:   src = GL_DST_COLOR; dst = GL_ZERO;                break;
+		case RVM_Color_Blend_PMAlpha:    src = GL_ONE;       dst = GL_ONE_MINUS_SRC_ALPHA; break;
+		case RVM_Color_Blend_PMAdditive: src = GL_ONE;       dst = GL_ONE;                 break;
+		default: ENGINE_DEBUG_BREAK(); return;
+	}
+
+	if (!impl_state_changed(rvm->state.blend_src != src || rvm->state.blend_dst != dst)) { return; }
+	rvm->state.blend_src = src; rvm->state.blend_dst = dst;
+	glBlendFunc(src, dst);
+}
+
+// Depth
+static void impl_Depth_Set_Read(struct RVM_Depth_Set_Read const * payload) {
+	impl_pipeline_track(VM_Pipeline_Depth_Read, payload->value);
+	impl_set_switch(GL_DEPTH_TEST, &rvm->state.depth_test, payload->value);
+}
+
+static void impl_Depth_Set_Write(struct RVM_Depth_Set_Write const * payload) {
+	impl_pipeline_track(VM_Pipeline_Depth_Write, payload->value);
+	if (!impl_state_changed(rvm->state.depth_write != payload->value)) { return; }
+	rvm->state.depth_write = payload->value;
+	glDepthMask(payload->value);
+}
+
+static void impl_Depth_Set_Clear_41(struct RVM_Depth_Set_Clear const * payload) {
+	if (!impl_state_changed(memcmp(&rvm->state.depth_clear, &payload->value, sizeof(payload->value)) != 0)) { return; }
+	rvm->state.depth_clear = payload->value;
+	glClearDepthf(payload->value);
+}
+static void impl_Depth_Set_Clear(struct RVM_Depth_Set_Clear const * payload) {
+	if (!impl_state_changed(memcmp(&rvm->state.depth_clear, &payload->value, sizeof(payload->value)) != 0)) { return; }
+	rvm->state.depth_clear = payload->value;
+	glClearDepth((double)payload->value);
+}
+
+static void impl_Depth_Set_Comparison(struct RVM_Depth_Set_Comparison const * payload) {
+	impl_pipeline_track(VM_Pipeline_Depth_Comparison, (u32)payload->value);
+	GLenum const func = get_comparison(payload->value);
+	if (!impl_state_changed(rvm->state.depth_func != func)) { return; }
+	rvm->state.depth_func = func;
+	glDepthFunc(func);
+}
+
+static void impl_Depth_Set_Range_41(struct RVM_Depth_Set_Range const * payload) {
+	vec2 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.depth_range, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.depth_range = value;
+	glDepthRangef(value.x, value.y);
+}
+static void impl_Depth_Set_Range(struct RVM_Depth_Set_Range const * payload) {
+	vec2 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.depth_range, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.depth_range = value;
+	glDepthRange((double)value.x, (double)value.y);
+}
+
+// Stencil
+static void impl_Stencil_Set_Read(struct RVM_Stencil_Set_Read const * payload) {
+	impl_pipeline_track(VM_Pipeline_Stencil_Read, payload->value);
+	impl_set_switch(GL_STENCIL_TEST, &rvm->state.stencil_test, payload->value);
+}
+
+static void impl_Stencil_Set_Write(struct RVM_Stencil_Set_Write const * payload) {
+	impl_pipeline_track(VM_Pipeline_Stencil_Write, payload->value);
+	if (!impl_state_changed(rvm->state.stencil_write != payload->value)) { return; }
+	rvm->state.stencil_write = payload->value;
+	glStencilMask(payload->value);
+}
+
+static void impl_Stencil_Set_Clear(struct RVM_Stencil_Set_Clear const * payload) {
+	if (!impl_state_changed(rvm->state.stencil_clear != payload->value)) { return; }
+	rvm->state.stencil_clear = payload->value;
+	glClearStencil(payload->value);
+}
+
+static void impl_Stencil_Set_Comparison(struct RVM_Stencil_Set_Comparison const * payload) {
+	impl_pipeline_track(VM_Pipeline_Stencil_Comparison, impl_pipeline_stencil_comparison(payload));
+	GLenum const func = get_comparison(payload->comparison);
+	if (!impl_state_changed(
+		rvm->state.stencil_func != func ||
+		rvm->state.stencil_reference != payload->reference ||
+		rvm->state.stencil_mask != payload->mask
+	)) { return; }
+	rvm->state.stencil_func = func;
+	rvm->state.stencil_reference = payload->reference;
+	rvm->state.stencil_mask = payload->mask;
+	glStencilFunc(func, payload->reference, payload->mask);
+}
+
+static void impl_Stencil_Set_Operation(struct RVM_Stencil_Set_Operation const * payload) {
+	impl_pipeline_track(VM_Pipeline_Stencil_Operation, impl_pipeline_stencil_operation(payload));
+	GLenum const fail       = get_operation(payload->stencil_fail__depth_any);
+	GLenum const depth_fail = get_operation(payload->stencil_success__depth_fail);
+	GLenum const depth_pass = get_operation(payload->stencil_success__depth_success);
+	if (!impl_state_changed(
+		rvm->state.stencil_fail != fail ||
+		rvm->state.stencil_depth_fail != depth_fail ||
+		rvm->state.stencil_depth_pass != depth_pass
+	)) { return; }
+	rvm->state.stencil_fail = fail;
+	rvm->state.stencil_depth_fail = depth_fail;
+	rvm->state.stencil_depth_pass = depth_pass;
+	glStencilOp(fail, depth_fail, depth_pass);
+}
+
+// Vertex
+static void impl_Face_Set_Cull(struct RVM_Face_Set_Cull const * payload) {
+	impl_pipeline_track(VM_Pipeline_Cull, (u32)payload->value);
+	if (payload->value == RVM_Face_Cull_None) { impl_set_switch(GL_CULL_FACE, &rvm->state.cull_face, false); return; }
+	impl_set_switch(GL_CULL_FACE, &rvm->state.cull_face, true);
+
+	GLenum const mode = get_face_cull(payload->value);
+	if (!impl_state_changed(rvm->state.cull_mode != mode)) { return; }
+	rvm->state.cull_mode = mode;
+	glCullFace(mode);
+}
+
+static void impl_Face_Set_Front(struct RVM_Face_Set_Front const * payload) {
+	impl_pipeline_track(VM_Pipeline_Front, (u32)payload->value);
+	GLenum const mode = get_face_front(payload->value);
+	if (!impl_state_changed(rvm->state.front_face != mode)) { return; }
+	rvm->state.front_face = mode;
+	glFrontFace(mode);
+}
+
+// Shader
+static void impl_Shader_Allocate(struct RVM_Shader_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Shader * shader = impl_claim(rvm->shaders, ref);
+	if (!shader) { return; }
+	if (!impl_claim(rvm->reflections, ref)) { engine_ref_pool_release(rvm->shaders, ref); return; }
+
+	shader->id = glCreateProgram();
+}
+
+static void impl_Shader_Free(struct RVM_Shader_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Shader * shader = impl_find(rvm->shaders, ref);
+	if (!shader) { return; }
+
+	if (rvm->shader == shader) { rvm->shader = NULL; }
+	if (rvm->state.program == shader->id) { impl_bind_program(0); }
+	impl_retire(VM_Retire_Program, shader->id);
+	impl_free_shader(shader, engine_ref_pool_get(rvm->reflections, ref));
+
+	engine_ref_pool_release(rvm->shaders, ref);
+	engine_ref_pool_release(rvm->reflections, ref);
+}
+
+static void impl_Shader_Load(struct RVM_Shader_Load const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Shader * shader = impl_find(rvm->shaders, ref);
+	if (!shader) { return; }
+
+	GLuint const vertex   = impl_shader_compile(GL_VERTEX_SHADER,   "#define VERTEX_SECTION\n",   &payload->asset);
+	GLuint const fragment = impl_shader_compile(GL_FRAGMENT_SHADER, "#define FRAGMENT_SECTION\n", &payload->asset);
+	glAttachShader(shader->id, vertex);
+	glAttachShader(shader->id, fragment);
+	glLinkProgram(shader->id);
+	glDetachShader(shader->id, vertex);
+	glDetachShader(shader->id, fragment);
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	GLint status;
+	glGetProgramiv(shader->id, GL_LINK_STATUS, &status);
+	if (!status) {
+		GLchar log[1024]; log[0] = '\0';
+		glGetProgramInfoLog(shader->id, sizeof(log), NULL, log);
+		printf("[wrn] can't link a shader\n%s\n", log);
+	}
+
+	struct VM_Shader_Reflection * reflection = engine_ref_pool_get(rvm->reflections, ref);
+	impl_shader_reflect(shader->id, reflection);
+	impl_shader_resolve(shader, reflection);
+}
+
+static void impl_Shader_Use(struct RVM_Shader_Use const * payload) {
+	struct Ref const ref = payload->ref;
+
+	rvm->shader = NULL;
+	if (ref.id == REF_EMPTY_ID) { impl_bind_program(0); return; }
+
+	struct VM_Shader * shader = impl_find(rvm->shaders, ref);
+	if (!shader) { impl_bind_program(0); return; }
+
+	rvm->shader = shader;
+	impl_bind_program(shader->id);
+}
+
+// stages the values of a block uniform; returns the shader of a default block one, the values to upload follow the payload
+static struct VM_Shader const * impl_uniform_prepare(struct RVM_Shader_Uniform const * payload, GLint * location) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return NULL; }
+	if (payload->uniform >= RVM_Uniform_Count) { ENGINE_DEBUG_BREAK(); return NULL; }
+
+	struct VM_Shader * shader = impl_find(rvm->shaders, ref);
+	if (!shader) { return NULL; }
+
+	// values follow the payload
+	u64 const size = (u64)get_data_type_size(payload->type) * payload->count;
+	if (size > rvm->payload_size - impl_payload_sizes[RVM_Instruction_Shader_Uniform]) { ENGINE_DEBUG_BREAK(); return NULL; }
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Shader_Uniform];
+
+	// block values are staged and uploaded at the draw, the rest go one call per instruction
+	struct VM_Shader_Field const * field = shader->uniforms + payload->uniform;
+	if (field->offset >= 0) {
+		impl_uniform_stage(shader->blocks + impl_uniform_blocks[payload->uniform], field, payload->type, payload->count, data);
+		return NULL;
+	}
+	if (field->location < 0) { return NULL; }
+
+	*location = field->location;
+	return shader;
+}
+
+static void impl_Shader_Uniform_41(struct RVM_Shader_Uniform const * payload) {
+	GLint location;
+	struct VM_Shader const * shader = impl_uniform_prepare(payload, &location);
+	if (!shader) { return; }
+
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Shader_Uniform];
+	impl_uniform_upload_41(shader->id, location, payload->type, (GLsizei)payload->count, data);
+}
+static void impl_Shader_Uniform(struct RVM_Shader_Uniform const * payload) {
+	GLint location;
+	struct VM_Shader const * shader = impl_uniform_prepare(payload, &location);
+	if (!shader) { return; }
+
+	// no direct state access, the program is bound for the upload
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Shader_Uniform];
+	GLuint const program = rvm->state.program;
+	impl_bind_program(shader->id);
+	impl_uniform_upload_20(location, payload->type, (GLsizei)payload->count, data);
+	impl_bind_program(program);
+}
+
+// Mesh
+static void impl_Mesh_Allocate(struct RVM_Mesh_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Mesh * mesh = impl_claim(rvm->meshes, ref);
+	if (!mesh) { return; }
+
+	glGenVertexArrays(1, &mesh->id);
+	glGenBuffers(1, &mesh->buffer);
+	impl_mesh_load(mesh, &payload->asset);
+}
+
+static void impl_Mesh_Free(struct RVM_Mesh_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Mesh * mesh = impl_find(rvm->meshes, ref);
+	if (!mesh) { return; }
+
+	if (rvm->mesh == mesh) { rvm->mesh = NULL; }
+	if (rvm->state.vertex_array == mesh->id) { impl_bind_vertex_array(0); }
+	impl_retire(VM_Retire_Vertex_Array, mesh->id);
+	impl_retire(VM_Retire_Buffer, mesh->buffer);
+
+	engine_ref_pool_release(rvm->meshes, ref);
+}
+
+static void impl_Mesh_Load(struct RVM_Mesh_Load const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Mesh * mesh = impl_find(rvm->meshes, ref);
+	if (!mesh) { return; }
+
+	impl_mesh_load(mesh, &payload->asset);
+}
+
+static void impl_Mesh_Use(struct RVM_Mesh_Use const * payload) {
+	struct Ref const ref = payload->ref;
+
+	rvm->mesh = NULL;
+	if (ref.id == REF_EMPTY_ID) { impl_bind_vertex_array(0); return; }
+
+	struct VM_Mesh * mesh = impl_find(rvm->meshes, ref);
+	if (!mesh) { impl_bind_vertex_array(0); return; }
+
+	rvm->mesh = mesh;
+	impl_bind_vertex_array(mesh->id);
+}
+
+// Texture
+static void impl_Texture_Allocate(struct RVM_Texture_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Texture * texture = impl_claim(rvm->textures, ref);
+	if (!texture) { return; }
+
+	struct Asset_Texture const * asset = &payload->asset;
+	if (!impl_texture_valid(asset)) {
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		engine_ref_pool_release(rvm->textures, ref);
+		return;
+	}
+
+	// its own settings, shared with the samplers and textures of equal ones
+	struct RVM_Sampler const sampler = {
+		.filter_mipmap = asset->filter_mipmap, .filter_min = asset->filter_min, .filter_max = asset->filter_max,
+		.wrap_x = asset->wrap_x, .wrap_y = asset->wrap_y,
+	};
+	texture->sampler = impl_sampler_acquire(&sampler);
+	if (texture->sampler == UINT32_MAX) {
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		engine_ref_pool_release(rvm->textures, ref);
+		return;
+	}
+
+	glGenTextures(1, &texture->id);
+	impl_texture_load(ref, texture, asset);
+}
+
+static void impl_Texture_Free(struct RVM_Texture_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Texture const * texture = impl_find(rvm->textures, ref);
+	if (!texture) { return; }
+	if (texture->attachment) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	// deleting a texture unbinds it, the cache follows
+	impl_upload_cancel(ref);
+	for (u32 unit = 0; unit < VM_TEXTURE_UNITS; ++unit) {
+		if (rvm->state.textures[unit] == texture->id) { impl_bind_texture(unit, 0); }
+	}
+	impl_retire(VM_Retire_Texture, texture->id);
+
+	impl_sampler_release(texture->sampler);
+	engine_ref_pool_release(rvm->textures, ref);
+}
+
+static void impl_Texture_Load(struct RVM_Texture_Load const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Texture * texture = impl_find(rvm->textures, ref);
+	if (!texture) { return; }
+
+	// attachments take their storage from the framebuffer
+	if (texture->attachment || !impl_texture_valid(&payload->asset)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	impl_texture_load(ref, texture, &payload->asset);
+}
+
+// Sampler
+static void impl_Sampler_Allocate(struct RVM_Sampler_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Sampler * sampler = impl_claim(rvm->samplers, ref);
+	if (!sampler) { return; }
+
+	u32 const state = impl_sampler_acquire(&payload->value);
+	if (state == UINT32_MAX) {
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		engine_ref_pool_release(rvm->samplers, ref);
+		return;
+	}
+
+	sampler->state = state;
+}
+
+static void impl_Sampler_Free(struct RVM_Sampler_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Sampler const * sampler = impl_find(rvm->samplers, ref);
+	if (!sampler) { return; }
+
+	// the units sampling with it go back to the settings of their textures
+	for (u32 unit = 0; unit < VM_TEXTURE_UNITS; ++unit) {
+		struct Ref const used = rvm->units[unit].sampler;
+		if (used.id != ref.id || used.gen != ref.gen) { continue; }
+		struct RVM_Sampler_Use const reset = {.unit = unit, .ref = {.id = REF_EMPTY_ID}};
+		impl_Sampler_Use(&reset);
+	}
+
+	impl_sampler_release(sampler->state);
+	engine_ref_pool_release(rvm->samplers, ref);
+}
+
+// keeps the unit's settings; false for a bad unit or a stale ref
+static bool impl_sampler_use(struct RVM_Sampler_Use const * payload) {
+	if (payload->unit >= VM_TEXTURE_UNITS) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return false; }
+	struct Ref const ref = payload->ref;
+	if (ref.id != REF_EMPTY_ID && !impl_find(rvm->samplers, ref)) { return false; }
+	rvm->units[payload->unit].sampler = ref;
+	return true;
+}
+
+static void impl_Sampler_Use(struct RVM_Sampler_Use const * payload) {
+	if (!impl_sampler_use(payload)) { return; }
+
+	struct VM_Texture const * texture = engine_ref_pool_get(rvm->textures, rvm->units[payload->unit].texture);
+	u32 const state = impl_unit_sampler(payload->unit, texture);
+	if (state == UINT32_MAX) { return; }
+	impl_bind_sampler(payload->unit, impl_sampler_object(state));
+}
+
+// Unit
+// binds the texture, or none for an empty or stale ref; NULL for a bad unit too
+static struct VM_Texture * impl_unit_bind(struct RVM_Unit_Allocate const * payload) {
+	if (payload->unit >= VM_TEXTURE_UNITS) { ENGINE_DEBUG_BREAK(); return NULL; }
+
+	struct Ref const ref = payload->texture;
+	struct VM_Texture * texture = (ref.id != REF_EMPTY_ID) ? impl_find(rvm->textures, ref) : NULL;
+
+	rvm->units[payload->unit].texture = texture ? ref : (struct Ref){.id = REF_EMPTY_ID};
+	impl_bind_texture(payload->unit, texture ? texture->id : 0);
+	return texture;
+}
+
+static void impl_Unit_Allocate(struct RVM_Unit_Allocate const * payload) {
+	struct VM_Texture const * texture = impl_unit_bind(payload);
+	if (!texture) { return; }
+	u32 const state = impl_unit_sampler(payload->unit, texture);
+	if (state == UINT32_MAX) { return; }
+	impl_bind_sampler(payload->unit, impl_sampler_object(state));
+}
+
+static void impl_Unit_Free(struct RVM_Unit_Free const * payload) {
+	if (payload->unit >= VM_TEXTURE_UNITS) { ENGINE_DEBUG_BREAK(); return; }
+	rvm->units[payload->unit].texture = (struct Ref){.id = REF_EMPTY_ID};
+	impl_bind_texture(payload->unit, 0);
+}
+
+// Render
+static void impl_Render_Clear(struct RVM_Render_Clear const * payload) {
+	GLbitfield mask = 0;
+	if ((payload->mask & RVM_Clear_Color)   == RVM_Clear_Color)   { mask |= GL_COLOR_BUFFER_BIT; }
+	if ((payload->mask & RVM_Clear_Depth)   == RVM_Clear_Depth)   { mask |= GL_DEPTH_BUFFER_BIT; }
+	if ((payload->mask & RVM_Clear_Stencil) == RVM_Clear_Stencil) { mask |= GL_STENCIL_BUFFER_BIT; }
+	if (mask) { glClear(mask); }
+}
+
+// the ring has moved on past a transient mesh of a former frame
+static bool impl_mesh_is_stale(struct VM_Mesh const * mesh) {
+	if (!mesh->transient || mesh->frame == rvm->frame) { return false; }
+	rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+	return true;
+}
+
+static struct VM_Mesh * impl_find_drawn_mesh(u32 offset, u32 length) {
+	struct VM_Mesh * mesh = rvm->mesh;
+	if (!mesh) { return NULL; }
+	if (impl_mesh_is_stale(mesh)) { return NULL; }
+	if (offset > mesh->vertices_count || length > mesh->vertices_count - offset) { ENGINE_DEBUG_BREAK(); return NULL; }
+	return mesh;
+}
+
+static void impl_Render_Draw(struct RVM_Render_Draw const * payload) {
+	if (!impl_find_drawn_mesh(payload->offset, payload->length)) { return; }
+	impl_bind_blocks();
+	glDrawArrays(GL_TRIANGLES, (GLint)payload->offset, (GLsizei)payload->length);
+}
+
+static void impl_attach_instances(struct VM_Mesh * mesh, struct VM_Mesh const * instances, u32 id, u32 offset) {
+	// the attachment is cached per vertex array, repeated draws of the same stream cost a single call
+	if (
+		mesh->instances == id &&
+		mesh->instances_revision == instances->revision &&
+		mesh->instances_offset == offset
+	) { return; }
+
+	mesh->instances = id;
+	mesh->instances_revision = instances->revision;
+	mesh->instances_offset = offset;
+
+	glBindBuffer(GL_ARRAY_BUFFER, instances->data_buffer);
+	impl_mesh_set_attributes(instances, instances->location, instances->data_offset + (size_t)offset * instances->stride, instances->divisor);
+}
+
+static struct VM_Mesh const * impl_find_instances(struct Ref ref, u32 offset, u32 count) {
+	struct VM_Mesh const * instances = impl_find(rvm->meshes, ref);
+	if (!instances) { return NULL; }
+	if (impl_mesh_is_stale(instances)) { return NULL; }
+	if (!instances->divisor) { printf("[wrn] an instance stream needs a divisor\n"); return NULL; }
+
+	u32 const elements = (count + instances->divisor - 1) / instances->divisor;
+	if (offset > instances->vertices_count || elements > instances->vertices_count - offset) { ENGINE_DEBUG_BREAK(); return NULL; }
+	return instances;
+}
+
+static void impl_Render_Draw_Instanced(struct RVM_Render_Draw_Instanced const * payload) {
+	struct VM_Mesh * mesh = impl_find_drawn_mesh(payload->offset, payload->length);
+	if (!mesh) { return; }
+
+	struct VM_Mesh const * instances = impl_find_instances(payload->instances, payload->instances_offset, payload->count);
+	if (!instances) { return; }
+
+	impl_bind_blocks();
+	impl_attach_instances(mesh, instances, payload->instances.id, payload->instances_offset);
+	glDrawArraysInstanced(GL_TRIANGLES, (GLint)payload->offset, (GLsizei)payload->length, (GLsizei)payload->count);
+}
+
+// checks the ranges and binds the blocks; returns the arguments, they follow the payload
+static struct RVM_Draw_Arguments const * impl_draw_indirect_prepare(struct RVM_Render_Draw_Indirect const * payload, struct VM_Mesh ** mesh) {
+	struct RVM_Draw_Arguments const * arguments = (void const *)((u8 const *)payload + impl_payload_sizes[RVM_Instruction_Render_Draw_Indirect]);
+	size_t const available = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Render_Draw_Indirect];
+	if ((u64)payload->count * sizeof(*arguments) > available) { ENGINE_DEBUG_BREAK(); return NULL; }
+	if (!payload->count) { return NULL; }
+
+	// the ranges are checked here, GL would read past the buffers silently
+	*mesh = impl_find_drawn_mesh(0, 0);
+	if (!*mesh) { return NULL; }
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Draw_Arguments const * draw = arguments + i;
+		if (draw->offset > (*mesh)->vertices_count || draw->length > (*mesh)->vertices_count - draw->offset) { ENGINE_DEBUG_BREAK(); return NULL; }
+		if (payload->instances.id == REF_EMPTY_ID) { continue; }
+		if (!impl_find_instances(payload->instances, draw->instances_offset, draw->count)) { return NULL; }
+	}
+
+	impl_bind_blocks();
+	return arguments;
+}
+
+// a draw per argument; instances go through `Render_Draw_Instanced`
+static void impl_draw_each(struct RVM_Render_Draw_Indirect const * payload, struct RVM_Draw_Arguments const * arguments) {
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Draw_Arguments const * draw = arguments + i;
+		if (payload->instances.id != REF_EMPTY_ID) {
+			impl_Render_Draw_Instanced(&(struct RVM_Render_Draw_Instanced){
+				.offset = draw->offset, .length = draw->length,
+				.instances = payload->instances, .instances_offset = draw->instances_offset, .count = draw->count,
+			});
+		}
+		else if (draw->count != 1) {
+			glDrawArraysInstanced(GL_TRIANGLES, (GLint)draw->offset, (GLsizei)draw->length, (GLsizei)draw->count);
+		}
+		else {
+			glDrawArrays(GL_TRIANGLES, (GLint)draw->offset, (GLsizei)draw->length);
+		}
+	}
+}
+
+static void impl_Render_Draw_Indirect_43(struct RVM_Render_Draw_Indirect const * payload) {
+	struct VM_Mesh * mesh;
+	struct RVM_Draw_Arguments const * arguments = impl_draw_indirect_prepare(payload, &mesh);
+	if (!arguments) { return; }
+
+	if (payload->instances.id != REF_EMPTY_ID) {
+		impl_attach_instances(mesh, engine_ref_pool_get(rvm->meshes, payload->instances), payload->instances.id, 0);
+	}
+
+	// the arguments go through the stream; too many of them are respecified, the driver orphans the storage in flight
+	size_t const size = payload->count * sizeof(*arguments);
+	size_t offset = impl_stream_write(&rvm->stream, arguments, size, VM_STREAM_ALIGNMENT);
+	GLuint buffer = rvm->stream.buffer;
+	if (offset == SIZE_MAX) {
+		if (!rvm->draws_buffer) { glGenBuffers(1, &rvm->draws_buffer); }
+		offset = 0; buffer = rvm->draws_buffer;
+	}
+
+	if (rvm->draws_binding != buffer) {
+		rvm->draws_binding = buffer;
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+	}
+	if (buffer == rvm->draws_buffer) {
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)size, arguments, GL_STREAM_DRAW);
+	}
+	glMultiDrawArraysIndirect(GL_TRIANGLES, (void const *)offset, (GLsizei)payload->count, 0);
+}
+static void impl_Render_Draw_Indirect(struct RVM_Render_Draw_Indirect const * payload) {
+	struct VM_Mesh * mesh;
+	struct RVM_Draw_Arguments const * arguments = impl_draw_indirect_prepare(payload, &mesh);
+	if (!arguments) { return; }
+	impl_draw_each(payload, arguments);
+}
+
+// Pipeline
+static void impl_Pipeline_Allocate(struct RVM_Pipeline_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Pipeline * pipeline = impl_claim(rvm->pipelines, ref);
+	if (!pipeline) { return; }
+
+	u32 const state = impl_pipeline_valid(&payload->value) ? impl_pipeline_bake(&payload->value) : UINT32_MAX;
+	if (state == UINT32_MAX) {
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		engine_ref_pool_release(rvm->pipelines, ref);
+		return;
+	}
+
+	pipeline->state = state;
+	rvm->pipeline_states[state].users++;
+}
+
+static void impl_Pipeline_Free(struct RVM_Pipeline_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Pipeline * pipeline = impl_find(rvm->pipelines, ref);
+	if (!pipeline) { return; }
+
+	rvm->pipeline_states[pipeline->state].users--;
+	engine_ref_pool_release(rvm->pipelines, ref);
+}
+
+static void impl_Pipeline_Use(struct RVM_Pipeline_Use const * payload) {
+	struct Ref const ref = payload->ref;
+
+	// an empty ref resets to what a fresh context has
+	struct RVM_Pipeline const * value = &impl_pipeline_defaults;
+	u64 bits = impl_pipeline_pack(&impl_pipeline_defaults);
+	if (ref.id != REF_EMPTY_ID) {
+		struct VM_Pipeline const * pipeline = impl_find(rvm->pipelines, ref);
+		if (!pipeline) { return; }
+
+		struct VM_Pipeline_State const * state = rvm->pipeline_states + pipeline->state;
+		value = &state->value;
+		bits = state->bits;
+	}
+
+	impl_Shader_Use(&value->shader);
+
+	// the differing fields go through their setters, which keep the GL state cache and the word current
+	u64 const changed = rvm->pipeline_bits ^ bits;
+	if (!changed) { rvm->stats.calls_skipped++; return; }
+
+	if (changed & impl_pipeline_mask(VM_Pipeline_Color_Write))        { impl_Color_Set_Write(&value->color_write); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Blend))              { impl_Color_Set_Blend(&value->blend); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Depth_Read))         { impl_Depth_Set_Read(&value->depth_read); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Depth_Write))        { impl_Depth_Set_Write(&value->depth_write); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Depth_Comparison))   { impl_Depth_Set_Comparison(&value->depth_comparison); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Stencil_Read))       { impl_Stencil_Set_Read(&value->stencil_read); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Stencil_Write))      { impl_Stencil_Set_Write(&value->stencil_write); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Stencil_Comparison)) { impl_Stencil_Set_Comparison(&value->stencil_comparison); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Stencil_Operation))  { impl_Stencil_Set_Operation(&value->stencil_operation); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Cull))               { impl_Face_Set_Cull(&value->cull); }
+	if (changed & impl_pipeline_mask(VM_Pipeline_Front))              { impl_Face_Set_Front(&value->front); }
+}
+
+// Bundle
+static void impl_Bundle_Allocate(struct RVM_Bundle_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Bundle_Allocate];
+	u32 const length = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Bundle_Allocate];
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	u32 const count = impl_bundle_decode(data, length, NULL);
+	if (count == UINT32_MAX) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Bundle * bundle = impl_claim(rvm->bundles, ref);
+	if (!bundle) { return; }
+
+	size_t const ops_size = RVM_ALIGN(count * sizeof(*bundle->ops));
+	bundle->ops = ENGINE_MALLOC(ops_size + length);
+	if (!bundle->ops && ops_size + length) { ENGINE_DEBUG_BREAK(); return; }
+	bundle->data = (u8 *)bundle->ops + ops_size;
+	bundle->count = count;
+	if (length) { memcpy(bundle->data, data, length); }
+	impl_bundle_decode(bundle->data, length, bundle->ops);
+}
+
+static void impl_Bundle_Free(struct RVM_Bundle_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Bundle const * bundle = impl_find(rvm->bundles, ref);
+	if (!bundle) { return; }
+
+	// nothing GL side refers to the recorded data, it is consumed by the call
+	ENGINE_FREE(bundle->ops);
+	engine_ref_pool_release(rvm->bundles, ref);
+}
+
+static void impl_Bundle_Call(struct RVM_Bundle_Call const * payload) {
+	struct VM_Bundle const * bundle = impl_find(rvm->bundles, payload->ref);
+	if (!bundle) { return; }
+
+	// decoded and validated once, only the payloads are checked per call
+	for (u32 i = 0; i < bundle->count; ++i) {
+		struct VM_Bundle_Op const * op = bundle->ops + i;
+		rvm->payload_size = op->size;
+		op->handler(bundle->data + op->offset);
+	}
+}
+
+static void impl_Bundle_Patch(struct RVM_Bundle_Patch const * payload) {
+	struct VM_Bundle const * bundle = impl_find(rvm->bundles, payload->ref);
+	if (!bundle) { return; }
+
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Bundle_Patch];
+	u32 const length = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Bundle_Patch];
+	if (payload->slot >= bundle->count || length < sizeof(struct RVM_Header)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	// only a payload of the same kind and size fits in place; the recorded header stays ahead of it
+	struct VM_Bundle_Op const * op = bundle->ops + payload->slot;
+	struct RVM_Header const * recorded = (void const *)(bundle->data + op->offset - sizeof(*recorded));
+	struct RVM_Header const * header = (void const *)data;
+	if (header->instruction != recorded->instruction || header->size != recorded->size) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+	if (header->size > length - sizeof(*header)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	memcpy(bundle->data + op->offset, data + sizeof(*header), op->size);
+}
+
+// Target
+static void impl_Target_Allocate(struct RVM_Target_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Target_Desc desc;
+	if (!impl_target_desc(payload, &desc)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Target * target = impl_claim(rvm->targets, ref);
+	if (!target) { return; }
+
+	// the sampled attachments are textures of the stream, owned by the target
+	for (u32 i = 0; i < RVM_TARGET_ATTACHMENTS; ++i) {
+		target->textures[i] = (struct Ref){.id = REF_EMPTY_ID};
+	}
+	bool claimed = true;
+	for (u32 i = 0; claimed && i < payload->count; ++i) {
+		struct Ref const texture_ref = payload->attachments[i].texture;
+		if (texture_ref.id == REF_EMPTY_ID) { continue; }
+
+		struct VM_Texture * texture = impl_claim(rvm->textures, texture_ref);
+		if (!texture) { claimed = false; continue; }
+
+		struct RVM_Sampler const sampler = impl_target_sampler(desc.formats + i);
+		texture->attachment = true;
+		texture->sampler = impl_sampler_acquire(&sampler);
+		target->textures[i] = texture_ref;
+	}
+
+	u32 const framebuffer = claimed ? impl_framebuffer_acquire(&desc, payload->transient) : UINT32_MAX;
+	if (framebuffer == UINT32_MAX) {
+		impl_target_release_textures(target);
+		engine_ref_pool_release(rvm->targets, ref);
+		return;
+	}
+
+	target->framebuffer = framebuffer;
+	impl_target_textures(target);
+}
+
+static void impl_Target_Free(struct RVM_Target_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Target const * target = impl_find(rvm->targets, ref);
+	if (!target) { return; }
+
+	// its contents go away, there is nothing to resolve
+	if (rvm->target == target->framebuffer) {
+		rvm->target = UINT32_MAX;
+		impl_bind_framebuffer(0);
+	}
+	impl_framebuffer_release(target->framebuffer);
+	impl_target_release_textures(target);
+
+	engine_ref_pool_release(rvm->targets, ref);
+}
+
+static void impl_Target_Load(struct RVM_Target_Load const * payload) {
+	struct VM_Target * target = impl_find(rvm->targets, payload->ref);
+	if (!target) { return; }
+
+	if (payload->size.x <= 0 || payload->size.y <= 0) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	u32 const previous = target->framebuffer;
+	struct VM_Framebuffer const * framebuffer = rvm->framebuffers + previous;
+	if (framebuffer->desc.size.x == payload->size.x && framebuffer->desc.size.y == payload->size.y) {
+		rvm->stats.calls_skipped++;
+		return;
+	}
+
+	struct VM_Target_Desc desc;
+	memcpy(&desc, &framebuffer->desc, sizeof(desc));
+	desc.size = payload->size;
+
+	// the new one is made before the old one goes, a failure keeps the target as it was
+	u32 const next = impl_framebuffer_acquire(&desc, framebuffer->transient);
+	if (next == UINT32_MAX) { return; }
+
+	target->framebuffer = next;
+	impl_target_textures(target);
+	if (rvm->target == previous) {
+		rvm->target = next;
+		impl_bind_framebuffer(rvm->framebuffers[next].id);
+	}
+	impl_framebuffer_release(previous);
+}
+
+static void impl_Target_Use(struct RVM_Target_Use const * payload) {
+	struct Ref const ref = payload->ref;
+
+	u32 framebuffer = UINT32_MAX;
+	if (ref.id != REF_EMPTY_ID) {
+		struct VM_Target const * target = impl_find(rvm->targets, ref);
+		if (!target) { return; }
+		framebuffer = target->framebuffer;
+	}
+
+	// leaving a multisampled target makes its textures current
+	if (rvm->target != framebuffer) {
+		if (rvm->target != UINT32_MAX && rvm->framebuffers[rvm->target].resolve) {
+			impl_framebuffer_resolve(rvm->framebuffers + rvm->target);
+		}
+		rvm->target = framebuffer;
+	}
+	impl_bind_framebuffer((framebuffer != UINT32_MAX) ? rvm->framebuffers[framebuffer].id : 0);
+}
+
+static void impl_Target_Clear(struct RVM_Target_Clear const * payload) {
+	if (rvm->target == UINT32_MAX) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Target_Desc const * desc = &rvm->framebuffers[rvm->target].desc;
+	if (payload->attachment >= desc->count) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Target_Format const * format = desc->formats + payload->attachment;
+	switch (format->kind) {
+		case Texture_Type_Color: {
+			GLint const buffer = (GLint)impl_target_color_index(desc, payload->attachment);
+			if (format->type == Data_Type_u32) {
+				GLuint const values[] = {(GLuint)payload->color.x, (GLuint)payload->color.y, (GLuint)payload->color.z, (GLuint)payload->color.w};
+				glClearBufferuiv(GL_COLOR, buffer, values);
+			}
+			else {
+				GLfloat const values[] = {payload->color.x, payload->color.y, payload->color.z, payload->color.w};
+				glClearBufferfv(GL_COLOR, buffer, values);
+			}
+		} break;
+
+		case Texture_Type_Depth: {
+			glClearBufferfv(GL_DEPTH, 0, &payload->depth);
+		} break;
+
+		case Texture_Type_Stencil: {
+			GLint const value = payload->stencil;
+			glClearBufferiv(GL_STENCIL, 0, &value);
+		} break;
+
+		case Texture_Type_DStencil: {
+			glClearBufferfi(GL_DEPTH_STENCIL, 0, payload->depth, payload->stencil);
+		} break;
+	}
+}
+
+//
+#undef OGL_VERSION
+#undef VM_TEXTURE_UNITS
+#undef VM_STREAM_SIZE
+#undef VM_STREAM_FRAMES
+#undef VM_STREAM_ALIGNMENT
+#undef VM_UPLOAD_SIZE
+#undef VM_UPLOAD_BUDGET
+#undef VM_RETIRE_FRAMES
+#undef VM_TARGET_FRAMES
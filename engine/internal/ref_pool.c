@@ -0,0 +1,192 @@
+#include "engine/api/code.h"
+#include "engine/api/ref_pool.h"
+
+#include <string.h>
+
+struct Ref_Pool_Slot {
+	u32 gen;
+	u32 dense;      // of the live ones, `REF_EMPTY_ID` for a free slot
+	u32 prev, next; // of the free ones
+};
+
+// entries follow the slots
+struct Ref_Pool_Chunk {
+	struct Ref_Pool_Slot slots[ENGINE_REF_POOL_CHUNK_SIZE];
+};
+
+struct Ref_Pool;
+static struct Ref_Pool_Slot * impl_get_slot(struct Ref_Pool const * pool, u32 id);
+static void * impl_get_entry(struct Ref_Pool const * pool, u32 id);
+static bool impl_grow_chunks(struct Ref_Pool * pool, u32 chunks_count);
+static bool impl_grow_dense(struct Ref_Pool * pool);
+static void impl_take(struct Ref_Pool * pool, u32 id, u32 gen);
+
+//
+// API
+//
+
+struct Ref_Pool {
+	size_t entry_size;
+	struct Ref_Pool_Chunk ** chunks; u32 chunks_count, chunks_capacity;
+	u32 free_first;
+	u32 * dense; u32 dense_count, dense_capacity;
+};
+
+struct Ref_Pool * engine_ref_pool_create(size_t entry_size) {
+	struct Ref_Pool * pool = ENGINE_MALLOC(sizeof(*pool));
+	memset(pool, 0, sizeof(*pool));
+	pool->entry_size = (entry_size + 7) & ~(size_t)7;
+	pool->free_first = REF_EMPTY_ID;
+	return pool;
+}
+
+void engine_ref_pool_destroy(struct Ref_Pool * pool) {
+	for (u32 i = 0; i < pool->chunks_count; ++i) {
+		ENGINE_FREE(pool->chunks[i]);
+	}
+	ENGINE_FREE(pool->chunks);
+	ENGINE_FREE(pool->dense);
+	ENGINE_FREE(pool);
+}
+
+struct Ref engine_ref_pool_acquire(struct Ref_Pool * pool) {
+	if (pool->free_first == REF_EMPTY_ID) {
+		if (!impl_grow_chunks(pool, pool->chunks_count + 1)) { return (struct Ref){.id = REF_EMPTY_ID}; }
+	}
+	if (!impl_grow_dense(pool)) { return (struct Ref){.id = REF_EMPTY_ID}; }
+
+	u32 const id = pool->free_first;
+	u32 const gen = impl_get_slot(pool, id)->gen;
+	impl_take(pool, id, gen);
+	return (struct Ref){.id = id, .gen = gen};
+}
+
+void * engine_ref_pool_claim(struct Ref_Pool * pool, struct Ref ref) {
+	if (ref.id == REF_EMPTY_ID || ref.id >= ENGINE_REF_POOL_MAX_ID) { return NULL; }
+
+	u32 const chunks_count = ref.id / ENGINE_REF_POOL_CHUNK_SIZE + 1;
+	if (chunks_count > pool->chunks_count) {
+		if (!impl_grow_chunks(pool, chunks_count)) { return NULL; }
+	}
+
+	// a live slot can't be claimed twice; any generation fits a free one, streams are replayed as they were recorded
+	struct Ref_Pool_Slot const * slot = impl_get_slot(pool, ref.id);
+	if (slot->dense != REF_EMPTY_ID) { return NULL; }
+
+	if (!impl_grow_dense(pool)) { return NULL; }
+	impl_take(pool, ref.id, ref.gen);
+	return impl_get_entry(pool, ref.id);
+}
+
+bool engine_ref_pool_release(struct Ref_Pool * pool, struct Ref ref) {
+	if (!engine_ref_pool_is_valid(pool, ref)) { return false; }
+	struct Ref_Pool_Slot * slot = impl_get_slot(pool, ref.id);
+
+	// swap the last live ref in
+	u32 const last = pool->dense[--pool->dense_count];
+	pool->dense[slot->dense] = last;
+	impl_get_slot(pool, last)->dense = slot->dense;
+
+	// push to the free list head, so the hot slots are recycled first
+	slot->gen = ref.gen + 1;
+	slot->dense = REF_EMPTY_ID;
+	slot->prev = REF_EMPTY_ID;
+	slot->next = pool->free_first;
+	if (pool->free_first != REF_EMPTY_ID) { impl_get_slot(pool, pool->free_first)->prev = ref.id; }
+	pool->free_first = ref.id;
+	return true;
+}
+
+void * engine_ref_pool_get(struct Ref_Pool const * pool, struct Ref ref) {
+	if (!engine_ref_pool_is_valid(pool, ref)) { return NULL; }
+	return impl_get_entry(pool, ref.id);
+}
+
+bool engine_ref_pool_is_valid(struct Ref_Pool const * pool, struct Ref ref) {
+	struct Ref_Pool_Slot const * slot = impl_get_slot(pool, ref.id);
+	return slot && slot->dense != REF_EMPTY_ID && slot->gen == ref.gen;
+}
+
+u32 engine_ref_pool_get_count(struct Ref_Pool const * pool) {
+	return pool->dense_count;
+}
+
+struct Ref engine_ref_pool_get_ref(struct Ref_Pool const * pool, u32 index) {
+	if (index >= pool->dense_count) { return (struct Ref){.id = REF_EMPTY_ID}; }
+	u32 const id = pool->dense[index];
+	return (struct Ref){.id = id, .gen = impl_get_slot(pool, id)->gen};
+}
+
+//
+// internal implementation
+//
+
+static struct Ref_Pool_Slot * impl_get_slot(struct Ref_Pool const * pool, u32 id) {
+	u32 const chunk = id / ENGINE_REF_POOL_CHUNK_SIZE;
+	if (chunk >= pool->chunks_count) { return NULL; }
+	return pool->chunks[chunk]->slots + id % ENGINE_REF_POOL_CHUNK_SIZE;
+}
+
+static void * impl_get_entry(struct Ref_Pool const * pool, u32 id) {
+	u8 * entries = (u8 *)(pool->chunks[id / ENGINE_REF_POOL_CHUNK_SIZE] + 1);
+	return entries + (id % ENGINE_REF_POOL_CHUNK_SIZE) * pool->entry_size;
+}
+
+static bool impl_grow_chunks(struct Ref_Pool * pool, u32 chunks_count) {
+	if (chunks_count > ENGINE_REF_POOL_MAX_ID / ENGINE_REF_POOL_CHUNK_SIZE) { return false; }
+
+	// only the chunks table is reallocated, the chunks stay in place
+	if (chunks_count > pool->chunks_capacity) {
+		u32 chunks_capacity = pool->chunks_capacity ? pool->chunks_capacity * 2 : 4;
+		if (chunks_capacity < chunks_count) { chunks_capacity = chunks_count; }
+		struct Ref_Pool_Chunk ** chunks = ENGINE_REALLOC(pool->chunks, chunks_capacity * sizeof(*chunks));
+		if (!chunks) { ENGINE_DEBUG_BREAK(); return false; }
+		pool->chunks = chunks;
+		pool->chunks_capacity = chunks_capacity;
+	}
+
+	while (pool->chunks_count < chunks_count) {
+		struct Ref_Pool_Chunk * chunk = ENGINE_MALLOC(sizeof(*chunk) + ENGINE_REF_POOL_CHUNK_SIZE * pool->entry_size);
+		if (!chunk) { ENGINE_DEBUG_BREAK(); return false; }
+
+		// link the new slots in order, ahead of the free list
+		u32 const first = pool->chunks_count * ENGINE_REF_POOL_CHUNK_SIZE;
+		for (u32 i = 0; i < ENGINE_REF_POOL_CHUNK_SIZE; ++i) {
+			chunk->slots[i] = (struct Ref_Pool_Slot){
+				.gen = 0, .dense = REF_EMPTY_ID,
+				.prev = i ? first + i - 1 : REF_EMPTY_ID,
+				.next = first + i + 1,
+			};
+		}
+		chunk->slots[ENGINE_REF_POOL_CHUNK_SIZE - 1].next = pool->free_first;
+		pool->chunks[pool->chunks_count++] = chunk;
+
+		if (pool->free_first != REF_EMPTY_ID) { impl_get_slot(pool, pool->free_first)->prev = first + ENGINE_REF_POOL_CHUNK_SIZE - 1; }
+		pool->free_first = first;
+	}
+	return true;
+}
+
+static bool impl_grow_dense(struct Ref_Pool * pool) {
+	if (pool->dense_count < pool->dense_capacity) { return true; }
+	u32 const dense_capacity = pool->dense_capacity ? pool->dense_capacity * 2 : ENGINE_REF_POOL_CHUNK_SIZE;
+	u32 * dense = ENGINE_REALLOC(pool->dense, dense_capacity * sizeof(*dense));
+	if (!dense) { ENGINE_DEBUG_BREAK(); return false; }
+	pool->dense = dense;
+	pool->dense_capacity = dense_capacity;
+	return true;
+}
+
+static void impl_take(struct Ref_Pool * pool, u32 id, u32 gen) {
+	struct Ref_Pool_Slot * slot = impl_get_slot(pool, id);
+
+	// unlink from the free list
+	if (slot->prev != REF_EMPTY_ID) { impl_get_slot(pool, slot->prev)->next = slot->next; }
+	else { pool->free_first = slot->next; }
+	if (slot->next != REF_EMPTY_ID) { impl_get_slot(pool, slot->next)->prev = slot->prev; }
+
+	slot->gen = gen;
+	slot->dense = pool->dense_count;
+	pool->dense[pool->dense_count++] = id;
+	memset(impl_get_entry(pool, id), 0, pool->entry_size);
+}
@@ -0,0 +1,129 @@
+#include "engine/api/code.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+
+struct Batch_Span {
+	u64 key;
+	u8 const * data;
+	size_t length;
+};
+
+static void impl_batch_sort(struct Batch_Span * spans, struct Batch_Span * scratch, u32 count);
+
+//
+// API
+//
+
+#include "engine/api/rendering_batch.h"
+
+struct Rendering_Batch {
+	struct Batch_Span * spans, * scratch;
+	u32 count, capacity;
+	bool sorted;
+};
+
+struct Rendering_Batch * engine_rendering_batch_create(void) {
+	struct Rendering_Batch * batch = ENGINE_MALLOC(sizeof(*batch));
+	memset(batch, 0, sizeof(*batch));
+	return batch;
+}
+
+void engine_rendering_batch_destroy(struct Rendering_Batch * batch) {
+	ENGINE_FREE(batch->spans);
+	ENGINE_FREE(batch->scratch);
+	ENGINE_FREE(batch);
+}
+
+void engine_rendering_batch_reset(struct Rendering_Batch * batch) {
+	batch->count = 0;
+	batch->sorted = false;
+}
+
+void engine_rendering_batch_add(struct Rendering_Batch * batch, struct Rendering_Buffer const * buffer) {
+	u32 const spans_count = engine_rendering_buffer_get_spans_count(buffer);
+	if (batch->count + spans_count > batch->capacity) {
+		u32 capacity = batch->capacity ? batch->capacity : 64;
+		while (batch->count + spans_count > capacity) { capacity *= 2; }
+
+		struct Batch_Span * spans   = ENGINE_REALLOC(batch->spans,   capacity * sizeof(*spans));
+		struct Batch_Span * scratch = ENGINE_REALLOC(batch->scratch, capacity * sizeof(*scratch));
+		if (spans)   { batch->spans   = spans; }
+		if (scratch) { batch->scratch = scratch; }
+		if (!spans || !scratch) { ENGINE_DEBUG_BREAK(); return; }
+
+		batch->capacity = capacity;
+	}
+
+	for (u32 i = 0; i < spans_count; ++i) {
+		struct Batch_Span * span = batch->spans + batch->count++;
+		span->data = engine_rendering_buffer_get_span(buffer, i, &span->key, &span->length);
+	}
+	batch->sorted = false;
+}
+
+void engine_rendering_batch_sort(struct Rendering_Batch * batch) {
+	if (batch->sorted) { return; }
+	impl_batch_sort(batch->spans, batch->scratch, batch->count);
+	batch->sorted = true;
+}
+
+u32 engine_rendering_batch_get_spans_count(struct Rendering_Batch const * batch) {
+	return batch->count;
+}
+
+u8 const * engine_rendering_batch_get_span(struct Rendering_Batch const * batch, u32 index, size_t * length) {
+	if (index >= batch->count) { *length = 0; return NULL; }
+	*length = batch->spans[index].length;
+	return batch->spans[index].data;
+}
+
+void engine_rendering_batch_submit(struct Rendering_Batch * batch) {
+	engine_rendering_batch_sort(batch);
+	for (u32 i = 0; i < batch->count; ++i) {
+		engine_rendering_vm_update(batch->spans[i].data, batch->spans[i].length);
+	}
+}
+
+//
+// internal implementation
+//
+
+static void impl_batch_merge(struct Batch_Span const * left, u32 left_count, struct Batch_Span const * right, u32 right_count, struct Batch_Span * target) {
+	u32 left_i = 0, right_i = 0;
+	while (left_i < left_count && right_i < right_count) {
+		// ties go to the left, keeping the merge stable
+		*target++ = (right[right_i].key < left[left_i].key) ? right[right_i++] : left[left_i++];
+	}
+	while (left_i  < left_count)  { *target++ = left[left_i++]; }
+	while (right_i < right_count) { *target++ = right[right_i++]; }
+}
+
+static void impl_batch_sort(struct Batch_Span * spans, struct Batch_Span * scratch, u32 count) {
+	// each buffer is usually recorded in key order, so the input is a few sorted runs;
+	// bottom-up merges over natural runs, which is linear for already sorted input
+	if (count < 2) { return; }
+
+	struct Batch_Span * source = spans;
+	struct Batch_Span * target = scratch;
+	for (;;) {
+		u32 runs = 0;
+		for (u32 start = 0; start < count;) {
+			u32 middle = start + 1;
+			while (middle < count && source[middle - 1].key <= source[middle].key) { middle++; }
+			u32 end = middle;
+			if (end < count) {
+				end++;
+				while (end < count && source[end - 1].key <= source[end].key) { end++; }
+			}
+
+			impl_batch_merge(source + start, middle - start, source + middle, end - middle, target + start);
+			start = end; runs++;
+		}
+
+		struct Batch_Span * swap = source;
+		source = target; target = swap;
+		if (runs <= 1) { break; }
+	}
+
+	if (source != spans) { memcpy(spans, source, count * sizeof(*spans)); }
+}
@@ -0,0 +1,254 @@
+#include "engine/api/code.h"
+#include "engine/api/rendering_vm.h"
+
+#include <string.h>
+
+struct Rendering_Buffer_Chunk {
+	u8 * data;
+	size_t length, capacity;
+};
+
+struct Rendering_Buffer_Span {
+	u64 key;
+	u32 chunk;
+	size_t offset, length;
+};
+
+struct Rendering_Buffer;
+static void impl_emit(struct Rendering_Buffer * buffer, enum RVM_Instruction instruction, void const * payload, size_t size, void const * data, size_t data_size);
+static void impl_emit_buffer(struct Rendering_Buffer * buffer, enum RVM_Instruction instruction, void const * payload, size_t size, struct Rendering_Buffer const * source);
+
+//
+// API
+//
+
+#include "engine/api/rendering_buffer.h"
+
+struct Rendering_Buffer {
+	size_t chunk_size;
+	struct Rendering_Buffer_Chunk * chunks; u32 chunks_count, chunks_capacity;
+	u32 current;
+	u32 instructions_count;
+	//
+	u64 key;
+	struct Rendering_Buffer_Span * spans; u32 spans_count, spans_capacity;
+};
+
+struct Rendering_Buffer * engine_rendering_buffer_create(size_t chunk_size) {
+	struct Rendering_Buffer * buffer = ENGINE_MALLOC(sizeof(*buffer));
+	memset(buffer, 0, sizeof(*buffer));
+	buffer->chunk_size = chunk_size ? chunk_size : ENGINE_RENDERING_BUFFER_CHUNK_SIZE;
+	return buffer;
+}
+
+void engine_rendering_buffer_destroy(struct Rendering_Buffer * buffer) {
+	for (u32 i = 0; i < buffer->chunks_count; ++i) {
+		ENGINE_FREE(buffer->chunks[i].data);
+	}
+	ENGINE_FREE(buffer->chunks);
+	ENGINE_FREE(buffer->spans);
+	ENGINE_FREE(buffer);
+}
+
+void engine_rendering_buffer_reset(struct Rendering_Buffer * buffer) {
+	for (u32 i = 0; i < buffer->chunks_count; ++i) {
+		buffer->chunks[i].length = 0;
+	}
+	buffer->current = 0;
+	buffer->instructions_count = 0;
+	buffer->key = 0;
+	buffer->spans_count = 0;
+}
+
+u32 engine_rendering_buffer_get_chunks_count(struct Rendering_Buffer const * buffer) {
+	if (!buffer->chunks_count) { return 0; }
+	return buffer->current + 1;
+}
+
+u8 const * engine_rendering_buffer_get_chunk(struct Rendering_Buffer const * buffer, u32 index, size_t * length) {
+	if (index >= buffer->chunks_count) { *length = 0; return NULL; }
+	struct Rendering_Buffer_Chunk const * chunk = buffer->chunks + index;
+	*length = chunk->length;
+	return chunk->data;
+}
+
+u32 engine_rendering_buffer_get_instructions_count(struct Rendering_Buffer const * buffer) {
+	return buffer->instructions_count;
+}
+
+void engine_rendering_buffer_set_key(struct Rendering_Buffer * buffer, u64 key) {
+	buffer->key = key;
+}
+
+u32 engine_rendering_buffer_get_spans_count(struct Rendering_Buffer const * buffer) {
+	return buffer->spans_count;
+}
+
+u8 const * engine_rendering_buffer_get_span(struct Rendering_Buffer const * buffer, u32 index, u64 * key, size_t * length) {
+	if (index >= buffer->spans_count) { *key = 0; *length = 0; return NULL; }
+	struct Rendering_Buffer_Span const * span = buffer->spans + index;
+	*key = span->key;
+	*length = span->length;
+	return buffer->chunks[span->chunk].data + span->offset;
+}
+
+#define REGISTRY_RVM_INSTRUCTION(name, scope) \
+void engine_rendering_buffer_emit_ ## name(struct Rendering_Buffer * buffer, struct RVM_ ## name payload) { \
+	impl_emit(buffer, RVM_Instruction_ ## name, &payload, sizeof(payload), NULL, 0); \
+}
+#include "engine/registry/rendering_vm_instruction.h"
+
+void engine_rendering_buffer_emit_uniform(struct Rendering_Buffer * buffer, struct RVM_Shader_Uniform payload, void const * data, size_t size) {
+	impl_emit(buffer, RVM_Instruction_Shader_Uniform, &payload, sizeof(payload), data, size);
+}
+
+void engine_rendering_buffer_emit_draws(struct Rendering_Buffer * buffer, struct RVM_Render_Draw_Indirect payload, struct RVM_Draw_Arguments const * arguments) {
+	impl_emit(buffer, RVM_Instruction_Render_Draw_Indirect, &payload, sizeof(payload), arguments, payload.count * sizeof(*arguments));
+}
+
+void engine_rendering_buffer_emit_bundle(struct Rendering_Buffer * buffer, struct RVM_Bundle_Allocate payload, struct Rendering_Buffer const * bundle) {
+	impl_emit_buffer(buffer, RVM_Instruction_Bundle_Allocate, &payload, sizeof(payload), bundle);
+}
+
+void engine_rendering_buffer_emit_patch(struct Rendering_Buffer * buffer, struct RVM_Bundle_Patch payload, struct Rendering_Buffer const * instruction) {
+	impl_emit_buffer(buffer, RVM_Instruction_Bundle_Patch, &payload, sizeof(payload), instruction);
+}
+
+u32 engine_rendering_buffer_fill_draws(struct RVM_Draw_Arguments * arguments, struct RVM_Render_Draw const * ranges, u32 count) {
+	u32 arguments_count = 0;
+	for (u32 i = 0; i < count; ++i) {
+		struct RVM_Render_Draw const * range = ranges + i;
+		if (!range->length) { continue; }
+
+		struct RVM_Draw_Arguments * previous = arguments_count ? arguments + arguments_count - 1 : NULL;
+		if (previous && previous->offset + previous->length == range->offset) {
+			previous->length += range->length;
+			continue;
+		}
+
+		arguments[arguments_count++] = (struct RVM_Draw_Arguments){
+			.length = range->length, .count = 1,
+			.offset = range->offset,
+		};
+	}
+	return arguments_count;
+}
+
+//
+// internal implementation
+//
+
+static struct Rendering_Buffer_Chunk * impl_insert_chunk(struct Rendering_Buffer * buffer, u32 index, size_t capacity) {
+	if (buffer->chunks_count == buffer->chunks_capacity) {
+		u32 chunks_capacity = buffer->chunks_capacity ? buffer->chunks_capacity * 2 : 8;
+		struct Rendering_Buffer_Chunk * chunks = ENGINE_REALLOC(buffer->chunks, chunks_capacity * sizeof(*chunks));
+		if (!chunks) { return NULL; }
+
+		buffer->chunks = chunks;
+		buffer->chunks_capacity = chunks_capacity;
+	}
+
+	u8 * data = ENGINE_MALLOC(capacity);
+	if (!data) { return NULL; }
+
+	// only chunk descriptors are shifted, the data stays in place
+	memmove(buffer->chunks + index + 1, buffer->chunks + index, (buffer->chunks_count - index) * sizeof(*buffer->chunks));
+	buffer->chunks_count++;
+
+	struct Rendering_Buffer_Chunk * chunk = buffer->chunks + index;
+	*chunk = (struct Rendering_Buffer_Chunk){
+		.data = data,
+		.capacity = capacity,
+	};
+	return chunk;
+}
+
+static u8 * impl_reserve(struct Rendering_Buffer * buffer, size_t size) {
+	size_t const chunk_size = (size > buffer->chunk_size) ? size : buffer->chunk_size;
+	if (!buffer->chunks_count) {
+		if (!impl_insert_chunk(buffer, 0, chunk_size)) { return NULL; }
+	}
+
+	struct Rendering_Buffer_Chunk * chunk = buffer->chunks + buffer->current;
+	if (chunk->length + size > chunk->capacity) {
+		// reuse the chunks of the previous frames
+		u32 next = buffer->current + 1;
+		if (next < buffer->chunks_count && buffer->chunks[next].capacity >= size) {
+			chunk = buffer->chunks + next;
+		}
+		else {
+			chunk = impl_insert_chunk(buffer, next, chunk_size);
+			if (!chunk) { return NULL; }
+		}
+		buffer->current = next;
+	}
+
+	u8 * result = chunk->data + chunk->length;
+
+	// a span is a contiguous run of one key
+	struct Rendering_Buffer_Span * span = buffer->spans_count ? buffer->spans + buffer->spans_count - 1 : NULL;
+	if (!span || span->key != buffer->key || span->chunk != buffer->current || span->offset + span->length != chunk->length) {
+		if (buffer->spans_count == buffer->spans_capacity) {
+			u32 spans_capacity = buffer->spans_capacity ? buffer->spans_capacity * 2 : 8;
+			struct Rendering_Buffer_Span * spans = ENGINE_REALLOC(buffer->spans, spans_capacity * sizeof(*spans));
+			if (!spans) { return NULL; }
+
+			buffer->spans = spans;
+			buffer->spans_capacity = spans_capacity;
+		}
+
+		span = buffer->spans + buffer->spans_count++;
+		*span = (struct Rendering_Buffer_Span){
+			.key = buffer->key,
+			.chunk = buffer->current,
+			.offset = chunk->length,
+		};
+	}
+
+	chunk->length += size;
+	span->length += size;
+	return result;
+}
+
+static u8 * impl_emit_header(struct Rendering_Buffer * buffer, enum RVM_Instruction instruction, void const * payload, size_t size, size_t data_size) {
+	// trailing data starts aligned, right after the payload padding
+	size_t const payload_size = RVM_ALIGN(size);
+	struct RVM_Header const header = {
+		.instruction = (u32)instruction,
+		.size = (u32)(payload_size + RVM_ALIGN(data_size)),
+	};
+
+	u8 * target = impl_reserve(buffer, sizeof(header) + header.size);
+	if (!target) { ENGINE_DEBUG_BREAK(); return NULL; }
+
+	target += sizeof(header);
+	memcpy(target - sizeof(header), &header, sizeof(header));
+	memcpy(target, payload, size);
+	memset(target + size, 0, payload_size - size);
+	memset(target + payload_size + data_size, 0, header.size - payload_size - data_size);
+	buffer->instructions_count++;
+	return target + payload_size;
+}
+
+static void impl_emit(struct Rendering_Buffer * buffer, enum RVM_Instruction instruction, void const * payload, size_t size, void const * data, size_t data_size) {
+	u8 * target = impl_emit_header(buffer, instruction, payload, size, data_size);
+	if (target && data_size) { memcpy(target, data, data_size); }
+}
+
+static void impl_emit_buffer(struct Rendering_Buffer * buffer, enum RVM_Instruction instruction, void const * payload, size_t size, struct Rendering_Buffer const * source) {
+	// the source chunks are gathered into a single run of trailing data
+	u32 const chunks_count = engine_rendering_buffer_get_chunks_count(source);
+	size_t data_size = 0;
+	for (u32 i = 0; i < chunks_count; ++i) {
+		data_size += source->chunks[i].length;
+	}
+
+	u8 * target = impl_emit_header(buffer, instruction, payload, size, data_size);
+	if (!target) { return; }
+
+	for (u32 i = 0; i < chunks_count; ++i) {
+		struct Rendering_Buffer_Chunk const * chunk = source->chunks + i;
+		if (chunk->length) { memcpy(target, chunk->data, chunk->length); }
+		target += chunk->length;
+	}
+}
@@ -0,0 +1,402 @@
+#include "engine/api/code.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/platform_file.h"
+#include "engine/api/ref_pool.h"
+
+#include <stddef.h>
+
+// file layout: a header, then records, each padded to `RVM_ALIGNMENT`
+// - stream records are copies of VM streams, asset pointers there are replaced by file offsets of blob records
+// - frame records are empty and close the streams since the previous one
+// - `resources` were live in the VM at `begin`; their allocations are missing, so such a capture can't be replayed
+#define CAPTURE_MAGIC   0x434d5652 // `RVMC`
+#define CAPTURE_VERSION 3
+
+struct Capture_File_Header {
+	u32 magic, version;
+	u32 pointer_size, frames_count;
+	u32 resources, padding;
+};
+
+enum Capture_Record_Type {
+	Capture_Record_Type_Stream,
+	Capture_Record_Type_Blob,
+	Capture_Record_Type_Frame,
+};
+
+struct Capture_Record {
+	u32 type; // enum Capture_Record_Type
+	u32 size;
+};
+
+struct Capture_Recorder {
+	char * path;
+	u8 * data; size_t length, capacity;
+	u32 frames_count, frame_streams_count;
+	u32 resources;
+};
+static struct Capture_Recorder * capture_recorder;
+
+static size_t impl_capture_append(enum Capture_Record_Type type, void const * data, size_t size);
+static bool impl_capture_asset_fields(u32 instruction, size_t * data_offset, size_t * length_offset);
+struct Rendering_Capture;
+static void impl_capture_release_stream(struct Rendering_Capture * capture);
+
+//
+// API
+//
+
+#include "engine/api/rendering_capture.h"
+
+struct Capture_Stream {
+	size_t offset, length;
+};
+
+struct Capture_Frame {
+	u32 first, count;
+};
+
+struct Rendering_Capture {
+	u8 * data; size_t length;
+	struct Capture_Stream * streams; u32 streams_count;
+	struct Capture_Frame * frames; u32 frames_count;
+	u32 resources;
+	u8 * release; size_t release_length; // frees what the streams leave allocated
+};
+
+void engine_rendering_capture_begin(cstring path) {
+	if (capture_recorder) { engine_rendering_capture_end(); }
+
+	struct Capture_Recorder * recorder = ENGINE_MALLOC(sizeof(*recorder));
+	memset(recorder, 0, sizeof(*recorder));
+
+	size_t const path_size = strlen(path) + 1;
+	recorder->path = ENGINE_MALLOC(path_size);
+	memcpy(recorder->path, path, path_size);
+
+	recorder->capacity = 1024 * 1024;
+	recorder->data = ENGINE_MALLOC(recorder->capacity);
+	recorder->length = sizeof(struct Capture_File_Header);
+
+	recorder->resources = engine_rendering_vm_get_resources_count();
+	if (recorder->resources) {
+		printf("[wrn]: capture misses the allocations of %u live resources, it won't replay: `%s`\n", recorder->resources, path);
+	}
+
+	capture_recorder = recorder;
+}
+
+void engine_rendering_capture_end(void) {
+	struct Capture_Recorder * recorder = capture_recorder;
+	if (!recorder) { return; }
+
+	if (recorder->frame_streams_count) { engine_rendering_capture_frame(); }
+
+	struct Capture_File_Header const header = {
+		.magic = CAPTURE_MAGIC, .version = CAPTURE_VERSION,
+		.pointer_size = sizeof(void *), .frames_count = recorder->frames_count,
+		.resources = recorder->resources,
+	};
+	memcpy(recorder->data, &header, sizeof(header));
+
+	if (!engine_file_write(recorder->path, recorder->data, recorder->length)) { ENGINE_DEBUG_BREAK(); }
+
+	ENGINE_FREE(recorder->path);
+	ENGINE_FREE(recorder->data);
+	ENGINE_FREE(recorder);
+	capture_recorder = NULL;
+}
+
+void engine_rendering_capture_frame(void) {
+	if (!capture_recorder) { return; }
+	impl_capture_append(Capture_Record_Type_Frame, NULL, 0);
+	capture_recorder->frames_count++;
+	capture_recorder->frame_streams_count = 0;
+}
+
+bool engine_rendering_capture_is_active(void) {
+	return capture_recorder != NULL;
+}
+
+void engine_rendering_capture_record(u8 const * buffer, size_t buffer_length) {
+	struct Capture_Recorder * recorder = capture_recorder;
+	if (!recorder || !buffer_length) { return; }
+
+	size_t const stream_offset = impl_capture_append(Capture_Record_Type_Stream, buffer, buffer_length);
+	if (!stream_offset) { return; }
+	recorder->frame_streams_count++;
+
+	// blobs follow the stream; the copy is patched by offset, as appending may move it
+	size_t offset = 0;
+	while (buffer_length - offset >= sizeof(struct RVM_Header)) {
+		struct RVM_Header header;
+		memcpy(&header, buffer + offset, sizeof(header));
+		if (header.size > buffer_length - offset - sizeof(header)) { break; }
+
+		size_t data_offset, length_offset;
+		if (impl_capture_asset_fields(header.instruction, &data_offset, &length_offset)) {
+			size_t const payload_offset = offset + sizeof(header);
+
+			u8 const * data; size_t length;
+			memcpy(&data,   buffer + payload_offset + data_offset,   sizeof(data));
+			memcpy(&length, buffer + payload_offset + length_offset, sizeof(length));
+
+			uintptr_t const blob_offset = (data && length)
+				? (uintptr_t)impl_capture_append(Capture_Record_Type_Blob, data, length)
+				: 0;
+			memcpy(recorder->data + stream_offset + payload_offset + data_offset, &blob_offset, sizeof(blob_offset));
+		}
+
+		offset += sizeof(header) + header.size;
+	}
+}
+
+struct Rendering_Capture * engine_rendering_capture_load(cstring path) {
+	u8 * data = NULL; size_t length = 0;
+	engine_file_read(path, &data, &length);
+	if (!data) { return NULL; }
+
+	struct Capture_File_Header file_header = {0};
+	if (length >= sizeof(file_header)) { memcpy(&file_header, data, sizeof(file_header)); }
+	if (file_header.magic != CAPTURE_MAGIC || file_header.version != CAPTURE_VERSION || file_header.pointer_size != sizeof(void *)) {
+		printf("[err]: unsupported capture: `%s`\n", path);
+		ENGINE_FREE(data); return NULL;
+	}
+
+	struct Rendering_Capture * capture = ENGINE_MALLOC(sizeof(*capture));
+	memset(capture, 0, sizeof(*capture));
+	capture->data = data; capture->length = length;
+	capture->resources = file_header.resources;
+
+	u32 streams_capacity = 0;
+	capture->frames = ENGINE_MALLOC((file_header.frames_count + 1) * sizeof(*capture->frames));
+
+	u32 frame_first = 0;
+	for (size_t offset = sizeof(file_header); length - offset >= sizeof(struct Capture_Record);) {
+		struct Capture_Record record;
+		memcpy(&record, data + offset, sizeof(record));
+		offset += sizeof(record);
+		if (RVM_ALIGN(record.size) > length - offset) { printf("[err]: truncated capture: `%s`\n", path); break; }
+
+		switch ((enum Capture_Record_Type)record.type) {
+			case Capture_Record_Type_Stream: {
+				if (capture->streams_count == streams_capacity) {
+					streams_capacity = streams_capacity ? streams_capacity * 2 : 64;
+					capture->streams = ENGINE_REALLOC(capture->streams, streams_capacity * sizeof(*capture->streams));
+				}
+				capture->streams[capture->streams_count++] = (struct Capture_Stream){
+					.offset = offset, .length = record.size,
+				};
+			} break;
+
+			case Capture_Record_Type_Blob: break;
+
+			case Capture_Record_Type_Frame: {
+				if (capture->frames_count == file_header.frames_count) { break; }
+				capture->frames[capture->frames_count++] = (struct Capture_Frame){
+					.first = frame_first, .count = capture->streams_count - frame_first,
+				};
+				frame_first = capture->streams_count;
+			} break;
+		}
+
+		offset += RVM_ALIGN(record.size);
+	}
+
+	// file offsets back into pointers
+	for (u32 stream_i = 0; stream_i < capture->streams_count; ++stream_i) {
+		u8 * stream = data + capture->streams[stream_i].offset;
+		size_t const stream_length = capture->streams[stream_i].length;
+		for (size_t offset = 0; stream_length - offset >= sizeof(struct RVM_Header);) {
+			struct RVM_Header header;
+			memcpy(&header, stream + offset, sizeof(header));
+			if (header.size > stream_length - offset - sizeof(header)) { break; }
+
+			size_t data_offset, length_offset;
+			if (impl_capture_asset_fields(header.instruction, &data_offset, &length_offset)) {
+				u8 * payload = stream + offset + sizeof(header);
+
+				uintptr_t blob_offset; size_t blob_length;
+				memcpy(&blob_offset, payload + data_offset,   sizeof(blob_offset));
+				memcpy(&blob_length, payload + length_offset, sizeof(blob_length));
+
+				u8 * blob = NULL;
+				if (blob_offset && blob_offset <= length && blob_length <= length - blob_offset) { blob = data + blob_offset; }
+				else if (blob_offset) { printf("[err]: broken asset in capture: `%s`\n", path); }
+				memcpy(payload + data_offset, &blob, sizeof(blob));
+			}
+
+			offset += sizeof(header) + header.size;
+		}
+	}
+
+	impl_capture_release_stream(capture);
+	return capture;
+}
+
+void engine_rendering_capture_free(struct Rendering_Capture * capture) {
+	ENGINE_FREE(capture->data);
+	ENGINE_FREE(capture->streams);
+	ENGINE_FREE(capture->frames);
+	ENGINE_FREE(capture->release);
+	ENGINE_FREE(capture);
+}
+
+u32 engine_rendering_capture_get_frames_count(struct Rendering_Capture const * capture) {
+	return capture->frames_count;
+}
+
+u32 engine_rendering_capture_get_streams_count(struct Rendering_Capture const * capture, u32 frame) {
+	if (frame >= capture->frames_count) { return 0; }
+	return capture->frames[frame].count;
+}
+
+u8 const * engine_rendering_capture_get_stream(struct Rendering_Capture const * capture, u32 frame, u32 index, size_t * length) {
+	if (index >= engine_rendering_capture_get_streams_count(capture, frame)) { *length = 0; return NULL; }
+	struct Capture_Stream const * stream = capture->streams + capture->frames[frame].first + index;
+	*length = stream->length;
+	return capture->data + stream->offset;
+}
+
+bool engine_rendering_capture_is_complete(struct Rendering_Capture const * capture) {
+	return capture->resources == 0;
+}
+
+void engine_rendering_capture_replay(struct Rendering_Capture const * capture, u32 frame) {
+	if (!engine_rendering_capture_is_complete(capture)) { return; }
+	u32 const streams_count = engine_rendering_capture_get_streams_count(capture, frame);
+	for (u32 i = 0; i < streams_count; ++i) {
+		size_t length;
+		u8 const * stream = engine_rendering_capture_get_stream(capture, frame, i, &length);
+		engine_rendering_vm_update(stream, length);
+	}
+	engine_rendering_vm_end_frame();
+}
+
+void engine_rendering_capture_release(struct Rendering_Capture const * capture) {
+	if (!engine_rendering_capture_is_complete(capture)) { return; }
+	engine_rendering_vm_update(capture->release, capture->release_length);
+	engine_rendering_vm_end_frame();
+}
+
+//
+// internal implementation
+//
+
+// returns the payload offset in the file, zero on failure
+static size_t impl_capture_append(enum Capture_Record_Type type, void const * data, size_t size) {
+	struct Capture_Recorder * recorder = capture_recorder;
+	if (size > UINT32_MAX) { ENGINE_DEBUG_BREAK(); return 0; }
+
+	struct Capture_Record const record = {
+		.type = (u32)type,
+		.size = (u32)size,
+	};
+	size_t const record_size = sizeof(record) + RVM_ALIGN(size);
+
+	if (recorder->length + record_size > recorder->capacity) {
+		size_t capacity = recorder->capacity * 2;
+		while (recorder->length + record_size > capacity) { capacity *= 2; }
+
+		u8 * grown = ENGINE_REALLOC(recorder->data, capacity);
+		if (!grown) { ENGINE_DEBUG_BREAK(); return 0; }
+
+		recorder->data = grown;
+		recorder->capacity = capacity;
+	}
+
+	u8 * target = recorder->data + recorder->length;
+	memcpy(target, &record, sizeof(record));
+	if (size) { memcpy(target + sizeof(record), data, size); }
+	memset(target + sizeof(record) + size, 0, record_size - sizeof(record) - size);
+
+	size_t const payload_offset = recorder->length + sizeof(record);
+	recorder->length += record_size;
+	return payload_offset;
+}
+
+static bool impl_capture_asset_fields(u32 instruction, size_t * data_offset, size_t * length_offset) {
+	switch ((enum RVM_Instruction)instruction) {
+		#define CAPTURE_ASSET(name) case RVM_Instruction_ ## name: \
+			*data_offset   = offsetof(struct RVM_ ## name, asset.data); \
+			*length_offset = offsetof(struct RVM_ ## name, asset.length); \
+			return true;
+		CAPTURE_ASSET(Shader_Load)
+		CAPTURE_ASSET(Mesh_Allocate)
+		CAPTURE_ASSET(Mesh_Load)
+		CAPTURE_ASSET(Texture_Allocate)
+		CAPTURE_ASSET(Texture_Load)
+		#undef CAPTURE_ASSET
+		default: return false;
+	}
+}
+
+// mirrors the allocations of the streams, then frees the leftovers, users before what they use
+static void impl_capture_release_stream(struct Rendering_Capture * capture) {
+	static struct {
+		u32 allocate, free;
+	} const kinds[] = {
+		{RVM_Instruction_Bundle_Allocate,   RVM_Instruction_Bundle_Free},
+		{RVM_Instruction_Pipeline_Allocate, RVM_Instruction_Pipeline_Free},
+		{RVM_Instruction_Target_Allocate,   RVM_Instruction_Target_Free}, // frees its attachment textures too
+		{RVM_Instruction_Sampler_Allocate,  RVM_Instruction_Sampler_Free},
+		{RVM_Instruction_Texture_Allocate,  RVM_Instruction_Texture_Free},
+		{RVM_Instruction_Mesh_Allocate,     RVM_Instruction_Mesh_Free},
+		{RVM_Instruction_Shader_Allocate,   RVM_Instruction_Shader_Free},
+	};
+	enum { KINDS_COUNT = sizeof(kinds) / sizeof(*kinds) };
+
+	struct Ref_Pool * pools[KINDS_COUNT];
+	for (u32 kind_i = 0; kind_i < KINDS_COUNT; ++kind_i) { pools[kind_i] = engine_ref_pool_create(0); }
+
+	for (u32 stream_i = 0; stream_i < capture->streams_count; ++stream_i) {
+		u8 const * stream = capture->data + capture->streams[stream_i].offset;
+		size_t const stream_length = capture->streams[stream_i].length;
+		for (size_t offset = 0; stream_length - offset >= sizeof(struct RVM_Header);) {
+			struct RVM_Header header;
+			memcpy(&header, stream + offset, sizeof(header));
+			if (header.size > stream_length - offset - sizeof(header)) { break; }
+
+			// every allocation and free payload starts with its ref
+			if (header.size >= sizeof(struct Ref)) {
+				struct Ref ref;
+				memcpy(&ref, stream + offset + sizeof(header), sizeof(ref));
+				for (u32 kind_i = 0; kind_i < KINDS_COUNT; ++kind_i) {
+					if (header.instruction == kinds[kind_i].allocate) { engine_ref_pool_claim(pools[kind_i], ref); break; }
+					if (header.instruction == kinds[kind_i].free) { engine_ref_pool_release(pools[kind_i], ref); break; }
+				}
+			}
+
+			offset += sizeof(header) + header.size;
+		}
+	}
+
+	u32 count = 0;
+	for (u32 kind_i = 0; kind_i < KINDS_COUNT; ++kind_i) { count += engine_ref_pool_get_count(pools[kind_i]); }
+
+	// all the free payloads are a bare ref
+	size_t const instruction_size = sizeof(struct RVM_Header) + RVM_PAYLOAD_SIZE(Shader_Free);
+	capture->release_length = count * instruction_size;
+	capture->release = count ? ENGINE_MALLOC(capture->release_length) : NULL;
+
+	u8 * target = capture->release;
+	for (u32 kind_i = 0; kind_i < KINDS_COUNT; ++kind_i) {
+		u32 const refs_count = engine_ref_pool_get_count(pools[kind_i]);
+		for (u32 ref_i = 0; ref_i < refs_count; ++ref_i) {
+			struct RVM_Header const header = {
+				.instruction = kinds[kind_i].free,
+				.size = RVM_PAYLOAD_SIZE(Shader_Free),
+			};
+			struct Ref const ref = engine_ref_pool_get_ref(pools[kind_i], ref_i);
+			memset(target, 0, instruction_size);
+			memcpy(target, &header, sizeof(header));
+			memcpy(target + sizeof(header), &ref, sizeof(ref));
+			target += instruction_size;
+		}
+		engine_ref_pool_destroy(pools[kind_i]);
+	}
+}
+
+//
+#undef CAPTURE_MAGIC
+#undef CAPTURE_VERSION
@@ -0,0 +1,464 @@
+#include "engine/api/code.h"
+#include "engine/api/ref_pool.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+#include "engine/api/rendering_graph.h"
+
+#define GRAPH_TARGET_FRAMES 4 // unused frames before a placed VM target is freed
+
+struct Graph_Target {
+	struct Rendering_Graph_Target desc; // unused attachments are zeroed
+	struct Ref ref;                     // of an imported one
+	bool imported, needed;
+	u32 first, last; // positions of its passes in the order
+	u32 placed;      // index of its VM target
+};
+
+struct Graph_Pass {
+	u32 target;
+	Rendering_Graph_Pass * callback; void * context;
+	bool keep, live, scheduled;
+};
+
+struct Graph_Read {
+	u32 pass, target;
+};
+
+// a VM target, kept across frames
+struct Graph_Placed {
+	struct Rendering_Graph_Target desc;
+	struct Ref ref, textures[RVM_TARGET_ATTACHMENTS];
+	u32 busy_until;  // position of the last pass drawing into it this frame, `RENDERING_GRAPH_NONE` when free
+	u32 idle_frames;
+	bool allocate, load; // pending emission
+};
+
+static bool impl_graph_live(struct Rendering_Graph * graph);
+static void impl_graph_order(struct Rendering_Graph * graph);
+static void impl_graph_place(struct Rendering_Graph * graph);
+static void impl_graph_emit_targets(struct Rendering_Graph * graph, struct Rendering_Buffer * buffer);
+static void impl_graph_free_placed(struct Rendering_Graph * graph, u32 index, struct Rendering_Buffer * buffer);
+static u64 impl_graph_bytes(struct Rendering_Graph_Target const * desc);
+
+//
+// API
+//
+
+struct Rendering_Graph {
+	struct Ref_Pool * target_refs, * texture_refs;
+	struct Graph_Target * targets; u32 targets_count, targets_capacity;
+	struct Graph_Pass * passes;    u32 passes_count, passes_capacity;
+	struct Graph_Read * reads;     u32 reads_count, reads_capacity;
+	struct Graph_Placed * placed;  u32 placed_count, placed_capacity;
+	u32 * order; u32 order_count, order_capacity; // live passes
+	bool flushing;
+	struct Rendering_Graph_Stats stats;
+};
+
+struct Rendering_Graph * engine_rendering_graph_create(struct Ref_Pool * targets, struct Ref_Pool * textures) {
+	struct Rendering_Graph * graph = ENGINE_MALLOC(sizeof(*graph));
+	memset(graph, 0, sizeof(*graph));
+	graph->target_refs = targets;
+	graph->texture_refs = textures;
+	return graph;
+}
+
+void engine_rendering_graph_destroy(struct Rendering_Graph * graph) {
+	// the refs of the kept VM targets are released, `release` is expected to have emitted their frees
+	for (u32 i = 0; i < graph->placed_count; ++i) { impl_graph_free_placed(graph, i, NULL); }
+	ENGINE_FREE(graph->targets);
+	ENGINE_FREE(graph->passes);
+	ENGINE_FREE(graph->reads);
+	ENGINE_FREE(graph->placed);
+	ENGINE_FREE(graph->order);
+	ENGINE_FREE(graph);
+}
+
+void engine_rendering_graph_reset(struct Rendering_Graph * graph) {
+	graph->targets_count = 0;
+	graph->passes_count = 0;
+	graph->reads_count = 0;
+	graph->order_count = 0;
+}
+
+#define GRAPH_GROW(array, count, capacity, initial) do { \
+	if ((count) < (capacity)) { break; } \
+	u32 const grown = (capacity) ? (capacity) * 2 : (initial); \
+	void * block = ENGINE_REALLOC(array, grown * sizeof(*(array))); \
+	if (!block) { ENGINE_DEBUG_BREAK(); break; } \
+	(array) = block; (capacity) = grown; \
+} while (false)
+
+u32 engine_rendering_graph_create_target(struct Rendering_Graph * graph, struct Rendering_Graph_Target const * desc) {
+	if (desc->count == 0 || desc->count > RVM_TARGET_ATTACHMENTS) { ENGINE_DEBUG_BREAK(); return RENDERING_GRAPH_NONE; }
+	GRAPH_GROW(graph->targets, graph->targets_count, graph->targets_capacity, 16);
+	if (graph->targets_count == graph->targets_capacity) { return RENDERING_GRAPH_NONE; }
+
+	// equal descriptions compare as bytes
+	struct Graph_Target * target = graph->targets + graph->targets_count;
+	memset(target, 0, sizeof(*target));
+	target->desc.size = desc->size;
+	target->desc.samples = desc->samples;
+	target->desc.count = desc->count;
+	for (u32 i = 0; i < desc->count; ++i) {
+		struct Rendering_Graph_Attachment const * attachment = desc->attachments + i;
+		target->desc.attachments[i].kind = attachment->kind;
+		target->desc.attachments[i].type = attachment->type;
+		target->desc.attachments[i].channels = attachment->channels;
+		target->desc.attachments[i].sampled = attachment->sampled;
+	}
+	target->ref = (struct Ref){.id = REF_EMPTY_ID};
+	target->placed = RENDERING_GRAPH_NONE;
+	return graph->targets_count++;
+}
+
+u32 engine_rendering_graph_import_target(struct Rendering_Graph * graph, struct Ref ref) {
+	GRAPH_GROW(graph->targets, graph->targets_count, graph->targets_capacity, 16);
+	if (graph->targets_count == graph->targets_capacity) { return RENDERING_GRAPH_NONE; }
+
+	struct Graph_Target * target = graph->targets + graph->targets_count;
+	memset(target, 0, sizeof(*target));
+	target->ref = ref;
+	target->imported = true;
+	target->placed = RENDERING_GRAPH_NONE;
+	return graph->targets_count++;
+}
+
+u32 engine_rendering_graph_add_pass(struct Rendering_Graph * graph, u32 target, Rendering_Graph_Pass * callback, void * context) {
+	if (target != RENDERING_GRAPH_NONE && target >= graph->targets_count) { ENGINE_DEBUG_BREAK(); return RENDERING_GRAPH_NONE; }
+	GRAPH_GROW(graph->passes, graph->passes_count, graph->passes_capacity, 16);
+	if (graph->passes_count == graph->passes_capacity) { return RENDERING_GRAPH_NONE; }
+
+	graph->passes[graph->passes_count] = (struct Graph_Pass){
+		.target = target,
+		.callback = callback, .context = context,
+	};
+	return graph->passes_count++;
+}
+
+void engine_rendering_graph_read(struct Rendering_Graph * graph, u32 pass, u32 target) {
+	if (pass >= graph->passes_count || target >= graph->targets_count) { ENGINE_DEBUG_BREAK(); return; }
+	GRAPH_GROW(graph->reads, graph->reads_count, graph->reads_capacity, 32);
+	if (graph->reads_count == graph->reads_capacity) { return; }
+	graph->reads[graph->reads_count++] = (struct Graph_Read){.pass = pass, .target = target};
+}
+
+void engine_rendering_graph_keep(struct Rendering_Graph * graph, u32 pass) {
+	if (pass >= graph->passes_count) { ENGINE_DEBUG_BREAK(); return; }
+	graph->passes[pass].keep = true;
+}
+
+struct Ref engine_rendering_graph_get_texture(struct Rendering_Graph const * graph, u32 target, u32 attachment) {
+	if (target >= graph->targets_count || attachment >= RVM_TARGET_ATTACHMENTS) { return (struct Ref){.id = REF_EMPTY_ID}; }
+	struct Graph_Target const * entry = graph->targets + target;
+	if (entry->imported || !graph->flushing || entry->placed == RENDERING_GRAPH_NONE) { return (struct Ref){.id = REF_EMPTY_ID}; }
+	return graph->placed[entry->placed].textures[attachment];
+}
+
+void engine_rendering_graph_flush(struct Rendering_Graph * graph, struct Rendering_Buffer * buffer) {
+	memset(&graph->stats, 0, sizeof(graph->stats));
+	for (u32 i = 0; i < graph->placed_count; ++i) {
+		graph->placed[i].busy_until = RENDERING_GRAPH_NONE;
+	}
+	if (impl_graph_live(graph)) {
+		impl_graph_order(graph);
+		impl_graph_place(graph);
+	}
+	impl_graph_emit_targets(graph, buffer);
+
+	// the passes switch targets only when they differ
+	graph->flushing = true;
+	u32 current = RENDERING_GRAPH_NONE; bool window = true;
+	for (u32 i = 0; i < graph->order_count; ++i) {
+		struct Graph_Pass const * pass = graph->passes + graph->order[i];
+		if (pass->target != RENDERING_GRAPH_NONE && pass->target != current) {
+			struct Graph_Target const * target = graph->targets + pass->target;
+			if (!target->imported && target->placed == RENDERING_GRAPH_NONE) { continue; }
+			struct Ref const ref = target->imported ? target->ref : graph->placed[target->placed].ref;
+			engine_rendering_buffer_emit_Target_Use(buffer, (struct RVM_Target_Use){.ref = ref});
+			current = pass->target;
+			window = ref.id == REF_EMPTY_ID;
+		}
+		if (pass->callback) { pass->callback(graph, buffer, pass->context); }
+	}
+	graph->flushing = false;
+
+	// whatever follows draws into the window; a multisampled target is resolved on leaving it
+	if (!window) {
+		engine_rendering_buffer_emit_Target_Use(buffer, (struct RVM_Target_Use){.ref = {.id = REF_EMPTY_ID}});
+	}
+
+	graph->stats.targets_kept = graph->placed_count;
+	engine_rendering_graph_reset(graph);
+}
+
+void engine_rendering_graph_release(struct Rendering_Graph * graph, struct Rendering_Buffer * buffer) {
+	for (u32 i = 0; i < graph->placed_count; ++i) { impl_graph_free_placed(graph, i, buffer); }
+	graph->placed_count = 0;
+}
+
+struct Rendering_Graph_Stats engine_rendering_graph_get_stats(struct Rendering_Graph const * graph) {
+	return graph->stats;
+}
+
+//
+// internal implementation
+//
+
+static bool impl_graph_writes(struct Rendering_Graph const * graph, u32 pass, u32 target) {
+	return graph->passes[pass].target == target;
+}
+
+static bool impl_graph_live(struct Rendering_Graph * graph) {
+	// imported targets are needed, so are the passes writing them or kept;
+	// then anything read by a live pass, until nothing changes
+	for (u32 i = 0; i < graph->targets_count; ++i) {
+		graph->targets[i].needed = graph->targets[i].imported;
+	}
+
+	for (bool changed = true; changed;) {
+		changed = false;
+		for (u32 pass_i = 0; pass_i < graph->passes_count; ++pass_i) {
+			struct Graph_Pass * pass = graph->passes + pass_i;
+			if (pass->live) { continue; }
+			if (!pass->keep && (pass->target == RENDERING_GRAPH_NONE || !graph->targets[pass->target].needed)) { continue; }
+			pass->live = true; changed = true;
+		}
+		for (u32 i = 0; i < graph->reads_count; ++i) {
+			struct Graph_Read const * read = graph->reads + i;
+			if (!graph->passes[read->pass].live || graph->targets[read->target].needed) { continue; }
+			graph->targets[read->target].needed = true; changed = true;
+		}
+	}
+
+	graph->stats.passes = graph->passes_count;
+	for (u32 i = 0; i < graph->passes_count; ++i) {
+		if (!graph->passes[i].live) { graph->stats.passes_culled++; }
+	}
+	return graph->stats.passes_culled < graph->passes_count;
+}
+
+// whether every live writer the pass depends on is already scheduled
+static bool impl_graph_ready(struct Rendering_Graph const * graph, u32 pass_i) {
+	struct Graph_Pass const * pass = graph->passes + pass_i;
+	for (u32 i = 0; i < pass_i; ++i) {
+		struct Graph_Pass const * other = graph->passes + i;
+		if (other->live && !other->scheduled && pass->target != RENDERING_GRAPH_NONE && impl_graph_writes(graph, i, pass->target)) { return false; }
+	}
+	for (u32 read_i = 0; read_i < graph->reads_count; ++read_i) {
+		struct Graph_Read const * read = graph->reads + read_i;
+		if (read->pass != pass_i) { continue; }
+		for (u32 i = 0; i < graph->passes_count; ++i) {
+			struct Graph_Pass const * other = graph->passes + i;
+			if (i != pass_i && other->live && !other->scheduled && impl_graph_writes(graph, i, read->target)) { return false; }
+		}
+	}
+	return true;
+}
+
+static void impl_graph_order(struct Rendering_Graph * graph) {
+	if (graph->order_capacity < graph->passes_count) {
+		u32 * order = ENGINE_REALLOC(graph->order, graph->passes_count * sizeof(*order));
+		if (!order) { ENGINE_DEBUG_BREAK(); return; }
+		graph->order = order; graph->order_capacity = graph->passes_count;
+	}
+
+	// the earliest added ready pass goes next, so an already ordered graph stays as is
+	u32 const live_count = graph->passes_count - graph->stats.passes_culled;
+	while (graph->order_count < live_count) {
+		u32 next = RENDERING_GRAPH_NONE, fallback = RENDERING_GRAPH_NONE;
+		for (u32 i = 0; i < graph->passes_count; ++i) {
+			struct Graph_Pass const * pass = graph->passes + i;
+			if (!pass->live || pass->scheduled) { continue; }
+			if (fallback == RENDERING_GRAPH_NONE) { fallback = i; }
+			if (impl_graph_ready(graph, i)) { next = i; break; }
+		}
+
+		// a cycle, broken in the order of `add_pass` calls
+		if (next == RENDERING_GRAPH_NONE) { ENGINE_DEBUG_BREAK(); next = fallback; }
+
+		graph->passes[next].scheduled = true;
+		graph->order[graph->order_count++] = next;
+	}
+
+	// lifetimes span the positions of the passes touching a target
+	for (u32 i = 0; i < graph->targets_count; ++i) {
+		graph->targets[i].first = RENDERING_GRAPH_NONE;
+		graph->targets[i].last = 0;
+		graph->targets[i].placed = RENDERING_GRAPH_NONE;
+	}
+	for (u32 position = 0; position < graph->order_count; ++position) {
+		u32 const pass_i = graph->order[position];
+		u32 const target_i = graph->passes[pass_i].target;
+		if (target_i != RENDERING_GRAPH_NONE) {
+			struct Graph_Target * target = graph->targets + target_i;
+			if (target->first == RENDERING_GRAPH_NONE) { target->first = position; }
+			target->last = position;
+		}
+		for (u32 read_i = 0; read_i < graph->reads_count; ++read_i) {
+			struct Graph_Read const * read = graph->reads + read_i;
+			if (read->pass != pass_i) { continue; }
+			struct Graph_Target * target = graph->targets + read->target;
+			if (target->first == RENDERING_GRAPH_NONE) { target->first = position; }
+			target->last = position;
+		}
+	}
+}
+
+static bool impl_graph_formats_equal(struct Rendering_Graph_Target const * a, struct Rendering_Graph_Target const * b) {
+	return a->samples == b->samples && a->count == b->count
+	    && memcmp(a->attachments, b->attachments, sizeof(a->attachments)) == 0;
+}
+
+// a free VM target of the description; with `resize`, one of the formats unused this frame
+static u32 impl_graph_find_placed(struct Rendering_Graph const * graph, struct Graph_Target const * target, bool resize) {
+	for (u32 i = 0; i < graph->placed_count; ++i) {
+		struct Graph_Placed const * placed = graph->placed + i;
+		if (!impl_graph_formats_equal(&placed->desc, &target->desc)) { continue; }
+		if (resize) {
+			if (placed->busy_until == RENDERING_GRAPH_NONE) { return i; }
+			continue;
+		}
+		if (placed->desc.size.x != target->desc.size.x || placed->desc.size.y != target->desc.size.y) { continue; }
+		if (placed->busy_until == RENDERING_GRAPH_NONE || placed->busy_until < target->first) { return i; }
+	}
+	return RENDERING_GRAPH_NONE;
+}
+
+static u32 impl_graph_new_placed(struct Rendering_Graph * graph, struct Graph_Target const * target) {
+	GRAPH_GROW(graph->placed, graph->placed_count, graph->placed_capacity, 16);
+	if (graph->placed_count == graph->placed_capacity) { return RENDERING_GRAPH_NONE; }
+
+	struct Graph_Placed * placed = graph->placed + graph->placed_count;
+	memset(placed, 0, sizeof(*placed));
+	placed->desc = target->desc;
+	placed->ref = engine_ref_pool_acquire(graph->target_refs);
+	for (u32 i = 0; i < RVM_TARGET_ATTACHMENTS; ++i) {
+		bool const sampled = i < target->desc.count && target->desc.attachments[i].sampled;
+		placed->textures[i] = sampled ? engine_ref_pool_acquire(graph->texture_refs) : (struct Ref){.id = REF_EMPTY_ID};
+	}
+	placed->busy_until = RENDERING_GRAPH_NONE;
+	placed->allocate = true;
+	return graph->placed_count++;
+}
+
+static void impl_graph_place(struct Rendering_Graph * graph) {
+	// by first use, an interval colouring per description: exact matches first,
+	// then the rest resize the VM targets left unused, or take new ones
+	for (u32 stage = 0; stage < 2; ++stage) {
+		for (u32 position = 0; position < graph->order_count; ++position) {
+			for (u32 target_i = 0; target_i < graph->targets_count; ++target_i) {
+				struct Graph_Target * target = graph->targets + target_i;
+				if (target->imported || target->first != position || target->placed != RENDERING_GRAPH_NONE) { continue; }
+
+				u32 placed_i = impl_graph_find_placed(graph, target, false);
+				if (placed_i == RENDERING_GRAPH_NONE && stage == 1) {
+					placed_i = impl_graph_find_placed(graph, target, true);
+					if (placed_i != RENDERING_GRAPH_NONE) {
+						struct Graph_Placed * placed = graph->placed + placed_i;
+						placed->desc.size = target->desc.size;
+						placed->load = !placed->allocate;
+					}
+					else { placed_i = impl_graph_new_placed(graph, target); }
+				}
+				if (placed_i == RENDERING_GRAPH_NONE) { continue; }
+
+				target->placed = placed_i;
+				graph->placed[placed_i].busy_until = target->last;
+
+				graph->stats.targets++;
+				graph->stats.bytes += impl_graph_bytes(&target->desc);
+			}
+		}
+	}
+}
+
+static void impl_graph_emit_targets(struct Rendering_Graph * graph, struct Rendering_Buffer * buffer) {
+	// the ones left unused for long are freed first, then the rest are allocated or resized
+	for (u32 i = 0; i < graph->placed_count;) {
+		struct Graph_Placed * placed = graph->placed + i;
+		if (placed->busy_until == RENDERING_GRAPH_NONE) { placed->idle_frames++; }
+		else { placed->idle_frames = 0; }
+
+		if (placed->idle_frames < GRAPH_TARGET_FRAMES) { i++; continue; }
+		impl_graph_free_placed(graph, i, buffer);
+
+		// no transient target refers to it, the moved one is remapped
+		u32 const last = --graph->placed_count;
+		if (i == last) { continue; }
+		graph->placed[i] = graph->placed[last];
+		for (u32 target_i = 0; target_i < graph->targets_count; ++target_i) {
+			if (graph->targets[target_i].placed == last) { graph->targets[target_i].placed = i; }
+		}
+	}
+
+	for (u32 i = 0; i < graph->placed_count; ++i) {
+		struct Graph_Placed * placed = graph->placed + i;
+		if (placed->busy_until != RENDERING_GRAPH_NONE) {
+			graph->stats.targets_placed++;
+			graph->stats.bytes_placed += impl_graph_bytes(&placed->desc);
+		}
+
+		if (placed->allocate) {
+			struct RVM_Target_Allocate payload = {
+				.ref = placed->ref,
+				.size = placed->desc.size,
+				.samples = placed->desc.samples,
+				.count = placed->desc.count,
+			};
+			for (u32 attachment_i = 0; attachment_i < placed->desc.count; ++attachment_i) {
+				struct Rendering_Graph_Attachment const * attachment = placed->desc.attachments + attachment_i;
+				payload.attachments[attachment_i] = (struct RVM_Target_Attachment){
+					.texture = placed->textures[attachment_i],
+					.kind = attachment->kind, .type = attachment->type, .channels = attachment->channels,
+				};
+			}
+			engine_rendering_buffer_emit_Target_Allocate(buffer, payload);
+		}
+		else if (placed->load) {
+			engine_rendering_buffer_emit_Target_Load(buffer, (struct RVM_Target_Load){
+				.ref = placed->ref,
+				.size = placed->desc.size,
+			});
+		}
+		placed->allocate = false;
+		placed->load = false;
+	}
+}
+
+static void impl_graph_free_placed(struct Rendering_Graph * graph, u32 index, struct Rendering_Buffer * buffer) {
+	struct Graph_Placed const * placed = graph->placed + index;
+	// a target never emitted is to be allocated yet
+	if (buffer && !placed->allocate) {
+		engine_rendering_buffer_emit_Target_Free(buffer, (struct RVM_Target_Free){.ref = placed->ref});
+	}
+	engine_ref_pool_release(graph->target_refs, placed->ref);
+	for (u32 i = 0; i < RVM_TARGET_ATTACHMENTS; ++i) {
+		if (placed->textures[i].id == REF_EMPTY_ID) { continue; }
+		engine_ref_pool_release(graph->texture_refs, placed->textures[i]);
+	}
+}
+
+static u64 impl_graph_bytes(struct Rendering_Graph_Target const * desc) {
+	u64 const texels = (u64)desc->size.x * (u64)desc->size.y * (desc->samples ? desc->samples : 1);
+	u64 bytes = 0;
+	for (u32 i = 0; i < desc->count; ++i) {
+		struct Rendering_Graph_Attachment const * attachment = desc->attachments + i;
+		u32 texel_size;
+		switch (attachment->kind) {
+			case Texture_Type_Color: {
+				u32 const channel_size = (attachment->type == Data_Type_u8 || attachment->type == Data_Type_s8) ? 1
+				                       : (attachment->type == Data_Type_u16 || attachment->type == Data_Type_s16) ? 2 : 4;
+				texel_size = channel_size * (attachment->channels ? attachment->channels : 1);
+			} break;
+			case Texture_Type_Stencil: texel_size = 1; break;
+			default: texel_size = 4; break;
+		}
+		bytes += texels * texel_size;
+	}
+	return bytes;
+}
+
+//
+#undef GRAPH_GROW
+#undef GRAPH_TARGET_FRAMES
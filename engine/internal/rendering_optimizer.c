@@ -0,0 +1,203 @@
+#include "engine/api/code.h"
+#include "engine/api/rendering_vm.h"
+
+#include <string.h>
+
+// how an instruction takes part in the pass
+enum Optimizer_Class {
+	Optimizer_Class_Barrier, // flushes and forgets the state, e.g. resources and pipelines
+	Optimizer_Class_State,   // held until consumed
+	Optimizer_Class_Draw,    // consumes the state
+	Optimizer_Class_Clear,   // consumes the state, merges with the previous clear
+	Optimizer_Class_Pass,    // independent of the held state, goes through as is
+};
+
+struct Optimizer_Context {
+	u8 * output; size_t length; u32 count;
+	struct RVM_Header const * pending[RVM_Instruction_Count]; // held, not consumed yet
+	struct RVM_Header const * current[RVM_Instruction_Count]; // flushed, in effect
+	u32 pending_index[RVM_Instruction_Count]; // input indices of the held ones
+	size_t clear; u32 clear_index; // output offset and index of the last instruction if it is a `Render_Clear`, `SIZE_MAX` otherwise
+	struct Rendering_Optimizer_Report * report;
+	struct Rendering_Optimizer_Slots * slots;
+};
+
+static u32 const optimizer_payload_sizes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_PAYLOAD_SIZE(name),
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static enum Optimizer_Class impl_optimizer_class(enum RVM_Instruction instruction);
+static void impl_optimizer_emit(struct Optimizer_Context * context, struct RVM_Header const * header, u32 index);
+static void impl_optimizer_map(struct Optimizer_Context * context, u32 index, u32 output_index);
+static void impl_optimizer_flush(struct Optimizer_Context * context);
+static bool impl_optimizer_equal(struct RVM_Header const * a, struct RVM_Header const * b);
+
+//
+// API
+//
+
+#include "engine/api/rendering_optimizer.h"
+
+size_t engine_rendering_optimizer_run(u8 const * buffer, size_t length, u8 * output, struct Rendering_Optimizer_Report * report, struct Rendering_Optimizer_Slots * slots) {
+	struct Optimizer_Context context = {
+		.output = output,
+		.clear = SIZE_MAX,
+		.report = report,
+		.slots = slots,
+	};
+
+	size_t offset = 0; u32 keep_i = 0;
+	for (u32 index = 0; length - offset >= sizeof(struct RVM_Header); ++index) {
+		struct RVM_Header const * header = (void const *)(buffer + offset);
+		if (header->instruction >= RVM_Instruction_Count) { break; }
+		if (header->size % RVM_ALIGNMENT) { break; }
+		if (header->size < optimizer_payload_sizes[header->instruction]) { break; }
+		if (header->size > length - offset - sizeof(*header)) { break; }
+
+		enum RVM_Instruction const instruction = (enum RVM_Instruction)header->instruction;
+		report->instructions_in++;
+		report->bytes_in += sizeof(*header) + header->size;
+		offset += sizeof(*header) + header->size;
+
+		// a kept one may be patched later, its effect is unknown
+		if (slots && keep_i < slots->keep_count && slots->keep[keep_i] == index) {
+			keep_i++;
+			impl_optimizer_flush(&context);
+			impl_optimizer_emit(&context, header, index);
+			memset(context.current, 0, sizeof(context.current));
+			context.clear = SIZE_MAX;
+			continue;
+		}
+
+		switch (impl_optimizer_class(instruction)) {
+			case Optimizer_Class_Barrier: {
+				impl_optimizer_flush(&context);
+				impl_optimizer_emit(&context, header, index);
+				memset(context.current, 0, sizeof(context.current));
+			} break;
+
+			case Optimizer_Class_State: {
+				// an overwritten setting is dead, a repeated one is redundant
+				struct RVM_Header const ** pending = context.pending + instruction;
+				if (*pending) { report->removed[instruction]++; *pending = NULL; }
+				impl_optimizer_map(&context, index, UINT32_MAX);
+
+				struct RVM_Header const * current = context.current[instruction];
+				if (current && impl_optimizer_equal(current, header)) { report->removed[instruction]++; }
+				else { *pending = header; context.pending_index[instruction] = index; }
+			} break;
+
+			case Optimizer_Class_Draw: {
+				impl_optimizer_flush(&context);
+				impl_optimizer_emit(&context, header, index);
+			} break;
+
+			case Optimizer_Class_Clear: {
+				impl_optimizer_flush(&context);
+				if (context.clear == SIZE_MAX) { impl_optimizer_emit(&context, header, index); break; }
+
+				// nothing went in between, the masks are combined
+				struct RVM_Render_Clear merged, next;
+				u8 * target = context.output + context.clear + sizeof(*header);
+				memcpy(&merged, target, sizeof(merged));
+				memcpy(&next, header + 1, sizeof(next));
+				merged.mask = (enum RVM_Clear)(merged.mask | next.mask);
+				memcpy(target, &merged, sizeof(merged));
+				impl_optimizer_map(&context, index, context.clear_index);
+				report->removed[instruction]++;
+			} break;
+
+			case Optimizer_Class_Pass: {
+				impl_optimizer_emit(&context, header, index);
+			} break;
+		}
+	}
+	impl_optimizer_flush(&context);
+
+	// a malformed tail
+	if (offset < length) {
+		memcpy(context.output + context.length, buffer + offset, length - offset);
+		context.length += length - offset;
+		report->bytes_in += length - offset;
+		report->bytes_out += length - offset;
+	}
+
+	return context.length;
+}
+
+//
+// internal implementation
+//
+
+static enum Optimizer_Class impl_optimizer_class(enum RVM_Instruction instruction) {
+	switch (instruction) {
+		case RVM_Instruction_Common_Set_Clip:
+		case RVM_Instruction_Common_Set_Viewport:
+		case RVM_Instruction_Color_Set_Write:
+		case RVM_Instruction_Color_Set_Clear:
+		case RVM_Instruction_Color_Set_Blend:
+		case RVM_Instruction_Depth_Set_Read:
+		case RVM_Instruction_Depth_Set_Write:
+		case RVM_Instruction_Depth_Set_Clear:
+		case RVM_Instruction_Depth_Set_Comparison:
+		case RVM_Instruction_Depth_Set_Range:
+		case RVM_Instruction_Stencil_Set_Read:
+		case RVM_Instruction_Stencil_Set_Write:
+		case RVM_Instruction_Stencil_Set_Clear:
+		case RVM_Instruction_Stencil_Set_Comparison:
+		case RVM_Instruction_Stencil_Set_Operation:
+		case RVM_Instruction_Face_Set_Cull:
+		case RVM_Instruction_Face_Set_Front:
+		case RVM_Instruction_Shader_Use:
+		case RVM_Instruction_Mesh_Use:
+			return Optimizer_Class_State;
+
+		case RVM_Instruction_Render_Draw:
+		case RVM_Instruction_Render_Draw_Instanced:
+		case RVM_Instruction_Render_Draw_Indirect:
+			return Optimizer_Class_Draw;
+
+		case RVM_Instruction_Render_Clear:
+			return Optimizer_Class_Clear;
+
+		// uniforms are addressed by shader, units are not part of the tracked state
+		case RVM_Instruction_Shader_Uniform:
+		case RVM_Instruction_Unit_Allocate:
+		case RVM_Instruction_Unit_Free:
+		case RVM_Instruction_Sampler_Use:
+			return Optimizer_Class_Pass;
+
+		default: return Optimizer_Class_Barrier;
+	}
+}
+
+static void impl_optimizer_emit(struct Optimizer_Context * context, struct RVM_Header const * header, u32 index) {
+	size_t const size = sizeof(*header) + header->size;
+	context->clear = (header->instruction == RVM_Instruction_Render_Clear) ? context->length : SIZE_MAX;
+	context->clear_index = context->count;
+	impl_optimizer_map(context, index, context->count++);
+	memcpy(context->output + context->length, header, size);
+	context->length += size;
+	context->report->instructions_out++;
+	context->report->bytes_out += size;
+}
+
+static void impl_optimizer_map(struct Optimizer_Context * context, u32 index, u32 output_index) {
+	struct Rendering_Optimizer_Slots const * slots = context->slots;
+	if (slots && slots->map && index < slots->map_capacity) { slots->map[index] = output_index; }
+}
+
+static void impl_optimizer_flush(struct Optimizer_Context * context) {
+	for (u32 i = 0; i < RVM_Instruction_Count; ++i) {
+		struct RVM_Header const * header = context->pending[i];
+		if (!header) { continue; }
+		impl_optimizer_emit(context, header, context->pending_index[i]);
+		context->current[i] = header;
+		context->pending[i] = NULL;
+	}
+}
+
+static bool impl_optimizer_equal(struct RVM_Header const * a, struct RVM_Header const * b) {
+	return a->size == b->size && memcmp(a + 1, b + 1, a->size) == 0;
+}
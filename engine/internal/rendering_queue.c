@@ -0,0 +1,241 @@
+#include "engine/api/code.h"
+#include "engine/api/maths.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+
+// key layout, from the most significant bits
+// - opaque:      layer:8 | translucent:1 | shader:12 | texture:12 | mesh:12 | depth:19
+// - translucent: layer:8 | translucent:1 | inverse depth:19 | shader:12 | texture:12 | mesh:12
+#define QUEUE_KEY_LAYER_SHIFT       56
+#define QUEUE_KEY_TRANSLUCENT_SHIFT 55
+#define QUEUE_KEY_ID_BITS    12
+#define QUEUE_KEY_DEPTH_BITS 19
+#define QUEUE_KEY_MASK(bits) (((u64)1 << (bits)) - 1)
+
+struct Queue_Entry {
+	u64 key;
+	u32 index;
+};
+
+struct Rendering_Queue_Draw;
+struct Rendering_Queue;
+static struct Queue_Entry const * impl_queue_sort(struct Queue_Entry * entries, struct Queue_Entry * scratch, u32 count);
+static void impl_queue_emit(struct Rendering_Queue * queue, struct Queue_Entry const * entries, struct Rendering_Buffer * buffer);
+
+//
+// API
+//
+
+#include "engine/api/rendering_queue.h"
+
+struct Rendering_Queue {
+	struct Rendering_Queue_Draw * draws;
+	struct Queue_Entry * entries, * scratch;
+	struct RVM_Render_Draw * ranges;
+	struct RVM_Draw_Arguments * arguments;
+	u32 count, capacity;
+};
+
+struct Rendering_Queue * engine_rendering_queue_create(void) {
+	struct Rendering_Queue * queue = ENGINE_MALLOC(sizeof(*queue));
+	memset(queue, 0, sizeof(*queue));
+	return queue;
+}
+
+void engine_rendering_queue_destroy(struct Rendering_Queue * queue) {
+	ENGINE_FREE(queue->draws);
+	ENGINE_FREE(queue->entries);
+	ENGINE_FREE(queue->scratch);
+	ENGINE_FREE(queue->ranges);
+	ENGINE_FREE(queue->arguments);
+	ENGINE_FREE(queue);
+}
+
+void engine_rendering_queue_reset(struct Rendering_Queue * queue) {
+	queue->count = 0;
+}
+
+void engine_rendering_queue_push(struct Rendering_Queue * queue, struct Rendering_Queue_Draw const * draw) {
+	if (queue->count == queue->capacity) {
+		u32 capacity = queue->capacity ? queue->capacity * 2 : 256;
+		struct Rendering_Queue_Draw * draws = ENGINE_REALLOC(queue->draws, capacity * sizeof(*draws));
+		struct Queue_Entry * entries = ENGINE_REALLOC(queue->entries, capacity * sizeof(*entries));
+		struct Queue_Entry * scratch = ENGINE_REALLOC(queue->scratch, capacity * sizeof(*scratch));
+		struct RVM_Render_Draw * ranges = ENGINE_REALLOC(queue->ranges, capacity * sizeof(*ranges));
+		struct RVM_Draw_Arguments * arguments = ENGINE_REALLOC(queue->arguments, capacity * sizeof(*arguments));
+		if (draws)     { queue->draws     = draws; }
+		if (entries)   { queue->entries   = entries; }
+		if (scratch)   { queue->scratch   = scratch; }
+		if (ranges)    { queue->ranges    = ranges; }
+		if (arguments) { queue->arguments = arguments; }
+		if (!draws || !entries || !scratch || !ranges || !arguments) { ENGINE_DEBUG_BREAK(); return; }
+
+		queue->capacity = capacity;
+	}
+
+	queue->draws[queue->count++] = *draw;
+}
+
+void engine_rendering_queue_flush(struct Rendering_Queue * queue, struct Rendering_Buffer * buffer) {
+	for (u32 i = 0; i < queue->count; ++i) {
+		queue->entries[i] = (struct Queue_Entry){
+			.key = engine_rendering_queue_get_key(queue->draws + i),
+			.index = i,
+		};
+	}
+
+	struct Queue_Entry const * sorted = impl_queue_sort(queue->entries, queue->scratch, queue->count);
+	impl_queue_emit(queue, sorted, buffer);
+
+	queue->count = 0;
+}
+
+u64 engine_rendering_queue_get_key(struct Rendering_Queue_Draw const * draw) {
+	u64 const id_mask = QUEUE_KEY_MASK(QUEUE_KEY_ID_BITS);
+	u64 const depth_mask = QUEUE_KEY_MASK(QUEUE_KEY_DEPTH_BITS);
+
+	bool const translucent = draw->blend != RVM_Color_Blend_Opaque;
+	u64 const depth = (u64)(clamp_r32(draw->depth, 0, 1) * (r32)depth_mask);
+	u64 const material = ((draw->shader.id  & id_mask) << (QUEUE_KEY_ID_BITS * 2))
+	                   | ((draw->texture.id & id_mask) << (QUEUE_KEY_ID_BITS * 1))
+	                   | ((draw->mesh.id    & id_mask));
+
+	u64 key = ((u64)draw->layer << QUEUE_KEY_LAYER_SHIFT)
+	        | ((u64)translucent << QUEUE_KEY_TRANSLUCENT_SHIFT);
+
+	if (translucent) {
+		key |= (depth_mask - depth) << (QUEUE_KEY_ID_BITS * 3);
+		key |= material;
+	}
+	else {
+		key |= material << QUEUE_KEY_DEPTH_BITS;
+		key |= depth;
+	}
+
+	return key;
+}
+
+//
+// internal implementation
+//
+
+static struct Queue_Entry const * impl_queue_sort(struct Queue_Entry * entries, struct Queue_Entry * scratch, u32 count) {
+	// least significant digit first, stable
+	struct Queue_Entry * source = entries;
+	struct Queue_Entry * target = scratch;
+	for (u32 shift = 0; shift < 64; shift += 8) {
+		u32 offsets[256];
+		memset(offsets, 0, sizeof(offsets));
+		for (u32 i = 0; i < count; ++i) {
+			offsets[(source[i].key >> shift) & 0xff]++;
+		}
+
+		// all the keys share the digit, the pass changes nothing
+		if (!count || offsets[(source[0].key >> shift) & 0xff] == count) { continue; }
+
+		u32 sum = 0;
+		for (u32 i = 0; i < 256; ++i) {
+			u32 digit_count = offsets[i];
+			offsets[i] = sum;
+			sum += digit_count;
+		}
+
+		for (u32 i = 0; i < count; ++i) {
+			target[offsets[(source[i].key >> shift) & 0xff]++] = source[i];
+		}
+
+		struct Queue_Entry * swap = source;
+		source = target; target = swap;
+	}
+	return source;
+}
+
+static bool impl_queue_ref_equals(struct Ref v1, struct Ref v2) {
+	return v1.id == v2.id && v1.gen == v2.gen;
+}
+
+static bool impl_queue_state_equals(struct Rendering_Queue_Draw const * v1, struct Rendering_Queue_Draw const * v2) {
+	return v1->blend == v2->blend
+	    && v1->depth_read == v2->depth_read && v1->depth_write == v2->depth_write
+	    && v1->cull == v2->cull
+	    && impl_queue_ref_equals(v1->shader, v2->shader)
+	    && impl_queue_ref_equals(v1->texture, v2->texture)
+	    && impl_queue_ref_equals(v1->mesh, v2->mesh);
+}
+
+static void impl_queue_emit(struct Rendering_Queue * queue, struct Queue_Entry const * entries, struct Rendering_Buffer * buffer) {
+	struct Rendering_Queue_Draw const * draws = queue->draws;
+	struct Rendering_Queue_Draw const * previous = NULL;
+	for (u32 i = 0; i < queue->count; ++i) {
+		struct Rendering_Queue_Draw const * draw = draws + entries[i].index;
+
+		if (!previous || previous->blend != draw->blend) {
+			engine_rendering_buffer_emit_Color_Set_Blend(buffer, (struct RVM_Color_Set_Blend){
+				.value = draw->blend,
+			});
+		}
+
+		if (!previous || previous->depth_read != draw->depth_read) {
+			engine_rendering_buffer_emit_Depth_Set_Read(buffer, (struct RVM_Depth_Set_Read){
+				.value = draw->depth_read,
+			});
+		}
+
+		if (!previous || previous->depth_write != draw->depth_write) {
+			engine_rendering_buffer_emit_Depth_Set_Write(buffer, (struct RVM_Depth_Set_Write){
+				.value = draw->depth_write,
+			});
+		}
+
+		if (!previous || previous->cull != draw->cull) {
+			engine_rendering_buffer_emit_Face_Set_Cull(buffer, (struct RVM_Face_Set_Cull){
+				.value = draw->cull,
+			});
+		}
+
+		if (!previous || !impl_queue_ref_equals(previous->shader, draw->shader)) {
+			engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){
+				.ref = draw->shader,
+			});
+		}
+
+		if (!previous || !impl_queue_ref_equals(previous->texture, draw->texture)) {
+			engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){
+				.unit = 0, .texture = draw->texture,
+			});
+		}
+
+		if (!previous || !impl_queue_ref_equals(previous->mesh, draw->mesh)) {
+			engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){
+				.ref = draw->mesh,
+			});
+		}
+
+		// a run of draws that differ in range alone goes as a single multi-draw
+		u32 ranges_count = 0;
+		queue->ranges[ranges_count++] = draw->draw;
+		while (i + 1 < queue->count && impl_queue_state_equals(draw, draws + entries[i + 1].index)) {
+			queue->ranges[ranges_count++] = draws[entries[++i].index].draw;
+		}
+
+		u32 const arguments_count = engine_rendering_buffer_fill_draws(queue->arguments, queue->ranges, ranges_count);
+		if (arguments_count == 1) {
+			engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){
+				.offset = queue->arguments[0].offset, .length = queue->arguments[0].length,
+			});
+		}
+		else if (arguments_count > 1) {
+			engine_rendering_buffer_emit_draws(buffer, (struct RVM_Render_Draw_Indirect){
+				.instances = {.id = REF_EMPTY_ID}, .count = arguments_count,
+			}, queue->arguments);
+		}
+		previous = draw;
+	}
+}
+
+//
+#undef QUEUE_KEY_LAYER_SHIFT
+#undef QUEUE_KEY_TRANSLUCENT_SHIFT
+#undef QUEUE_KEY_ID_BITS
+#undef QUEUE_KEY_DEPTH_BITS
+#undef QUEUE_KEY_MASK
@@ -0,0 +1,142 @@
+#include "engine/api/code.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+#include "engine/api/rendering_batch.h"
+#include "engine/api/rendering_capture.h"
+#include "engine/api/platform_thread.h"
+#include "engine/api/platform_window.h"
+
+struct Rendering_Thread_Frame {
+	struct Rendering_Buffer * buffer;
+	cstring capture_path;
+	bool capture_toggle, stop;
+};
+
+static void impl_rendering_thread_proc(void * data);
+
+//
+// API
+//
+
+#include "engine/api/rendering_thread.h"
+
+// a single producer, single consumer ring; each side owns its index,
+// while the semaphores count the frames and order the memory accesses
+struct Rendering_Thread {
+	struct Engine_Window * window;
+	struct Engine_Thread * thread;
+	struct Engine_Semaphore * free, * ready;
+	struct Rendering_Thread_Frame frames[ENGINE_RENDERING_THREAD_FRAMES];
+	u32 head, tail;
+	bool recording;
+};
+
+struct Rendering_Thread * engine_rendering_thread_create(struct Engine_Window * window, u32 frames_in_flight) {
+	if (frames_in_flight < 1) { frames_in_flight = 1; }
+	if (frames_in_flight > ENGINE_RENDERING_THREAD_FRAMES) { frames_in_flight = ENGINE_RENDERING_THREAD_FRAMES; }
+
+	struct Rendering_Thread * thread = ENGINE_MALLOC(sizeof(*thread));
+	memset(thread, 0, sizeof(*thread));
+	thread->window = window;
+
+	for (u32 i = 0; i < ENGINE_RENDERING_THREAD_FRAMES; ++i) {
+		thread->frames[i].buffer = engine_rendering_buffer_create(ENGINE_RENDERING_BUFFER_CHUNK_SIZE);
+	}
+
+	thread->free  = engine_semaphore_create(frames_in_flight);
+	thread->ready = engine_semaphore_create(0);
+	thread->thread = engine_thread_create(impl_rendering_thread_proc, thread);
+
+	if (!thread->thread) {
+		engine_semaphore_destroy(thread->free);
+		engine_semaphore_destroy(thread->ready);
+		for (u32 i = 0; i < ENGINE_RENDERING_THREAD_FRAMES; ++i) {
+			engine_rendering_buffer_destroy(thread->frames[i].buffer);
+		}
+		ENGINE_FREE(thread); return NULL;
+	}
+
+	return thread;
+}
+
+void engine_rendering_thread_destroy(struct Rendering_Thread * thread) {
+	if (thread->recording) { engine_rendering_thread_end_frame(thread); }
+
+	engine_rendering_thread_begin_frame(thread);
+	thread->frames[thread->head % ENGINE_RENDERING_THREAD_FRAMES].stop = true;
+	engine_rendering_thread_end_frame(thread);
+
+	engine_thread_join(thread->thread);
+	engine_semaphore_destroy(thread->free);
+	engine_semaphore_destroy(thread->ready);
+
+	for (u32 i = 0; i < ENGINE_RENDERING_THREAD_FRAMES; ++i) {
+		engine_rendering_buffer_destroy(thread->frames[i].buffer);
+	}
+	ENGINE_FREE(thread);
+}
+
+struct Rendering_Buffer * engine_rendering_thread_begin_frame(struct Rendering_Thread * thread) {
+	struct Rendering_Thread_Frame * frame = thread->frames + thread->head % ENGINE_RENDERING_THREAD_FRAMES;
+	if (thread->recording) { return frame->buffer; }
+
+	engine_semaphore_wait(thread->free);
+	thread->recording = true;
+	return frame->buffer;
+}
+
+void engine_rendering_thread_end_frame(struct Rendering_Thread * thread) {
+	if (!thread->recording) { return; }
+	thread->recording = false;
+	thread->head++;
+	engine_semaphore_signal(thread->ready);
+}
+
+void engine_rendering_thread_toggle_capture(struct Rendering_Thread * thread, cstring path) {
+	engine_rendering_thread_begin_frame(thread);
+	struct Rendering_Thread_Frame * frame = thread->frames + thread->head % ENGINE_RENDERING_THREAD_FRAMES;
+	frame->capture_toggle = !frame->capture_toggle;
+	frame->capture_path = path;
+}
+
+//
+// internal implementation
+//
+
+static void impl_rendering_thread_proc(void * data) {
+	struct Rendering_Thread * thread = data;
+	struct Rendering_Batch * batch = engine_rendering_batch_create();
+
+	if (thread->window) { engine_window_init_context(thread->window); }
+	engine_rendering_vm_init();
+
+	for (;;) {
+		engine_semaphore_wait(thread->ready);
+		struct Rendering_Thread_Frame * frame = thread->frames + thread->tail % ENGINE_RENDERING_THREAD_FRAMES;
+		if (frame->stop) { break; }
+
+		if (frame->capture_toggle) {
+			if (engine_rendering_capture_is_active()) { engine_rendering_capture_end(); }
+			else { engine_rendering_capture_begin(frame->capture_path); }
+		}
+
+		engine_rendering_batch_add(batch, frame->buffer);
+		engine_rendering_batch_submit(batch);
+		engine_rendering_batch_reset(batch);
+		engine_rendering_vm_end_frame();
+		engine_rendering_capture_frame();
+
+		if (thread->window) { engine_window_display(thread->window); }
+
+		engine_rendering_buffer_reset(frame->buffer);
+		frame->capture_toggle = false;
+		thread->tail++;
+		engine_semaphore_signal(thread->free);
+	}
+
+	engine_rendering_capture_end();
+	engine_rendering_vm_deinit();
+	if (thread->window) { engine_window_deinit_context(thread->window); }
+
+	engine_rendering_batch_destroy(batch);
+}
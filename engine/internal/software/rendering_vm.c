@@ -0,0 +1,1953 @@
+#include "engine/api/code.h"
+#include "engine/api/ref_pool.h"
+#include "engine/api/maths.h"
+#include "engine/api/asset_types.h"
+#include "engine/api/graphics_types.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_capture.h"
+#include "engine/api/rendering_software.h"
+#include "engine/api/platform_thread.h"
+
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFTWARE_SSE2
+#endif // SSE2
+
+#define VM_TEXTURE_UNITS 16
+#define SOFTWARE_TILE_SIZE 64
+#define SOFTWARE_UNIFORM_WORDS 16 // fits a mat4
+#define SOFTWARE_TRIANGLES_MAX (1 << 14) // pending triangles before a flush
+#define SOFTWARE_CLIP_VERTICES 9 // a triangle clipped by 6 planes
+#define SOFTWARE_UV_LIMIT 65536.0f
+
+#define REGISTRY_RVM_INSTRUCTION(name, scope) static void impl_ ## name(struct RVM_ ## name const * payload);
+#include "engine/registry/rendering_vm_instruction.h"
+
+typedef void RVM_Handler(void const * payload);
+
+// payloads are aligned, so the handlers read them in place
+#define REGISTRY_RVM_INSTRUCTION(name, scope) static void impl_dispatch_ ## name(void const * payload) { impl_ ## name(payload); }
+#include "engine/registry/rendering_vm_instruction.h"
+
+static RVM_Handler * const impl_handlers[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) impl_dispatch_ ## name,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static u32 const impl_payload_sizes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_PAYLOAD_SIZE(name),
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static enum RVM_Scope const impl_scopes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_Scope_ ## scope,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+#define REGISTRY_SOFTWARE_SHADER(name) extern struct Software_Shader const software_shader_ ## name;
+#include "engine/registry/software_shader.h"
+
+static struct Software_Shader const * const impl_native_shaders[] = {
+	#define REGISTRY_SOFTWARE_SHADER(name) &software_shader_ ## name,
+	#include "engine/registry/software_shader.h"
+};
+
+// RVM values as they are, the VM has no driver to translate for
+struct VM_State {
+	bool lower_left, zero_one;
+	svec2 viewport_pos, viewport_size;
+	//
+	enum RVM_Color_Write color_write;
+	vec4 color_clear;
+	enum RVM_Color_Blend blend;
+	//
+	bool depth_test, depth_write;
+	r32 depth_clear;
+	enum RVM_Comparison depth_comparison;
+	vec2 depth_range;
+	//
+	bool stencil_test;
+	u8 stencil_write, stencil_clear;
+	enum RVM_Comparison stencil_comparison; u8 stencil_reference, stencil_mask;
+	enum RVM_Operation stencil_fail, stencil_depth_fail, stencil_depth_pass;
+	//
+	enum RVM_Face_Cull cull_mode;
+	enum RVM_Face_Front front_face;
+	//
+	struct Ref shader, mesh;
+	struct Ref textures[VM_TEXTURE_UNITS];
+	struct Ref samplers[VM_TEXTURE_UNITS]; // empty for the settings of the texture
+	struct Ref target;
+};
+
+struct VM_Shader {
+	struct Software_Shader const * native;
+	u32 uniforms_set; // a bit per `RVM_Uniform`
+	u32 uniforms[RVM_Uniform_Count][SOFTWARE_UNIFORM_WORDS];
+};
+
+struct VM_Mesh {
+	r32 * data; u32 vertices_count;
+	u32 stride, attributes_count; // in components
+	u32 offsets[ASSET_MESH_ATTRIBUTES];
+	u32 divisor, location;
+	bool transient; u32 frame; // a transient one is valid in the `frame` it is loaded only
+};
+
+struct VM_Texture {
+	vec4 * texels; svec2 size;
+	enum Filter_Type filter;
+	enum Wrap_Type wrap_x, wrap_y;
+	bool attachment; // of a target, freed along with it
+};
+
+struct VM_Pipeline {
+	struct RVM_Pipeline value;
+};
+
+// what a fresh context has, as `impl_reset_state` sets it
+static struct RVM_Pipeline const impl_pipeline_defaults = {
+	.shader = {.ref = {.id = REF_EMPTY_ID}},
+	.color_write = {.value = RVM_Color_Write_All},
+	.blend = {.value = RVM_Color_Blend_Opaque},
+	.depth_write = {.value = true},
+	.depth_comparison = {.value = RVM_Comparison_Less},
+	.stencil_write = {.value = 0xff},
+	.stencil_comparison = {.comparison = RVM_Comparison_True, .reference = 0, .mask = 0xff},
+	.cull = {.value = RVM_Face_Cull_None},
+	.front = {.value = RVM_Face_Front_CCW},
+};
+
+// a recorded instruction, `offset` is of its payload
+struct VM_Bundle_Op {
+	u32 instruction;
+	u32 offset, size;
+};
+
+// decoded operations, followed by the recorded data in the same allocation
+struct VM_Bundle {
+	struct VM_Bundle_Op * ops; u32 count;
+	u8 * data;
+};
+
+struct VM_Target {
+	svec2 size; u32 count;
+	enum Texture_Type kinds[RVM_TARGET_ATTACHMENTS];
+	struct Ref textures[RVM_TARGET_ATTACHMENTS]; // of the sampled attachments
+	u32 * colors[RVM_TARGET_ATTACHMENTS]; // of the color attachments; shaders output one color, into the first
+	r32 * depth; u8 * stencil;
+};
+
+// pixels drawn into, of the window or of a target; an absent buffer passes its test and takes no writes
+struct Software_Surface {
+	svec2 size;
+	u32 * color; r32 * depth; u8 * stencil;
+};
+
+struct VM_Sampler {
+	struct RVM_Sampler value;
+};
+
+struct Software_Sampler {
+	vec4 const * texels; svec2 size;
+	enum Filter_Type filter;
+	enum Wrap_Type wrap_x, wrap_y;
+};
+
+// the state a draw has been issued with, triangles are shaded later
+struct Software_Draw {
+	struct Software_Shader const * shader;
+	u32 uniforms_set;
+	u32 uniforms[RVM_Uniform_Count][SOFTWARE_UNIFORM_WORDS];
+	struct Software_Sampler units[VM_TEXTURE_UNITS];
+	//
+	enum RVM_Color_Write color_write;
+	enum RVM_Color_Blend blend;
+	bool depth_test, depth_write;
+	enum RVM_Comparison depth_comparison;
+	bool stencil_test;
+	u8 stencil_write;
+	enum RVM_Comparison stencil_comparison; u8 stencil_reference, stencil_mask;
+	enum RVM_Operation stencil_fail, stencil_depth_fail, stencil_depth_pass;
+};
+
+struct Software_Vertex {
+	vec4 position;
+	r32 varyings[SOFTWARE_VARYINGS_MAX];
+};
+
+// window space, counter clockwise; the edge `i` is opposite to the vertex `i`
+struct Software_Triangle {
+	u32 draw;
+	svec2 min, max; // inclusive pixels
+	r32 a[3], b[3], c[3]; bool owner[3];
+	r32 inv_area;
+	r32 z[3], inv_w[3];
+	r32 varyings[3][SOFTWARE_VARYINGS_MAX]; // divided by `w`
+};
+
+struct Software_Bin {
+	u32 * triangles; u32 count, capacity;
+};
+
+struct Software_Worker {
+	struct Engine_Thread * thread;
+	struct Engine_Semaphore * start;
+	u32 share;
+};
+
+static void impl_reset_state(struct VM_State * state, svec2 size);
+static void impl_surface_use(struct Software_Surface const * surface);
+static void impl_target_free_buffers(struct VM_Target * target);
+static void impl_flush(void);
+static void impl_worker_proc(void * data);
+
+//
+// API
+//
+
+struct Settings_Software hint_settings_software = {
+	.size = {640, 480},
+	.threads = 3,
+};
+
+struct Rendering_VM {
+	struct Ref_Pool * shaders;  // of `VM_Shader`
+	struct Ref_Pool * meshes;   // of `VM_Mesh`
+	struct Ref_Pool * textures; // of `VM_Texture`
+	struct Ref_Pool * pipelines; // of `VM_Pipeline`
+	struct Ref_Pool * bundles;   // of `VM_Bundle`
+	struct Ref_Pool * targets;   // of `VM_Target`
+	struct Ref_Pool * samplers;  // of `VM_Sampler`
+	//
+	struct VM_State state;
+	struct RVM_Stats stats;
+	u32 payload_size; // of the current instruction, with its trailing data
+	u32 frame;
+	//
+	struct Software_Surface window;
+	struct Software_Surface surface; // drawn into, the window or the current target
+	bool surface_changed; // since its target's textures were stored
+	//
+	// pending work, shaded on flush
+	struct Software_Draw * draws; u32 draws_count, draws_capacity;
+	bool draw_changed; // since the last draw snapshot
+	struct Software_Triangle * triangles; u32 triangles_count;
+	struct Software_Bin * bins; u32 bins_count; svec2 tiles; // of the surface
+
+	//
+	struct Software_Worker * workers; u32 workers_count;
+	struct Engine_Semaphore * workers_done;
+	bool workers_stop;
+};
+static struct Rendering_VM * rvm;
+
+void engine_rendering_vm_init(void) {
+	struct Rendering_VM * rendering_vm = ENGINE_MALLOC(sizeof(*rvm));
+	memset(rendering_vm, 0, sizeof(*rendering_vm));
+
+	svec2 const size = SVEC2(max_s32(hint_settings_software.size.x, 1), max_s32(hint_settings_software.size.y, 1));
+	size_t const pixels = (size_t)size.x * (size_t)size.y;
+
+	struct Software_Surface * window = &rendering_vm->window;
+	window->size = size;
+	window->color   = ENGINE_MALLOC(pixels * sizeof(*window->color));
+	window->depth   = ENGINE_MALLOC(pixels * sizeof(*window->depth));
+	window->stencil = ENGINE_MALLOC(pixels * sizeof(*window->stencil));
+	memset(window->color,   0, pixels * sizeof(*window->color));
+	memset(window->stencil, 0, pixels * sizeof(*window->stencil));
+	for (size_t i = 0; i < pixels; ++i) { window->depth[i] = 1; }
+
+	rendering_vm->triangles = ENGINE_MALLOC(SOFTWARE_TRIANGLES_MAX * sizeof(*rendering_vm->triangles));
+	rendering_vm->draw_changed = true;
+
+	impl_reset_state(&rendering_vm->state, size);
+	rendering_vm->shaders  = engine_ref_pool_create(sizeof(struct VM_Shader));
+	rendering_vm->meshes   = engine_ref_pool_create(sizeof(struct VM_Mesh));
+	rendering_vm->textures = engine_ref_pool_create(sizeof(struct VM_Texture));
+	rendering_vm->pipelines = engine_ref_pool_create(sizeof(struct VM_Pipeline));
+	rendering_vm->bundles   = engine_ref_pool_create(sizeof(struct VM_Bundle));
+	rendering_vm->targets   = engine_ref_pool_create(sizeof(struct VM_Target));
+	rendering_vm->samplers  = engine_ref_pool_create(sizeof(struct VM_Sampler));
+
+	rvm = rendering_vm;
+	impl_surface_use(&rendering_vm->window);
+
+	// workers reach the VM through `rvm`
+	rendering_vm->workers_count = hint_settings_software.threads;
+	if (rendering_vm->workers_count) {
+		rendering_vm->workers = ENGINE_MALLOC(rendering_vm->workers_count * sizeof(*rendering_vm->workers));
+		rendering_vm->workers_done = engine_semaphore_create(0);
+		for (u32 i = 0; i < rendering_vm->workers_count; ++i) {
+			struct Software_Worker * worker = rendering_vm->workers + i;
+			*worker = (struct Software_Worker){
+				.start = engine_semaphore_create(0),
+				.share = i + 1,
+			};
+			worker->thread = engine_thread_create(impl_worker_proc, worker);
+		}
+	}
+}
+
+void engine_rendering_vm_deinit(void) {
+	rvm->workers_stop = true;
+	for (u32 i = 0; i < rvm->workers_count; ++i) {
+		engine_semaphore_signal(rvm->workers[i].start);
+	}
+	for (u32 i = 0; i < rvm->workers_count; ++i) {
+		engine_thread_join(rvm->workers[i].thread);
+		engine_semaphore_destroy(rvm->workers[i].start);
+	}
+	if (rvm->workers_done) { engine_semaphore_destroy(rvm->workers_done); }
+	ENGINE_FREE(rvm->workers);
+
+	for (u32 i = 0; i < rvm->bins_count; ++i) {
+		ENGINE_FREE(rvm->bins[i].triangles);
+	}
+	ENGINE_FREE(rvm->bins);
+	ENGINE_FREE(rvm->triangles);
+	ENGINE_FREE(rvm->draws);
+
+	for (u32 i = 0, count = engine_ref_pool_get_count(rvm->meshes); i < count; ++i) {
+		struct VM_Mesh * mesh = engine_ref_pool_get(rvm->meshes, engine_ref_pool_get_ref(rvm->meshes, i));
+		ENGINE_FREE(mesh->data);
+	}
+	for (u32 i = 0, count = engine_ref_pool_get_count(rvm->textures); i < count; ++i) {
+		struct VM_Texture * texture = engine_ref_pool_get(rvm->textures, engine_ref_pool_get_ref(rvm->textures, i));
+		ENGINE_FREE(texture->texels);
+	}
+	for (u32 i = 0, count = engine_ref_pool_get_count(rvm->bundles); i < count; ++i) {
+		struct VM_Bundle * bundle = engine_ref_pool_get(rvm->bundles, engine_ref_pool_get_ref(rvm->bundles, i));
+		ENGINE_FREE(bundle->ops);
+	}
+	for (u32 i = 0, count = engine_ref_pool_get_count(rvm->targets); i < count; ++i) {
+		impl_target_free_buffers(engine_ref_pool_get(rvm->targets, engine_ref_pool_get_ref(rvm->targets, i)));
+	}
+	engine_ref_pool_destroy(rvm->shaders);
+	engine_ref_pool_destroy(rvm->meshes);
+	engine_ref_pool_destroy(rvm->textures);
+	engine_ref_pool_destroy(rvm->pipelines);
+	engine_ref_pool_destroy(rvm->bundles);
+	engine_ref_pool_destroy(rvm->targets);
+	engine_ref_pool_destroy(rvm->samplers);
+
+	ENGINE_FREE(rvm->window.color);
+	ENGINE_FREE(rvm->window.depth);
+	ENGINE_FREE(rvm->window.stencil);
+	ENGINE_FREE(rvm);
+}
+
+struct RVM_Stats engine_rendering_vm_get_stats(void) {
+	return rvm->stats;
+}
+
+void engine_rendering_vm_reset_stats(void) {
+	rvm->stats = (struct RVM_Stats){0};
+}
+
+u32 engine_rendering_vm_get_resources_count(void) {
+	return engine_ref_pool_get_count(rvm->shaders)
+	     + engine_ref_pool_get_count(rvm->meshes)
+	     + engine_ref_pool_get_count(rvm->textures)
+	     + engine_ref_pool_get_count(rvm->pipelines)
+	     + engine_ref_pool_get_count(rvm->bundles)
+	     + engine_ref_pool_get_count(rvm->targets)
+	     + engine_ref_pool_get_count(rvm->samplers);
+}
+
+void engine_rendering_vm_end_frame(void) {
+	// mesh data is copied on load, nothing is in flight past `engine_rendering_vm_update`;
+	// transient meshes go stale all the same, as with the GL backend
+	rvm->frame++;
+}
+
+size_t engine_rendering_vm_update(u8 const * buffer, size_t buffer_length) {
+	u8 const * const buffer_start = buffer;
+	u8 const * const buffer_end = buffer + buffer_length;
+	while ((size_t)(buffer_end - buffer) >= sizeof(struct RVM_Header)) {
+		struct RVM_Header const * header = (void const *)buffer;
+		u8 const * payload = buffer + sizeof(*header);
+
+		if (header->instruction >= RVM_Instruction_Count) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size < impl_payload_sizes[header->instruction]) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size > (size_t)(buffer_end - payload)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+		if (header->size % RVM_ALIGNMENT) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); break; }
+
+		rvm->payload_size = header->size;
+		impl_handlers[header->instruction](payload);
+		buffer = payload + header->size;
+	}
+	impl_flush();
+
+	size_t const consumed = (size_t)(buffer - buffer_start);
+	engine_rendering_capture_record(buffer_start, consumed);
+	return consumed;
+}
+
+u32 const * engine_rendering_software_get_color(svec2 * size) {
+	impl_flush();
+	if (size) { *size = rvm->window.size; }
+	return rvm->window.color;
+}
+
+//
+// internal implementation
+//
+
+static bool impl_state_changed(bool changed) {
+	if (changed) { rvm->stats.calls_issued++; rvm->draw_changed = true; }
+	else { rvm->stats.calls_skipped++; }
+	return changed;
+}
+
+// resources; a stale ref or a double allocation is an error of the stream
+static void * impl_find(struct Ref_Pool const * pool, struct Ref ref) {
+	void * entry = engine_ref_pool_get(pool, ref);
+	if (!entry) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); }
+	return entry;
+}
+
+static void * impl_claim(struct Ref_Pool * pool, struct Ref ref) {
+	void * entry = engine_ref_pool_claim(pool, ref);
+	if (!entry) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); }
+	return entry;
+}
+
+// counts the recorded instructions, filling `ops` if any; UINT32_MAX for a malformed record
+static u32 impl_bundle_decode(u8 const * data, u32 length, struct VM_Bundle_Op * ops) {
+	u32 count = 0;
+	for (u32 offset = 0; offset < length; count++) {
+		if (length - offset < sizeof(struct RVM_Header)) { return UINT32_MAX; }
+		struct RVM_Header const * header = (void const *)(data + offset);
+		offset += sizeof(*header);
+
+		if (header->instruction >= RVM_Instruction_Count || impl_scopes[header->instruction] != RVM_Scope_Bundle) { return UINT32_MAX; }
+		if (header->size < impl_payload_sizes[header->instruction]) { return UINT32_MAX; }
+		if (header->size > length - offset) { return UINT32_MAX; }
+		if (header->size % RVM_ALIGNMENT) { return UINT32_MAX; }
+
+		if (ops) { ops[count] = (struct VM_Bundle_Op){.instruction = header->instruction, .offset = offset, .size = header->size}; }
+		offset += header->size;
+	}
+	return count;
+}
+
+static bool impl_ref_changed(struct Ref * cached, struct Ref value) {
+	if (!impl_state_changed(cached->id != value.id || cached->gen != value.gen)) { return false; }
+	*cached = value;
+	return true;
+}
+
+static void impl_reset_state(struct VM_State * state, svec2 size) {
+	// the defaults of a fresh context
+	*state = (struct VM_State){
+		.lower_left = true, .zero_one = false,
+		.viewport_pos = SVEC2(0, 0), .viewport_size = size,
+		//
+		.color_write = RVM_Color_Write_All,
+		.blend = RVM_Color_Blend_Opaque,
+		//
+		.depth_write = true,
+		.depth_clear = 1,
+		.depth_comparison = RVM_Comparison_Less,
+		.depth_range = VEC2(0, 1),
+		//
+		.stencil_write = 0xff,
+		.stencil_comparison = RVM_Comparison_True, .stencil_mask = 0xff,
+		.stencil_fail = RVM_Operation_Keep, .stencil_depth_fail = RVM_Operation_Keep, .stencil_depth_pass = RVM_Operation_Keep,
+		//
+		.cull_mode = RVM_Face_Cull_None, .front_face = RVM_Face_Front_CCW,
+		//
+		.shader = {.id = REF_EMPTY_ID}, .mesh = {.id = REF_EMPTY_ID},
+	};
+	for (u32 i = 0; i < VM_TEXTURE_UNITS; ++i) {
+		state->textures[i] = (struct Ref){.id = REF_EMPTY_ID};
+		state->samplers[i] = (struct Ref){.id = REF_EMPTY_ID};
+	}
+	state->target = (struct Ref){.id = REF_EMPTY_ID};
+}
+
+static u32 impl_data_type_size(enum Data_Type value) {
+	switch (value) {
+		case Data_Type_s8:  return sizeof(s8);
+		case Data_Type_s16: return sizeof(s16);
+		case Data_Type_s32: return sizeof(s32);
+		//
+		case Data_Type_u8:  return sizeof(u8);
+		case Data_Type_u16: return sizeof(u16);
+		case Data_Type_u32: return sizeof(u32);
+		//
+		case Data_Type_r32: return sizeof(r32);
+		case Data_Type_r64: return sizeof(r64);
+		//
+		case Data_Type_vec2: return sizeof(vec2);
+		case Data_Type_vec3: return sizeof(vec3);
+		case Data_Type_vec4: return sizeof(vec4);
+		//
+		case Data_Type_svec2: return sizeof(svec2);
+		case Data_Type_svec3: return sizeof(svec3);
+		case Data_Type_svec4: return sizeof(svec4);
+		//
+		case Data_Type_uvec2: return sizeof(uvec2);
+		case Data_Type_uvec3: return sizeof(uvec3);
+		case Data_Type_uvec4: return sizeof(uvec4);
+		//
+		case Data_Type_mat2: return sizeof(r32) * 2 * 2;
+		case Data_Type_mat3: return sizeof(r32) * 3 * 3;
+		case Data_Type_mat4: return sizeof(mat4);
+		//
+		case Data_Type_unit_id: return sizeof(s32);
+	}
+	ENGINE_DEBUG_BREAK();
+	return 0;
+}
+
+static bool impl_compare(enum RVM_Comparison comparison, r32 value, r32 reference) {
+	switch (comparison) {
+		case RVM_Comparison_False:   return false;
+		case RVM_Comparison_True:    return true;
+		case RVM_Comparison_Less:    return value <  reference;
+		case RVM_Comparison_LEqual:  return value <= reference;
+		case RVM_Comparison_Equal:   return value <= reference && value >= reference;
+		case RVM_Comparison_NEqual:  return !(value <= reference && value >= reference);
+		case RVM_Comparison_Greater: return value >  reference;
+		case RVM_Comparison_GEqual:  return value >= reference;
+	}
+	return false;
+}
+
+static u8 impl_operation(enum RVM_Operation operation, u8 value, u8 reference) {
+	switch (operation) {
+		case RVM_Operation_Keep:      return value;
+		case RVM_Operation_Invert:    return (u8)~value;
+		case RVM_Operation_Zero:      return 0;
+		case RVM_Operation_Replace:   return reference;
+		case RVM_Operation_Incr:      return (value < 0xff) ? (u8)(value + 1) : value;
+		case RVM_Operation_Incr_Wrap: return (u8)(value + 1);
+		case RVM_Operation_Decr:      return (value > 0) ? (u8)(value - 1) : value;
+		case RVM_Operation_Decr_Wrap: return (u8)(value - 1);
+	}
+	return value;
+}
+
+static u32 impl_pack_color(vec4 value) {
+	u32 const r = (u32)(clamp_r32(value.x, 0, 1) * 255 + 0.5f);
+	u32 const g = (u32)(clamp_r32(value.y, 0, 1) * 255 + 0.5f);
+	u32 const b = (u32)(clamp_r32(value.z, 0, 1) * 255 + 0.5f);
+	u32 const a = (u32)(clamp_r32(value.w, 0, 1) * 255 + 0.5f);
+	return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+static vec4 impl_unpack_color(u32 value) {
+	return VEC4(
+		(r32)((value >>  0) & 0xff) / 255,
+		(r32)((value >>  8) & 0xff) / 255,
+		(r32)((value >> 16) & 0xff) / 255,
+		(r32)((value >> 24) & 0xff) / 255
+	);
+}
+
+// textures
+static s32 impl_wrap(s32 value, s32 size, enum Wrap_Type type) {
+	switch (type) {
+		case Wrap_Type_Clamp: return clamp_s32(value, 0, size - 1);
+		case Wrap_Type_Repeat: {
+			s32 const result = value % size;
+			return (result < 0) ? result + size : result;
+		}
+		case Wrap_Type_MClamp: {
+			if (value < 0) { value = -1 - value; }
+			return min_s32(value, size - 1);
+		}
+		case Wrap_Type_MRepeat: {
+			s32 const period = size * 2;
+			s32 result = value % period;
+			if (result < 0) { result += period; }
+			return (result < size) ? result : period - 1 - result;
+		}
+	}
+	return 0;
+}
+
+static r32 impl_texel_coordinate(r32 value, s32 size) {
+	// also maps NaN onto the limit, keeps conversions to integers defined
+	if (!(value > -SOFTWARE_UV_LIMIT)) { value = -SOFTWARE_UV_LIMIT; }
+	if (!(value <  SOFTWARE_UV_LIMIT)) { value =  SOFTWARE_UV_LIMIT; }
+	return value * (r32)size;
+}
+
+static vec4 impl_texel(struct Software_Sampler const * sampler, s32 x, s32 y) {
+	x = impl_wrap(x, sampler->size.x, sampler->wrap_x);
+	y = impl_wrap(y, sampler->size.y, sampler->wrap_y);
+	return sampler->texels[(size_t)y * (size_t)sampler->size.x + (size_t)x];
+}
+
+static r32 impl_texel_channel(u8 const * data, enum Data_Type type, size_t index) {
+	switch (type) {
+		case Data_Type_u8: return (r32)data[index] / 255;
+		case Data_Type_u16: { u16 value; memcpy(&value, data + index * sizeof(value), sizeof(value)); return (r32)value / 65535; }
+		case Data_Type_u32: { u32 value; memcpy(&value, data + index * sizeof(value), sizeof(value)); return (r32)value; }
+		case Data_Type_r32: { r32 value; memcpy(&value, data + index * sizeof(value), sizeof(value)); return value; }
+		default: return 0;
+	}
+}
+
+static void impl_texture_load(struct VM_Texture * texture, struct Asset_Texture const * asset) {
+	if (asset->kind != Texture_Type_Color) { printf("[wrn] software textures are color only\n"); return; }
+	if (asset->size.x <= 0 || asset->size.y <= 0) { ENGINE_DEBUG_BREAK(); return; }
+	if (asset->channels < 1 || asset->channels > 4) { ENGINE_DEBUG_BREAK(); return; }
+
+	u32 const type_size = impl_data_type_size(asset->type);
+	size_t const texels_count = (size_t)asset->size.x * (size_t)asset->size.y;
+	if (asset->data && asset->length < texels_count * asset->channels * type_size) { ENGINE_DEBUG_BREAK(); return; }
+
+	vec4 * texels = ENGINE_REALLOC(texture->texels, texels_count * sizeof(*texels));
+	if (!texels) { ENGINE_DEBUG_BREAK(); return; }
+
+	texture->texels = texels;
+	texture->size = asset->size;
+	texture->filter = asset->filter_max;
+	texture->wrap_x = asset->wrap_x;
+	texture->wrap_y = asset->wrap_y;
+
+	if (!asset->data) { memset(texels, 0, texels_count * sizeof(*texels)); return; }
+
+	// missing channels read as (0, 0, 0, 1)
+	for (size_t i = 0; i < texels_count; ++i) {
+		r32 value[4] = {0, 0, 0, 1};
+		for (u8 channel = 0; channel < asset->channels; ++channel) {
+			value[channel] = impl_texel_channel(asset->data, asset->type, i * asset->channels + channel);
+		}
+		texels[i] = VEC4(value[0], value[1], value[2], value[3]);
+	}
+}
+
+// an attachment reads as cleared, (0, 0, 0, 0)
+static void impl_target_texture(struct VM_Texture * texture, svec2 size) {
+	size_t const texels_count = (size_t)size.x * (size_t)size.y;
+	vec4 * texels = ENGINE_REALLOC(texture->texels, texels_count * sizeof(*texels));
+	if (!texels) { ENGINE_DEBUG_BREAK(); return; }
+
+	memset(texels, 0, texels_count * sizeof(*texels));
+	texture->texels = texels;
+	texture->size = size;
+	texture->filter = Filter_Type_Linear;
+	texture->wrap_x = Wrap_Type_Clamp;
+	texture->wrap_y = Wrap_Type_Clamp;
+}
+
+// targets
+// the tiles follow the surface, bins are only added
+static void impl_surface_use(struct Software_Surface const * surface) {
+	svec2 const tiles = SVEC2(
+		(surface->size.x + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE,
+		(surface->size.y + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE
+	);
+	u32 const bins_count = (u32)tiles.x * (u32)tiles.y;
+	if (bins_count > rvm->bins_count) {
+		struct Software_Bin * bins = ENGINE_REALLOC(rvm->bins, bins_count * sizeof(*bins));
+		if (!bins) {
+			// nothing is drawn rather than into another surface
+			rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+			rvm->surface = (struct Software_Surface){.size = {0, 0}};
+			rvm->tiles = SVEC2(0, 0);
+			return;
+		}
+		memset(bins + rvm->bins_count, 0, (bins_count - rvm->bins_count) * sizeof(*bins));
+		rvm->bins = bins;
+		rvm->bins_count = bins_count;
+	}
+	rvm->surface = *surface;
+	rvm->tiles = tiles;
+}
+
+static struct Software_Surface impl_target_surface(struct VM_Target const * target) {
+	struct Software_Surface surface = {.size = target->size, .depth = target->depth, .stencil = target->stencil};
+	for (u32 i = 0; i < target->count && !surface.color; ++i) { surface.color = target->colors[i]; }
+	return surface;
+}
+
+static void impl_target_free_buffers(struct VM_Target * target) {
+	for (u32 i = 0; i < RVM_TARGET_ATTACHMENTS; ++i) {
+		ENGINE_FREE(target->colors[i]); target->colors[i] = NULL;
+	}
+	ENGINE_FREE(target->depth); target->depth = NULL;
+	ENGINE_FREE(target->stencil); target->stencil = NULL;
+}
+
+// a buffer per attachment, as cleared to (0, 0, 0, 0), a depth of 1 and a stencil of 0; false if out of memory
+static bool impl_target_buffers(struct VM_Target * target, svec2 size) {
+	impl_target_free_buffers(target);
+	target->size = size;
+
+	size_t const pixels = (size_t)size.x * (size_t)size.y;
+	bool has_depth = false, has_stencil = false;
+	for (u32 i = 0; i < target->count; ++i) {
+		switch (target->kinds[i]) {
+			case Texture_Type_Color: {
+				target->colors[i] = ENGINE_MALLOC(pixels * sizeof(*target->colors[i]));
+				if (!target->colors[i]) { return false; }
+				memset(target->colors[i], 0, pixels * sizeof(*target->colors[i]));
+			} break;
+
+			case Texture_Type_Depth:    has_depth = true; break;
+			case Texture_Type_DStencil: has_depth = true; has_stencil = true; break;
+			case Texture_Type_Stencil:  has_stencil = true; break;
+		}
+	}
+
+	if (has_depth) {
+		target->depth = ENGINE_MALLOC(pixels * sizeof(*target->depth));
+		if (!target->depth) { return false; }
+		for (size_t pixel = 0; pixel < pixels; ++pixel) { target->depth[pixel] = 1; }
+	}
+	if (has_stencil) {
+		target->stencil = ENGINE_MALLOC(pixels * sizeof(*target->stencil));
+		if (!target->stencil) { return false; }
+		memset(target->stencil, 0, pixels * sizeof(*target->stencil));
+	}
+
+	for (u32 i = 0; i < target->count; ++i) {
+		struct VM_Texture * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (texture) { impl_target_texture(texture, size); }
+	}
+	return true;
+}
+
+// what has been drawn into the current target goes to its sampled attachments
+// - depth reads as (d, 0, 0, 1) and stencil as (s, 0, 0, 1), as GL samples them
+static void impl_target_store(void) {
+	rvm->surface_changed = false;
+	struct VM_Target const * target = engine_ref_pool_get(rvm->targets, rvm->state.target);
+	if (!target) { return; }
+
+	size_t const pixels = (size_t)target->size.x * (size_t)target->size.y;
+	for (u32 i = 0; i < target->count; ++i) {
+		struct VM_Texture const * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (!texture || !texture->texels) { continue; }
+		if (texture->size.x != target->size.x || texture->size.y != target->size.y) { continue; }
+
+		vec4 * texels = texture->texels;
+		switch (target->kinds[i]) {
+			case Texture_Type_Color: {
+				u32 const * color = target->colors[i];
+				if (!color) { break; }
+				for (size_t pixel = 0; pixel < pixels; ++pixel) { texels[pixel] = impl_unpack_color(color[pixel]); }
+			} break;
+
+			case Texture_Type_Depth: case Texture_Type_DStencil: {
+				r32 const * depth = target->depth;
+				if (!depth) { break; }
+				for (size_t pixel = 0; pixel < pixels; ++pixel) { texels[pixel] = VEC4(depth[pixel], 0, 0, 1); }
+			} break;
+
+			case Texture_Type_Stencil: {
+				u8 const * stencil = target->stencil;
+				if (!stencil) { break; }
+				for (size_t pixel = 0; pixel < pixels; ++pixel) { texels[pixel] = VEC4((r32)stencil[pixel], 0, 0, 1); }
+			} break;
+		}
+	}
+}
+
+// colors, and at most one depth or stencil
+static bool impl_target_valid(struct RVM_Target_Allocate const * payload) {
+	if (payload->size.x <= 0 || payload->size.y <= 0) { return false; }
+	if (payload->count == 0 || payload->count > RVM_TARGET_ATTACHMENTS) { return false; }
+
+	u32 depth_stencil_count = 0;
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Target_Attachment const * attachment = payload->attachments + i;
+		if ((u32)attachment->kind > Texture_Type_DStencil) { return false; }
+		if (attachment->kind != Texture_Type_Color) { depth_stencil_count++; }
+		else if (attachment->channels < 1 || attachment->channels > 4) { return false; }
+	}
+	return depth_stencil_count <= 1;
+}
+
+// meshes
+static void impl_mesh_load(struct VM_Mesh * mesh, struct Asset_Mesh const * asset) {
+	mesh->transient = asset->transient;
+	mesh->frame = rvm->frame;
+	if (asset->type != Data_Type_r32) { printf("[wrn] software meshes are r32 only\n"); return; }
+
+	u32 stride = 0, attributes_count = 0;
+	for (; attributes_count < ASSET_MESH_ATTRIBUTES && asset->attributes[attributes_count]; ++attributes_count) {
+		mesh->offsets[attributes_count] = stride;
+		stride += asset->attributes[attributes_count];
+	}
+	if (!stride) { ENGINE_DEBUG_BREAK(); return; }
+
+	size_t const vertices_count = asset->length / (stride * sizeof(r32));
+	r32 * data = ENGINE_REALLOC(mesh->data, vertices_count * stride * sizeof(r32) + sizeof(r32));
+	if (!data) { ENGINE_DEBUG_BREAK(); return; }
+
+	if (asset->data) { memcpy(data, asset->data, vertices_count * stride * sizeof(r32)); }
+	else { memset(data, 0, vertices_count * stride * sizeof(r32)); }
+
+	mesh->data = data;
+	mesh->vertices_count = (u32)vertices_count;
+	mesh->stride = stride;
+	mesh->attributes_count = attributes_count;
+	mesh->divisor = asset->divisor;
+	mesh->location = asset->location;
+}
+
+static bool impl_mesh_is_stale(struct VM_Mesh const * mesh) {
+	if (!mesh->transient || mesh->frame == rvm->frame) { return false; }
+	rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+	return true;
+}
+
+// shaders
+static struct Software_Shader const * impl_find_native_shader(struct Asset_Shader const * asset) {
+	static char const pragma[] = "#pragma software(";
+	size_t const pragma_length = sizeof(pragma) - 1;
+
+	cstring const text = (cstring)asset->data;
+	for (size_t i = 0; i + pragma_length <= asset->length; ++i) {
+		if (memcmp(text + i, pragma, pragma_length) != 0) { continue; }
+
+		cstring const name = text + i + pragma_length;
+		size_t name_length = 0;
+		while (i + pragma_length + name_length < asset->length && name[name_length] != ')') { name_length++; }
+
+		for (size_t shader_i = 0; shader_i < sizeof(impl_native_shaders) / sizeof(*impl_native_shaders); ++shader_i) {
+			struct Software_Shader const * shader = impl_native_shaders[shader_i];
+			if (strlen(shader->name) != name_length) { continue; }
+			if (memcmp(shader->name, name, name_length) != 0) { continue; }
+			if (shader->varyings_count > SOFTWARE_VARYINGS_MAX) { ENGINE_DEBUG_BREAK(); return NULL; }
+			return shader;
+		}
+
+		printf("[wrn] unknown software shader \"%.*s\"\n", (int)name_length, name);
+		return NULL;
+	}
+
+	printf("[wrn] no `#pragma software` in the shader\n");
+	return NULL;
+}
+
+// draws
+static u32 impl_draw_snapshot(struct VM_Shader const * shader) {
+	if (!rvm->draw_changed && rvm->draws_count) { return rvm->draws_count - 1; }
+
+	if (rvm->draws_count == rvm->draws_capacity) {
+		u32 draws_capacity = rvm->draws_capacity ? rvm->draws_capacity * 2 : 16;
+		struct Software_Draw * draws = ENGINE_REALLOC(rvm->draws, draws_capacity * sizeof(*draws));
+		if (!draws) { return UINT32_MAX; }
+
+		rvm->draws = draws;
+		rvm->draws_capacity = draws_capacity;
+	}
+
+	struct VM_State const * state = &rvm->state;
+	struct Software_Draw * draw = rvm->draws + rvm->draws_count;
+	*draw = (struct Software_Draw){
+		.shader = shader->native,
+		.uniforms_set = shader->uniforms_set,
+		//
+		.color_write = rvm->surface.color ? state->color_write : RVM_Color_Write_None,
+		.blend = state->blend,
+		.depth_test = state->depth_test && rvm->surface.depth != NULL, .depth_write = state->depth_write,
+		.depth_comparison = state->depth_comparison,
+		.stencil_test = state->stencil_test && rvm->surface.stencil != NULL,
+		.stencil_write = state->stencil_write,
+		.stencil_comparison = state->stencil_comparison,
+		.stencil_reference = state->stencil_reference, .stencil_mask = state->stencil_mask,
+		.stencil_fail = state->stencil_fail,
+		.stencil_depth_fail = state->stencil_depth_fail,
+		.stencil_depth_pass = state->stencil_depth_pass,
+	};
+	memcpy(draw->uniforms, shader->uniforms, sizeof(draw->uniforms));
+
+	for (u32 i = 0; i < VM_TEXTURE_UNITS; ++i) {
+		struct VM_Texture const * texture = engine_ref_pool_get(rvm->textures, state->textures[i]);
+		if (!texture || !texture->texels) { continue; }
+
+		draw->units[i] = (struct Software_Sampler){
+			.texels = texture->texels, .size = texture->size,
+			.filter = texture->filter,
+			.wrap_x = texture->wrap_x, .wrap_y = texture->wrap_y,
+		};
+
+		// the unit's own settings take the place of the texture's
+		struct VM_Sampler const * sampler = engine_ref_pool_get(rvm->samplers, state->samplers[i]);
+		if (!sampler) { continue; }
+		draw->units[i].filter = sampler->value.filter_max;
+		draw->units[i].wrap_x = sampler->value.wrap_x;
+		draw->units[i].wrap_y = sampler->value.wrap_y;
+	}
+
+	rvm->draw_changed = false;
+	return rvm->draws_count++;
+}
+
+static void impl_bin_push(struct Software_Bin * bin, u32 triangle) {
+	if (bin->count == bin->capacity) {
+		u32 capacity = bin->capacity ? bin->capacity * 2 : 64;
+		u32 * triangles = ENGINE_REALLOC(bin->triangles, capacity * sizeof(*triangles));
+		if (!triangles) { ENGINE_DEBUG_BREAK(); return; }
+
+		bin->triangles = triangles;
+		bin->capacity = capacity;
+	}
+	bin->triangles[bin->count++] = triangle;
+}
+
+static void impl_setup_triangle(u32 draw_index, struct Software_Vertex const * const * vertices, u32 varyings_count) {
+	struct VM_State const * state = &rvm->state;
+
+	r32 x[3], y[3], z[3], inv_w[3];
+	for (u32 i = 0; i < 3; ++i) {
+		vec4 const position = vertices[i]->position;
+		if (!(position.w > 0)) { return; }
+
+		inv_w[i] = 1 / position.w;
+		r32 const ndc_x = position.x * inv_w[i];
+		r32 const ndc_y = position.y * inv_w[i] * (state->lower_left ? 1 : -1);
+		r32 const ndc_z = position.z * inv_w[i];
+		r32 const depth = state->zero_one ? ndc_z : (ndc_z + 1) * 0.5f;
+
+		x[i] = (r32)state->viewport_pos.x + (ndc_x + 1) * 0.5f * (r32)state->viewport_size.x;
+		y[i] = (r32)state->viewport_pos.y + (ndc_y + 1) * 0.5f * (r32)state->viewport_size.y;
+		z[i] = lerp(state->depth_range.x, state->depth_range.y, clamp_r32(depth, 0, 1));
+	}
+
+	r64 area = (r64)(x[1] - x[0]) * (r64)(y[2] - y[0]) - (r64)(x[2] - x[0]) * (r64)(y[1] - y[0]);
+	if (!(area < 0 || area > 0)) { return; }
+
+	// the upper left origin mirrors the window, and the winding with it
+	bool const ccw = state->lower_left ? (area > 0) : (area < 0);
+	bool const front = ccw == (state->front_face == RVM_Face_Front_CCW);
+	if (state->cull_mode == RVM_Face_Cull_Back  && !front) { return; }
+	if (state->cull_mode == RVM_Face_Cull_Front &&  front) { return; }
+
+	u32 order[3] = {0, 1, 2};
+	if (area < 0) { order[1] = 2; order[2] = 1; area = -area; }
+
+	// pixel centers inside the bounds, clipped to the viewport and the target
+	r32 const min_x = min_r32(x[0], min_r32(x[1], x[2])), max_x = max_r32(x[0], max_r32(x[1], x[2]));
+	r32 const min_y = min_r32(y[0], min_r32(y[1], y[2])), max_y = max_r32(y[0], max_r32(y[1], y[2]));
+	svec2 const bounds_min = SVEC2(
+		max_s32(max_s32((s32)ceilf(min_x - 0.5f), state->viewport_pos.x), 0),
+		max_s32(max_s32((s32)ceilf(min_y - 0.5f), state->viewport_pos.y), 0)
+	);
+	svec2 const bounds_max = SVEC2(
+		min_s32(min_s32((s32)floorf(max_x - 0.5f), state->viewport_pos.x + state->viewport_size.x - 1), rvm->surface.size.x - 1),
+		min_s32(min_s32((s32)floorf(max_y - 0.5f), state->viewport_pos.y + state->viewport_size.y - 1), rvm->surface.size.y - 1)
+	);
+	if (bounds_min.x > bounds_max.x || bounds_min.y > bounds_max.y) { return; }
+
+	u32 const triangle_index = rvm->triangles_count++;
+	struct Software_Triangle * triangle = rvm->triangles + triangle_index;
+	triangle->draw = draw_index;
+	triangle->min = bounds_min;
+	triangle->max = bounds_max;
+	triangle->inv_area = (r32)(1 / area);
+
+	for (u32 i = 0; i < 3; ++i) {
+		u32 const v = order[i], j = order[(i + 1) % 3], k = order[(i + 2) % 3];
+
+		// shared edges get exactly negated coefficients, the owner rule splits them
+		triangle->a[i] = y[j] - y[k];
+		triangle->b[i] = x[k] - x[j];
+		triangle->c[i] = (r32)((r64)x[j] * (r64)y[k] - (r64)x[k] * (r64)y[j]);
+		triangle->owner[i] = (triangle->a[i] > 0) || (triangle->a[i] >= 0 && triangle->b[i] < 0);
+
+		triangle->z[i] = z[v];
+		triangle->inv_w[i] = inv_w[v];
+		for (u32 varying_i = 0; varying_i < varyings_count; ++varying_i) {
+			triangle->varyings[i][varying_i] = vertices[v]->varyings[varying_i] * inv_w[v];
+		}
+	}
+
+	// bin into the tiles the triangle might touch
+	s32 const tile_min_x = bounds_min.x / SOFTWARE_TILE_SIZE, tile_max_x = bounds_max.x / SOFTWARE_TILE_SIZE;
+	s32 const tile_min_y = bounds_min.y / SOFTWARE_TILE_SIZE, tile_max_y = bounds_max.y / SOFTWARE_TILE_SIZE;
+	for (s32 tile_y = tile_min_y; tile_y <= tile_max_y; ++tile_y) {
+		for (s32 tile_x = tile_min_x; tile_x <= tile_max_x; ++tile_x) {
+			r64 const left   = tile_x * SOFTWARE_TILE_SIZE + 0.5, right = left   + SOFTWARE_TILE_SIZE - 1;
+			r64 const bottom = tile_y * SOFTWARE_TILE_SIZE + 0.5, top   = bottom + SOFTWARE_TILE_SIZE - 1;
+
+			// the tile corner nearest to each edge interior, with a margin for the rasterizer rounding
+			bool outside = false;
+			for (u32 i = 0; i < 3 && !outside; ++i) {
+				r64 const a = triangle->a[i], b = triangle->b[i], c = triangle->c[i];
+				r64 const corner_x = (a > 0) ? right : left;
+				r64 const corner_y = (b > 0) ? top : bottom;
+				r64 const margin = (fabs(a * corner_x) + fabs(b * corner_y) + fabs(c)) * 1e-6;
+				outside = a * corner_x + b * corner_y + c + margin < 0;
+			}
+			if (outside) { continue; }
+
+			impl_bin_push(rvm->bins + tile_y * rvm->tiles.x + tile_x, triangle_index);
+		}
+	}
+}
+
+static r32 impl_clip_distance(vec4 position, u32 plane, bool zero_one) {
+	switch (plane) {
+		case 0: return zero_one ? position.z : position.z + position.w; // near
+		case 1: return position.w - position.z; // far
+		case 2: return position.w + position.x;
+		case 3: return position.w - position.x;
+		case 4: return position.w + position.y;
+		case 5: return position.w - position.y;
+	}
+	return 0;
+}
+
+static void impl_clip_triangle(u32 draw_index, struct Software_Vertex const * vertices, u32 varyings_count) {
+	bool const zero_one = rvm->state.zero_one;
+
+	u32 outside_any = 0, outside_all = 0x3f;
+	for (u32 i = 0; i < 3; ++i) {
+		u32 outside = 0;
+		for (u32 plane = 0; plane < 6; ++plane) {
+			if (impl_clip_distance(vertices[i].position, plane, zero_one) < 0) { outside |= 1u << plane; }
+		}
+		outside_any |= outside;
+		outside_all &= outside;
+	}
+	if (outside_all) { return; }
+
+	if (!outside_any) {
+		struct Software_Vertex const * triangle[3] = {vertices + 0, vertices + 1, vertices + 2};
+		impl_setup_triangle(draw_index, triangle, varyings_count);
+		return;
+	}
+
+	// Sutherland-Hodgman, against the planes the triangle crosses
+	struct Software_Vertex polygons[2][SOFTWARE_CLIP_VERTICES];
+	u32 count = 3;
+	memcpy(polygons[0], vertices, 3 * sizeof(*vertices));
+
+	u32 current = 0;
+	for (u32 plane = 0; plane < 6 && count >= 3; ++plane) {
+		if (!(outside_any & (1u << plane))) { continue; }
+
+		struct Software_Vertex const * input = polygons[current];
+		struct Software_Vertex * output = polygons[current ^ 1];
+		u32 output_count = 0;
+		for (u32 i = 0; i < count; ++i) {
+			struct Software_Vertex const * from = input + i;
+			struct Software_Vertex const * to = input + (i + 1) % count;
+			r32 const from_distance = impl_clip_distance(from->position, plane, zero_one);
+			r32 const to_distance = impl_clip_distance(to->position, plane, zero_one);
+
+			if (from_distance >= 0) { output[output_count++] = *from; }
+			if ((from_distance >= 0) == (to_distance >= 0)) { continue; }
+
+			r32 const t = from_distance / (from_distance - to_distance);
+			struct Software_Vertex * vertex = output + output_count++;
+			vertex->position = VEC4(
+				lerp(from->position.x, to->position.x, t),
+				lerp(from->position.y, to->position.y, t),
+				lerp(from->position.z, to->position.z, t),
+				lerp(from->position.w, to->position.w, t)
+			);
+			for (u32 varying_i = 0; varying_i < varyings_count; ++varying_i) {
+				vertex->varyings[varying_i] = lerp(from->varyings[varying_i], to->varyings[varying_i], t);
+			}
+		}
+
+		count = output_count;
+		current ^= 1;
+	}
+
+	for (u32 i = 2; i < count; ++i) {
+		struct Software_Vertex const * triangle[3] = {polygons[current] + 0, polygons[current] + i - 1, polygons[current] + i};
+		impl_setup_triangle(draw_index, triangle, varyings_count);
+	}
+}
+
+// pixels
+static void impl_write_color(struct Software_Draw const * draw, u32 * target, vec4 source) {
+	source = VEC4(clamp_r32(source.x, 0, 1), clamp_r32(source.y, 0, 1), clamp_r32(source.z, 0, 1), clamp_r32(source.w, 0, 1));
+
+	// the factors apply to the alpha channel as well
+	vec4 value = source;
+	if (draw->blend != RVM_Color_Blend_Opaque) {
+		vec4 const target_value = impl_unpack_color(*target);
+		vec4 const source_alpha = VEC4_SINGLE(source.w);
+		vec4 const source_alpha_inverse = VEC4_SINGLE(1 - source.w);
+		switch (draw->blend) {
+			case RVM_Color_Blend_Opaque: break;
+			case RVM_Color_Blend_Alpha:      value = vec4_add(vec4_mul(source, source_alpha), vec4_mul(target_value, source_alpha_inverse)); break;
+			case RVM_Color_Blend_Additive:   value = vec4_add(vec4_mul(source, source_alpha), target_value); break;
+			case RVM_Color_Blend_Multiply:   value = vec4_mul(source, target_value); break;
+			case RVM_Color_Blend_PMAlpha:    value = vec4_add(source, vec4_mul(target_value, source_alpha_inverse)); break;
+			case RVM_Color_Blend_PMAdditive: value = vec4_add(source, target_value); break;
+		}
+	}
+
+	u32 mask = 0;
+	if (draw->color_write & RVM_Color_Write_R) { mask |= 0x000000ffu; }
+	if (draw->color_write & RVM_Color_Write_G) { mask |= 0x0000ff00u; }
+	if (draw->color_write & RVM_Color_Write_B) { mask |= 0x00ff0000u; }
+	if (draw->color_write & RVM_Color_Write_A) { mask |= 0xff000000u; }
+	*target = (*target & ~mask) | (impl_pack_color(value) & mask);
+}
+
+static void impl_shade_pixel(struct Software_Draw const * draw, struct Software_Triangle const * triangle, s32 x, s32 y, r32 const * edges) {
+	struct Software_Surface const * surface = &rvm->surface;
+	size_t const index = (size_t)y * (size_t)surface->size.x + (size_t)x;
+	r32 const l0 = edges[0] * triangle->inv_area;
+	r32 const l1 = edges[1] * triangle->inv_area;
+	r32 const l2 = edges[2] * triangle->inv_area;
+
+	// stencil, then depth; the tests are off for a surface without the buffer
+	u8 * stencil = draw->stencil_test ? surface->stencil + index : NULL;
+	if (draw->stencil_test) {
+		u8 const masked_value = *stencil & draw->stencil_mask;
+		u8 const masked_reference = draw->stencil_reference & draw->stencil_mask;
+		if (!impl_compare(draw->stencil_comparison, masked_reference, masked_value)) {
+			u8 const value = impl_operation(draw->stencil_fail, *stencil, draw->stencil_reference);
+			*stencil = (u8)((*stencil & ~draw->stencil_write) | (value & draw->stencil_write));
+			return;
+		}
+	}
+
+	r32 const z = l0 * triangle->z[0] + l1 * triangle->z[1] + l2 * triangle->z[2];
+	bool const depth_pass = !draw->depth_test || impl_compare(draw->depth_comparison, z, surface->depth[index]);
+
+	if (draw->stencil_test) {
+		enum RVM_Operation const operation = depth_pass ? draw->stencil_depth_pass : draw->stencil_depth_fail;
+		u8 const value = impl_operation(operation, *stencil, draw->stencil_reference);
+		*stencil = (u8)((*stencil & ~draw->stencil_write) | (value & draw->stencil_write));
+	}
+	if (!depth_pass) { return; }
+
+	// a disabled depth test disables depth writes too
+	if (draw->depth_test && draw->depth_write) { surface->depth[index] = z; }
+	if (draw->color_write == RVM_Color_Write_None) { return; }
+
+	// perspective correct varyings
+	r32 const w = 1 / (l0 * triangle->inv_w[0] + l1 * triangle->inv_w[1] + l2 * triangle->inv_w[2]);
+	r32 varyings[SOFTWARE_VARYINGS_MAX];
+	for (u32 i = 0; i < draw->shader->varyings_count; ++i) {
+		varyings[i] = (l0 * triangle->varyings[0][i] + l1 * triangle->varyings[1][i] + l2 * triangle->varyings[2][i]) * w;
+	}
+
+	vec4 const color = draw->shader->fragment(draw, varyings);
+	impl_write_color(draw, surface->color + index, color);
+}
+
+// 4 pixels of a row, returns a bit per covered pixel
+static u32 impl_coverage(struct Software_Triangle const * triangle, s32 x, r32 py, r32 edges[3][4]) {
+#if defined(SOFTWARE_SSE2)
+	__m128 const px = _mm_add_ps(_mm_set1_ps((r32)x + 0.5f), _mm_set_ps(3, 2, 1, 0));
+	__m128 const py4 = _mm_set1_ps(py);
+	__m128 const zero = _mm_setzero_ps();
+	int mask = 0xf;
+	for (u32 i = 0; i < 3; ++i) {
+		__m128 const value = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle->a[i]), px), _mm_mul_ps(_mm_set1_ps(triangle->b[i]), py4)),
+			_mm_set1_ps(triangle->c[i])
+		);
+		_mm_storeu_ps(edges[i], value);
+		mask &= _mm_movemask_ps(triangle->owner[i] ? _mm_cmpge_ps(value, zero) : _mm_cmpgt_ps(value, zero));
+	}
+	return (u32)mask;
+#else
+	u32 mask = 0xf;
+	for (u32 i = 0; i < 3; ++i) {
+		for (u32 lane = 0; lane < 4; ++lane) {
+			r32 const px = ((r32)x + 0.5f) + (r32)lane;
+			r32 const value = triangle->a[i] * px + triangle->b[i] * py + triangle->c[i];
+			edges[i][lane] = value;
+			if (triangle->owner[i] ? !(value >= 0) : !(value > 0)) { mask &= ~(1u << lane); }
+		}
+	}
+	return mask;
+#endif // SOFTWARE_SSE2
+}
+
+static void impl_shade_tile(u32 tile) {
+	struct Software_Bin const * bin = rvm->bins + tile;
+	s32 const tile_x = (s32)(tile % (u32)rvm->tiles.x) * SOFTWARE_TILE_SIZE;
+	s32 const tile_y = (s32)(tile / (u32)rvm->tiles.x) * SOFTWARE_TILE_SIZE;
+
+	// the bin keeps the submission order, so blending stays ordered within the tile
+	for (u32 i = 0; i < bin->count; ++i) {
+		struct Software_Triangle const * triangle = rvm->triangles + bin->triangles[i];
+		struct Software_Draw const * draw = rvm->draws + triangle->draw;
+
+		s32 const min_x = max_s32(triangle->min.x, tile_x), max_x = min_s32(triangle->max.x, tile_x + SOFTWARE_TILE_SIZE - 1);
+		s32 const min_y = max_s32(triangle->min.y, tile_y), max_y = min_s32(triangle->max.y, tile_y + SOFTWARE_TILE_SIZE - 1);
+		for (s32 y = min_y; y <= max_y; ++y) {
+			r32 const py = (r32)y + 0.5f;
+			for (s32 x = min_x; x <= max_x; x += 4) {
+				r32 edges[3][4];
+				u32 mask = impl_coverage(triangle, x, py, edges);
+				if (max_x - x < 3) { mask &= (1u << (max_x - x + 1)) - 1; }
+
+				for (u32 lane = 0; mask; ++lane, mask >>= 1) {
+					if (!(mask & 1)) { continue; }
+					r32 const lane_edges[3] = {edges[0][lane], edges[1][lane], edges[2][lane]};
+					impl_shade_pixel(draw, triangle, x + (s32)lane, y, lane_edges);
+				}
+			}
+		}
+	}
+}
+
+// tiles are interleaved between the VM thread and the workers
+static void impl_shade_share(u32 share) {
+	u32 const shares = rvm->workers_count + 1;
+	u32 const tiles = (u32)rvm->tiles.x * (u32)rvm->tiles.y;
+	for (u32 tile = share; tile < tiles; tile += shares) {
+		if (rvm->bins[tile].count) { impl_shade_tile(tile); }
+	}
+}
+
+static void impl_worker_proc(void * data) {
+	struct Software_Worker const * worker = data;
+	for (;;) {
+		engine_semaphore_wait(worker->start);
+		if (rvm->workers_stop) { break; }
+		impl_shade_share(worker->share);
+		engine_semaphore_signal(rvm->workers_done);
+	}
+}
+
+static void impl_flush(void) {
+	if (rvm->triangles_count) {
+		for (u32 i = 0; i < rvm->workers_count; ++i) {
+			engine_semaphore_signal(rvm->workers[i].start);
+		}
+		impl_shade_share(0);
+		for (u32 i = 0; i < rvm->workers_count; ++i) {
+			engine_semaphore_wait(rvm->workers_done);
+		}
+
+		u32 const tiles = (u32)rvm->tiles.x * (u32)rvm->tiles.y;
+		for (u32 i = 0; i < tiles; ++i) { rvm->bins[i].count = 0; }
+		rvm->triangles_count = 0;
+		rvm->draws_count = 0;
+		rvm->draw_changed = true;
+		rvm->surface_changed = true;
+	}
+	if (rvm->surface_changed) { impl_target_store(); }
+}
+
+// Common
+static void impl_Common_Set_Clip(struct RVM_Common_Set_Clip const * payload) {
+	if (!impl_state_changed(rvm->state.lower_left != payload->lower_left || rvm->state.zero_one != payload->zero_one)) { return; }
+	rvm->state.lower_left = payload->lower_left;
+	rvm->state.zero_one = payload->zero_one;
+}
+
+static void impl_Common_Set_Viewport(struct RVM_Common_Set_Viewport const * payload) {
+	svec2 const pos = payload->pos, size = payload->size;
+	if (!impl_state_changed(
+		rvm->state.viewport_pos.x  != pos.x  || rvm->state.viewport_pos.y  != pos.y ||
+		rvm->state.viewport_size.x != size.x || rvm->state.viewport_size.y != size.y
+	)) { return; }
+	rvm->state.viewport_pos = pos; rvm->state.viewport_size = size;
+}
+
+// Color
+static void impl_Color_Set_Write(struct RVM_Color_Set_Write const * payload) {
+	if (!impl_state_changed(rvm->state.color_write != payload->value)) { return; }
+	rvm->state.color_write = payload->value;
+}
+
+static void impl_Color_Set_Clear(struct RVM_Color_Set_Clear const * payload) {
+	// floats are compared bitwise, as the GL backend does
+	vec4 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.color_clear, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.color_clear = value;
+}
+
+static void impl_Color_Set_Blend(struct RVM_Color_Set_Blend const * payload) {
+	if (!impl_state_changed(rvm->state.blend != payload->value)) { return; }
+	rvm->state.blend = payload->value;
+}
+
+// Depth
+static void impl_Depth_Set_Read(struct RVM_Depth_Set_Read const * payload) {
+	if (!impl_state_changed(rvm->state.depth_test != payload->value)) { return; }
+	rvm->state.depth_test = payload->value;
+}
+
+static void impl_Depth_Set_Write(struct RVM_Depth_Set_Write const * payload) {
+	if (!impl_state_changed(rvm->state.depth_write != payload->value)) { return; }
+	rvm->state.depth_write = payload->value;
+}
+
+static void impl_Depth_Set_Clear(struct RVM_Depth_Set_Clear const * payload) {
+	if (!impl_state_changed(memcmp(&rvm->state.depth_clear, &payload->value, sizeof(payload->value)) != 0)) { return; }
+	rvm->state.depth_clear = payload->value;
+}
+
+static void impl_Depth_Set_Comparison(struct RVM_Depth_Set_Comparison const * payload) {
+	if (!impl_state_changed(rvm->state.depth_comparison != payload->value)) { return; }
+	rvm->state.depth_comparison = payload->value;
+}
+
+static void impl_Depth_Set_Range(struct RVM_Depth_Set_Range const * payload) {
+	vec2 const value = payload->value;
+	if (!impl_state_changed(memcmp(&rvm->state.depth_range, &value, sizeof(value)) != 0)) { return; }
+	rvm->state.depth_range = value;
+}
+
+// Stencil
+static void impl_Stencil_Set_Read(struct RVM_Stencil_Set_Read const * payload) {
+	if (!impl_state_changed(rvm->state.stencil_test != payload->value)) { return; }
+	rvm->state.stencil_test = payload->value;
+}
+
+static void impl_Stencil_Set_Write(struct RVM_Stencil_Set_Write const * payload) {
+	if (!impl_state_changed(rvm->state.stencil_write != payload->value)) { return; }
+	rvm->state.stencil_write = payload->value;
+}
+
+static void impl_Stencil_Set_Clear(struct RVM_Stencil_Set_Clear const * payload) {
+	if (!impl_state_changed(rvm->state.stencil_clear != payload->value)) { return; }
+	rvm->state.stencil_clear = payload->value;
+}
+
+static void impl_Stencil_Set_Comparison(struct RVM_Stencil_Set_Comparison const * payload) {
+	if (!impl_state_changed(
+		rvm->state.stencil_comparison != payload->comparison ||
+		rvm->state.stencil_reference != payload->reference ||
+		rvm->state.stencil_mask != payload->mask
+	)) { return; }
+	rvm->state.stencil_comparison = payload->comparison;
+	rvm->state.stencil_reference = payload->reference;
+	rvm->state.stencil_mask = payload->mask;
+}
+
+static void impl_Stencil_Set_Operation(struct RVM_Stencil_Set_Operation const * payload) {
+	if (!impl_state_changed(
+		rvm->state.stencil_fail != payload->stencil_fail__depth_any ||
+		rvm->state.stencil_depth_fail != payload->stencil_success__depth_fail ||
+		rvm->state.stencil_depth_pass != payload->stencil_success__depth_success
+	)) { return; }
+	rvm->state.stencil_fail = payload->stencil_fail__depth_any;
+	rvm->state.stencil_depth_fail = payload->stencil_success__depth_fail;
+	rvm->state.stencil_depth_pass = payload->stencil_success__depth_success;
+}
+
+// Vertex
+static void impl_Face_Set_Cull(struct RVM_Face_Set_Cull const * payload) {
+	if (!impl_state_changed(rvm->state.cull_mode != payload->value)) { return; }
+	rvm->state.cull_mode = payload->value;
+}
+
+static void impl_Face_Set_Front(struct RVM_Face_Set_Front const * payload) {
+	if (!impl_state_changed(rvm->state.front_face != payload->value)) { return; }
+	rvm->state.front_face = payload->value;
+}
+
+// Shader
+static void impl_Shader_Allocate(struct RVM_Shader_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+	impl_claim(rvm->shaders, ref);
+}
+
+static void impl_Shader_Free(struct RVM_Shader_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	// pending draws keep their own copy of the shader state
+	if (!impl_find(rvm->shaders, ref)) { return; }
+	engine_ref_pool_release(rvm->shaders, ref);
+	rvm->draw_changed = true;
+}
+
+static void impl_Shader_Load(struct RVM_Shader_Load const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Shader * shader = impl_find(rvm->shaders, ref);
+	if (!shader) { return; }
+
+	shader->native = impl_find_native_shader(&payload->asset);
+	rvm->draw_changed = true;
+}
+
+static void impl_Shader_Use(struct RVM_Shader_Use const * payload) {
+	struct Ref ref = payload->ref;
+	if (ref.id != REF_EMPTY_ID && !impl_find(rvm->shaders, ref)) { ref = (struct Ref){.id = REF_EMPTY_ID}; }
+	impl_ref_changed(&rvm->state.shader, ref);
+}
+
+static void impl_Shader_Uniform(struct RVM_Shader_Uniform const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+	if (payload->uniform >= RVM_Uniform_Count) { ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Shader * shader = impl_find(rvm->shaders, ref);
+	if (!shader) { return; }
+
+	// values follow the payload
+	size_t const size = (size_t)impl_data_type_size(payload->type) * payload->count;
+	size_t const available = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Shader_Uniform];
+	if (size > available || size > sizeof(shader->uniforms[0])) { ENGINE_DEBUG_BREAK(); return; }
+
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Shader_Uniform];
+	u32 const bit = 1u << payload->uniform;
+	if (!impl_state_changed(!(shader->uniforms_set & bit) || memcmp(shader->uniforms[payload->uniform], data, size) != 0)) { return; }
+
+	shader->uniforms_set |= bit;
+	memset(shader->uniforms[payload->uniform], 0, sizeof(shader->uniforms[0]));
+	memcpy(shader->uniforms[payload->uniform], data, size);
+}
+
+// Mesh
+static void impl_Mesh_Allocate(struct RVM_Mesh_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Mesh * mesh = impl_claim(rvm->meshes, ref);
+	if (!mesh) { return; }
+
+	impl_mesh_load(mesh, &payload->asset);
+}
+
+static void impl_Mesh_Free(struct RVM_Mesh_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	// vertices are processed at draw time, pending triangles do not reference meshes
+	struct VM_Mesh * mesh = impl_find(rvm->meshes, ref);
+	if (!mesh) { return; }
+
+	ENGINE_FREE(mesh->data);
+	engine_ref_pool_release(rvm->meshes, ref);
+}
+
+static void impl_Mesh_Load(struct RVM_Mesh_Load const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Mesh * mesh = impl_find(rvm->meshes, ref);
+	if (!mesh) { return; }
+
+	impl_mesh_load(mesh, &payload->asset);
+}
+
+static void impl_Mesh_Use(struct RVM_Mesh_Use const * payload) {
+	struct Ref ref = payload->ref;
+	if (ref.id != REF_EMPTY_ID && !impl_find(rvm->meshes, ref)) { ref = (struct Ref){.id = REF_EMPTY_ID}; }
+	impl_ref_changed(&rvm->state.mesh, ref);
+}
+
+// Texture
+static void impl_Texture_Allocate(struct RVM_Texture_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	// pending draws point at texels, a fresh slot has none
+	struct VM_Texture * texture = impl_claim(rvm->textures, ref);
+	if (!texture) { return; }
+
+	impl_texture_load(texture, &payload->asset);
+	rvm->draw_changed = true;
+}
+
+static void impl_Texture_Free(struct RVM_Texture_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Texture * texture = impl_find(rvm->textures, ref);
+	if (!texture) { return; }
+	if (texture->attachment) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	// pending triangles might sample it
+	impl_flush();
+
+	ENGINE_FREE(texture->texels);
+	engine_ref_pool_release(rvm->textures, ref);
+	rvm->draw_changed = true;
+}
+
+static void impl_Texture_Load(struct RVM_Texture_Load const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Texture * texture = impl_find(rvm->textures, ref);
+	if (!texture) { return; }
+
+	// pending triangles might sample it
+	impl_flush();
+
+	impl_texture_load(texture, &payload->asset);
+	rvm->draw_changed = true;
+}
+
+// Sampler
+static void impl_Sampler_Allocate(struct RVM_Sampler_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct RVM_Sampler const * value = &payload->value;
+	bool const valid = (u32)value->filter_mipmap <= Filter_Type_Linear
+	                && (u32)value->filter_min    <= Filter_Type_Linear
+	                && (u32)value->filter_max    <= Filter_Type_Linear
+	                && (u32)value->wrap_x        <= Wrap_Type_MRepeat
+	                && (u32)value->wrap_y        <= Wrap_Type_MRepeat;
+	if (!valid) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Sampler * sampler = impl_claim(rvm->samplers, ref);
+	if (!sampler) { return; }
+
+	sampler->value = *value;
+}
+
+static void impl_Sampler_Free(struct RVM_Sampler_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+	if (!impl_find(rvm->samplers, ref)) { return; }
+
+	// pending draws keep a copy of the settings
+	for (u32 i = 0; i < VM_TEXTURE_UNITS; ++i) {
+		struct Ref const used = rvm->state.samplers[i];
+		if (used.id != ref.id || used.gen != ref.gen) { continue; }
+		impl_ref_changed(&rvm->state.samplers[i], (struct Ref){.id = REF_EMPTY_ID});
+	}
+	engine_ref_pool_release(rvm->samplers, ref);
+}
+
+static void impl_Sampler_Use(struct RVM_Sampler_Use const * payload) {
+	if (payload->unit >= VM_TEXTURE_UNITS) { ENGINE_DEBUG_BREAK(); return; }
+	struct Ref ref = payload->ref;
+	if (ref.id != REF_EMPTY_ID && !impl_find(rvm->samplers, ref)) { ref = (struct Ref){.id = REF_EMPTY_ID}; }
+	impl_ref_changed(&rvm->state.samplers[payload->unit], ref);
+}
+
+// Unit
+static void impl_Unit_Allocate(struct RVM_Unit_Allocate const * payload) {
+	if (payload->unit >= VM_TEXTURE_UNITS) { ENGINE_DEBUG_BREAK(); return; }
+	struct Ref ref = payload->texture;
+	if (ref.id != REF_EMPTY_ID && !impl_find(rvm->textures, ref)) { ref = (struct Ref){.id = REF_EMPTY_ID}; }
+	impl_ref_changed(&rvm->state.textures[payload->unit], ref);
+}
+
+static void impl_Unit_Free(struct RVM_Unit_Free const * payload) {
+	if (payload->unit >= VM_TEXTURE_UNITS) { ENGINE_DEBUG_BREAK(); return; }
+	impl_ref_changed(&rvm->state.textures[payload->unit], (struct Ref){.id = REF_EMPTY_ID});
+}
+
+// Render
+// the write masks apply, as they do for GL
+static void impl_clear_color(u32 * color, size_t pixels, vec4 value) {
+	struct VM_State const * state = &rvm->state;
+	if (!color || state->color_write == RVM_Color_Write_None) { return; }
+
+	struct Software_Draw const draw = {.blend = RVM_Color_Blend_Opaque, .color_write = state->color_write};
+	if (state->color_write == RVM_Color_Write_All) {
+		u32 const packed = impl_pack_color(value);
+		for (size_t i = 0; i < pixels; ++i) { color[i] = packed; }
+	}
+	else {
+		for (size_t i = 0; i < pixels; ++i) { impl_write_color(&draw, color + i, value); }
+	}
+	rvm->surface_changed = true;
+}
+
+static void impl_clear_depth(r32 * depth, size_t pixels, r32 value) {
+	if (!depth || !rvm->state.depth_write) { return; }
+	value = clamp_r32(value, 0, 1);
+	for (size_t i = 0; i < pixels; ++i) { depth[i] = value; }
+	rvm->surface_changed = true;
+}
+
+static void impl_clear_stencil(u8 * stencil, size_t pixels, u8 value) {
+	u8 const mask = rvm->state.stencil_write;
+	if (!stencil || !mask) { return; }
+	for (size_t i = 0; i < pixels; ++i) { stencil[i] = (u8)((stencil[i] & ~mask) | (value & mask)); }
+	rvm->surface_changed = true;
+}
+
+static void impl_Render_Clear(struct RVM_Render_Clear const * payload) {
+	impl_flush();
+
+	struct VM_State const * state = &rvm->state;
+	struct Software_Surface const * surface = &rvm->surface;
+	size_t const pixels = (size_t)surface->size.x * (size_t)surface->size.y;
+	if ((payload->mask & RVM_Clear_Color)   == RVM_Clear_Color)   { impl_clear_color(surface->color, pixels, state->color_clear); }
+	if ((payload->mask & RVM_Clear_Depth)   == RVM_Clear_Depth)   { impl_clear_depth(surface->depth, pixels, state->depth_clear); }
+	if ((payload->mask & RVM_Clear_Stencil) == RVM_Clear_Stencil) { impl_clear_stencil(surface->stencil, pixels, state->stencil_clear); }
+}
+
+static void impl_draw(u32 offset, u32 length, struct VM_Mesh const * instances, u32 instances_offset, u32 count) {
+	struct VM_State const * state = &rvm->state;
+	if (state->cull_mode == RVM_Face_Cull_Both) { return; }
+
+	// the bound ones might have been freed since
+	struct VM_Shader const * shader = engine_ref_pool_get(rvm->shaders, state->shader);
+	struct VM_Mesh const * mesh = engine_ref_pool_get(rvm->meshes, state->mesh);
+	if (!shader || !mesh) { return; }
+	if (!shader->native || !mesh->data) { return; }
+	if (impl_mesh_is_stale(mesh) || (instances && impl_mesh_is_stale(instances))) { return; }
+	if (offset > mesh->vertices_count || length > mesh->vertices_count - offset) { ENGINE_DEBUG_BREAK(); return; }
+
+	// absent attributes read as (0, 0, 0, 1)
+	static r32 const attribute_default[4] = {0, 0, 0, 1};
+	u32 const varyings_count = shader->native->varyings_count;
+
+	// per vertex locations, an instance stream takes over the ones from its `location` on
+	r32 const * attributes[ASSET_MESH_ATTRIBUTES];
+	u32 instance_location = ASSET_MESH_ATTRIBUTES;
+	if (instances) {
+		u32 const elements = (count + instances->divisor - 1) / instances->divisor;
+		if (instances_offset > instances->vertices_count || elements > instances->vertices_count - instances_offset) { ENGINE_DEBUG_BREAK(); return; }
+		instance_location = instances->location;
+	}
+
+	u32 draw_index = impl_draw_snapshot(shader);
+	if (draw_index == UINT32_MAX) { ENGINE_DEBUG_BREAK(); return; }
+
+	for (u32 instance = 0; instance < count; ++instance) {
+		if (instances) {
+			r32 const * element = instances->data + (size_t)(instances_offset + instance / instances->divisor) * instances->stride;
+			for (u32 location = instance_location; location < ASSET_MESH_ATTRIBUTES; ++location) {
+				u32 const attribute = location - instance_location;
+				attributes[location] = (attribute < instances->attributes_count) ? element + instances->offsets[attribute] : attribute_default;
+			}
+		}
+
+		for (u32 i = 0; i + 3 <= length; i += 3) {
+			if (rvm->triangles_count + SOFTWARE_CLIP_VERTICES - 2 > SOFTWARE_TRIANGLES_MAX) {
+				impl_flush();
+				draw_index = impl_draw_snapshot(shader);
+				if (draw_index == UINT32_MAX) { ENGINE_DEBUG_BREAK(); return; }
+			}
+
+			// vertices run here, on the VM thread; the pending draw holds the uniforms they read
+			struct Software_Draw const * draw = rvm->draws + draw_index;
+			struct Software_Vertex vertices[3];
+			for (u32 vertex_i = 0; vertex_i < 3; ++vertex_i) {
+				r32 const * vertex = mesh->data + (size_t)(offset + i + vertex_i) * mesh->stride;
+				for (u32 location = 0; location < instance_location; ++location) {
+					attributes[location] = (location < mesh->attributes_count) ? vertex + mesh->offsets[location] : attribute_default;
+				}
+				vertices[vertex_i].position = shader->native->vertex(draw, attributes, vertices[vertex_i].varyings);
+			}
+
+			impl_clip_triangle(draw_index, vertices, varyings_count);
+		}
+	}
+}
+
+static void impl_Render_Draw(struct RVM_Render_Draw const * payload) {
+	impl_draw(payload->offset, payload->length, NULL, 0, 1);
+}
+
+static void impl_Render_Draw_Instanced(struct RVM_Render_Draw_Instanced const * payload) {
+	struct Ref const ref = payload->instances;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Mesh const * instances = impl_find(rvm->meshes, ref);
+	if (!instances || !instances->data) { return; }
+	if (!instances->divisor) { printf("[wrn] an instance stream needs a divisor\n"); return; }
+
+	impl_draw(payload->offset, payload->length, instances, payload->instances_offset, payload->count);
+}
+
+static void impl_Render_Draw_Indirect(struct RVM_Render_Draw_Indirect const * payload) {
+	// arguments follow the payload
+	struct RVM_Draw_Arguments const * arguments = (void const *)((u8 const *)payload + impl_payload_sizes[RVM_Instruction_Render_Draw_Indirect]);
+	size_t const available = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Render_Draw_Indirect];
+	if ((u64)payload->count * sizeof(*arguments) > available) { ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Mesh const * instances = NULL;
+	if (payload->instances.id != REF_EMPTY_ID) {
+		instances = impl_find(rvm->meshes, payload->instances);
+		if (!instances || !instances->data) { return; }
+		if (!instances->divisor) { printf("[wrn] an instance stream needs a divisor\n"); return; }
+	}
+
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Draw_Arguments const * draw = arguments + i;
+		impl_draw(draw->offset, draw->length, instances, draw->instances_offset, draw->count);
+	}
+}
+
+// Pipeline
+static void impl_Pipeline_Allocate(struct RVM_Pipeline_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Pipeline * pipeline = impl_claim(rvm->pipelines, ref);
+	if (!pipeline) { return; }
+
+	pipeline->value = payload->value;
+}
+
+static void impl_Pipeline_Free(struct RVM_Pipeline_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	if (!impl_find(rvm->pipelines, ref)) { return; }
+	engine_ref_pool_release(rvm->pipelines, ref);
+}
+
+static void impl_Pipeline_Use(struct RVM_Pipeline_Use const * payload) {
+	struct Ref const ref = payload->ref;
+
+	// an empty ref resets to what a fresh context has
+	struct RVM_Pipeline const * value = &impl_pipeline_defaults;
+	if (ref.id != REF_EMPTY_ID) {
+		struct VM_Pipeline const * pipeline = impl_find(rvm->pipelines, ref);
+		if (!pipeline) { return; }
+		value = &pipeline->value;
+	}
+
+	// the state is kept as RVM values, each setter compares in place
+	impl_Shader_Use(&value->shader);
+	impl_Color_Set_Write(&value->color_write);
+	impl_Color_Set_Blend(&value->blend);
+	impl_Depth_Set_Read(&value->depth_read);
+	impl_Depth_Set_Write(&value->depth_write);
+	impl_Depth_Set_Comparison(&value->depth_comparison);
+	impl_Stencil_Set_Read(&value->stencil_read);
+	impl_Stencil_Set_Write(&value->stencil_write);
+	impl_Stencil_Set_Comparison(&value->stencil_comparison);
+	impl_Stencil_Set_Operation(&value->stencil_operation);
+	impl_Face_Set_Cull(&value->cull);
+	impl_Face_Set_Front(&value->front);
+}
+
+// Bundle
+static void impl_Bundle_Allocate(struct RVM_Bundle_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Bundle_Allocate];
+	u32 const length = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Bundle_Allocate];
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	u32 const count = impl_bundle_decode(data, length, NULL);
+	if (count == UINT32_MAX) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Bundle * bundle = impl_claim(rvm->bundles, ref);
+	if (!bundle) { return; }
+
+	size_t const ops_size = RVM_ALIGN(count * sizeof(*bundle->ops));
+	bundle->ops = ENGINE_MALLOC(ops_size + length);
+	if (!bundle->ops && ops_size + length) { ENGINE_DEBUG_BREAK(); return; }
+	bundle->data = (u8 *)bundle->ops + ops_size;
+	bundle->count = count;
+	if (length) { memcpy(bundle->data, data, length); }
+	impl_bundle_decode(bundle->data, length, bundle->ops);
+}
+
+static void impl_Bundle_Free(struct RVM_Bundle_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Bundle const * bundle = impl_find(rvm->bundles, ref);
+	if (!bundle) { return; }
+
+	ENGINE_FREE(bundle->ops);
+	engine_ref_pool_release(rvm->bundles, ref);
+}
+
+static void impl_Bundle_Call(struct RVM_Bundle_Call const * payload) {
+	struct VM_Bundle const * bundle = impl_find(rvm->bundles, payload->ref);
+	if (!bundle) { return; }
+
+	for (u32 i = 0; i < bundle->count; ++i) {
+		struct VM_Bundle_Op const * op = bundle->ops + i;
+		rvm->payload_size = op->size;
+		impl_handlers[op->instruction](bundle->data + op->offset);
+	}
+}
+
+static void impl_Bundle_Patch(struct RVM_Bundle_Patch const * payload) {
+	struct VM_Bundle const * bundle = impl_find(rvm->bundles, payload->ref);
+	if (!bundle) { return; }
+
+	u8 const * data = (u8 const *)payload + impl_payload_sizes[RVM_Instruction_Bundle_Patch];
+	u32 const length = rvm->payload_size - impl_payload_sizes[RVM_Instruction_Bundle_Patch];
+	if (payload->slot >= bundle->count || length < sizeof(struct RVM_Header)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	// only a payload of the same kind and size fits in place
+	struct VM_Bundle_Op const * op = bundle->ops + payload->slot;
+	struct RVM_Header const * header = (void const *)data;
+	if (header->instruction != op->instruction || header->size != op->size) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+	if (header->size > length - sizeof(*header)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	memcpy(bundle->data + op->offset, data + sizeof(*header), op->size);
+}
+
+// Target, drawn into in place of the window while in use; single sampled, the sampled attachments are stored on flush
+static void impl_Target_Allocate(struct RVM_Target_Allocate const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+	if (!impl_target_valid(payload)) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	struct VM_Target * target = impl_claim(rvm->targets, ref);
+	if (!target) { return; }
+
+	*target = (struct VM_Target){.count = payload->count};
+	for (u32 i = 0; i < payload->count; ++i) {
+		struct RVM_Target_Attachment const * attachment = payload->attachments + i;
+		target->kinds[i] = attachment->kind;
+		target->textures[i] = (struct Ref){.id = REF_EMPTY_ID};
+		if (attachment->texture.id == REF_EMPTY_ID) { continue; }
+
+		// the sampled attachments are textures of the stream, owned by the target
+		struct VM_Texture * texture = impl_claim(rvm->textures, attachment->texture);
+		if (!texture) { continue; }
+
+		texture->attachment = true;
+		target->textures[i] = attachment->texture;
+	}
+
+	if (!impl_target_buffers(target, payload->size)) {
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		impl_target_free_buffers(target);
+	}
+	rvm->draw_changed = true;
+}
+
+static void impl_Target_Free(struct RVM_Target_Free const * payload) {
+	struct Ref const ref = payload->ref;
+
+	if (ref.id == REF_EMPTY_ID) { return; }
+
+	struct VM_Target * target = impl_find(rvm->targets, ref);
+	if (!target) { return; }
+
+	// pending triangles might be drawn into it or sample its textures
+	impl_flush();
+
+	if (rvm->state.target.id == ref.id && rvm->state.target.gen == ref.gen) {
+		rvm->state.target = (struct Ref){.id = REF_EMPTY_ID};
+		impl_surface_use(&rvm->window);
+	}
+	for (u32 i = 0; i < target->count; ++i) {
+		struct VM_Texture * texture = engine_ref_pool_get(rvm->textures, target->textures[i]);
+		if (!texture) { continue; }
+		ENGINE_FREE(texture->texels);
+		engine_ref_pool_release(rvm->textures, target->textures[i]);
+	}
+	impl_target_free_buffers(target);
+	engine_ref_pool_release(rvm->targets, ref);
+	rvm->draw_changed = true;
+}
+
+static void impl_Target_Load(struct RVM_Target_Load const * payload) {
+	struct VM_Target * target = impl_find(rvm->targets, payload->ref);
+	if (!target) { return; }
+	if (payload->size.x <= 0 || payload->size.y <= 0) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	// pending triangles might be drawn into it or sample its textures
+	impl_flush();
+
+	if (!impl_target_buffers(target, payload->size)) {
+		rvm->stats.errors++; ENGINE_DEBUG_BREAK();
+		impl_target_free_buffers(target);
+	}
+	if (rvm->state.target.id == payload->ref.id && rvm->state.target.gen == payload->ref.gen) {
+		struct Software_Surface const surface = impl_target_surface(target);
+		impl_surface_use(&surface);
+	}
+	rvm->draw_changed = true;
+}
+
+static void impl_Target_Use(struct RVM_Target_Use const * payload) {
+	struct Ref ref = payload->ref;
+	struct VM_Target const * target = NULL;
+	if (ref.id != REF_EMPTY_ID) {
+		target = impl_find(rvm->targets, ref);
+		if (!target) { return; }
+	}
+
+	// pending triangles are of the surface in use
+	if (rvm->state.target.id != ref.id || rvm->state.target.gen != ref.gen) { impl_flush(); }
+	if (!impl_ref_changed(&rvm->state.target, ref)) { return; }
+
+	if (!target) { impl_surface_use(&rvm->window); return; }
+	struct Software_Surface const surface = impl_target_surface(target);
+	impl_surface_use(&surface);
+}
+
+static void impl_Target_Clear(struct RVM_Target_Clear const * payload) {
+	struct VM_Target const * target = engine_ref_pool_get(rvm->targets, rvm->state.target);
+	if (!target) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+	if (payload->attachment >= target->count) { rvm->stats.errors++; ENGINE_DEBUG_BREAK(); return; }
+
+	impl_flush();
+
+	size_t const pixels = (size_t)target->size.x * (size_t)target->size.y;
+	switch (target->kinds[payload->attachment]) {
+		case Texture_Type_Color:    impl_clear_color(target->colors[payload->attachment], pixels, payload->color); break;
+		case Texture_Type_Depth:    impl_clear_depth(target->depth, pixels, payload->depth); break;
+		case Texture_Type_Stencil:  impl_clear_stencil(target->stencil, pixels, payload->stencil); break;
+		case Texture_Type_DStencil: {
+			impl_clear_depth(target->depth, pixels, payload->depth);
+			impl_clear_stencil(target->stencil, pixels, payload->stencil);
+		} break;
+	}
+}
+
+//
+// native shaders API
+//
+
+void const * engine_rendering_software_get_uniform(struct Software_Draw const * draw, enum RVM_Uniform uniform) {
+	if ((u32)uniform >= RVM_Uniform_Count) { return NULL; }
+	if (!(draw->uniforms_set & (1u << uniform))) { return NULL; }
+	return draw->uniforms[uniform];
+}
+
+vec4 engine_rendering_software_sample(struct Software_Draw const * draw, u32 unit, vec2 uv) {
+	// an incomplete texture reads as (0, 0, 0, 1)
+	if (unit >= VM_TEXTURE_UNITS) { return VEC4(0, 0, 0, 1); }
+	struct Software_Sampler const * sampler = draw->units + unit;
+	if (!sampler->texels) { return VEC4(0, 0, 0, 1); }
+
+	r32 const u = impl_texel_coordinate(uv.x, sampler->size.x);
+	r32 const v = impl_texel_coordinate(uv.y, sampler->size.y);
+	if (sampler->filter != Filter_Type_Linear) {
+		return impl_texel(sampler, (s32)floorf(u), (s32)floorf(v));
+	}
+
+	r32 const fu = floorf(u - 0.5f), fv = floorf(v - 0.5f);
+	r32 const tu = (u - 0.5f) - fu, tv = (v - 0.5f) - fv;
+	s32 const x = (s32)fu, y = (s32)fv;
+	vec4 const t00 = impl_texel(sampler, x,     y);
+	vec4 const t10 = impl_texel(sampler, x + 1, y);
+	vec4 const t01 = impl_texel(sampler, x,     y + 1);
+	vec4 const t11 = impl_texel(sampler, x + 1, y + 1);
+	return VEC4(
+		lerp(lerp(t00.x, t10.x, tu), lerp(t01.x, t11.x, tu), tv),
+		lerp(lerp(t00.y, t10.y, tu), lerp(t01.y, t11.y, tu), tv),
+		lerp(lerp(t00.z, t10.z, tu), lerp(t01.z, t11.z, tu), tv),
+		lerp(lerp(t00.w, t10.w, tu), lerp(t01.w, t11.w, tu), tv)
+	);
+}
+
+//
+#undef VM_TEXTURE_UNITS
+#undef SOFTWARE_TILE_SIZE
+#undef SOFTWARE_UNIFORM_WORDS
+#undef SOFTWARE_TRIANGLES_MAX
+#undef SOFTWARE_CLIP_VERTICES
+#undef SOFTWARE_UV_LIMIT
@@ -0,0 +1,75 @@
+#include "engine/api/code.h"
+#include "engine/api/maths.h"
+#include "engine/api/rendering_software.h"
+
+// native counterparts of `assets/shaders/*.glsl`, picked by `#pragma software(<name>)`
+
+// texture_tint
+static vec4 impl_texture_tint_vertex(struct Software_Draw const * draw, r32 const * const * attributes, r32 * varyings) {
+	mat4 const * camera    = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Camera);
+	mat4 const * transform = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Transform);
+
+	r32 const * position  = attributes[0];
+	r32 const * tex_coord = attributes[1];
+	varyings[0] = tex_coord[0];
+	varyings[1] = tex_coord[1];
+
+	vec4 result = VEC4(position[0], position[1], position[2], 1);
+	if (transform) { result = mat4_mul_vec(*transform, result); }
+	if (camera)    { result = mat4_mul_vec(*camera, result); }
+	return result;
+}
+
+static vec4 impl_texture_tint_fragment(struct Software_Draw const * draw, r32 const * varyings) {
+	s32  const * unit  = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Texture);
+	vec4 const * color = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Color);
+
+	vec4 const texel = engine_rendering_software_sample(draw, unit ? (u32)*unit : 0, VEC2(varyings[0], varyings[1]));
+	vec4 const tint = color ? *color : VEC4(1, 1, 1, 1);
+	return vec4_mul(texel, tint);
+}
+
+struct Software_Shader const software_shader_texture_tint = {
+	.name = "texture_tint",
+	.varyings_count = 2,
+	.vertex   = impl_texture_tint_vertex,
+	.fragment = impl_texture_tint_fragment,
+};
+
+// instanced_tint
+static vec4 impl_instanced_tint_vertex(struct Software_Draw const * draw, r32 const * const * attributes, r32 * varyings) {
+	mat4 const * camera    = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Camera);
+	mat4 const * transform = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Transform);
+
+	r32 const * position  = attributes[0];
+	r32 const * tex_coord = attributes[1];
+	r32 const * offset    = attributes[2];
+	r32 const * color     = attributes[3];
+	varyings[0] = tex_coord[0];
+	varyings[1] = tex_coord[1];
+	varyings[2] = color[0];
+	varyings[3] = color[1];
+	varyings[4] = color[2];
+	varyings[5] = color[3];
+
+	vec4 result = VEC4(position[0] + offset[0], position[1] + offset[1], position[2] + offset[2], 1);
+	if (transform) { result = mat4_mul_vec(*transform, result); }
+	if (camera)    { result = mat4_mul_vec(*camera, result); }
+	return result;
+}
+
+static vec4 impl_instanced_tint_fragment(struct Software_Draw const * draw, r32 const * varyings) {
+	s32  const * unit  = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Texture);
+	vec4 const * color = engine_rendering_software_get_uniform(draw, RVM_Uniform_u_Color);
+
+	vec4 const texel = engine_rendering_software_sample(draw, unit ? (u32)*unit : 0, VEC2(varyings[0], varyings[1]));
+	vec4 const tint = color ? *color : VEC4(1, 1, 1, 1);
+	return vec4_mul(vec4_mul(texel, tint), VEC4(varyings[2], varyings[3], varyings[4], varyings[5]));
+}
+
+struct Software_Shader const software_shader_instanced_tint = {
+	.name = "instanced_tint",
+	.varyings_count = 6,
+	.vertex   = impl_instanced_tint_vertex,
+	.fragment = impl_instanced_tint_fragment,
+};
@@ -0,0 +1,7 @@
+#if !defined(ENGINE_SYSTEM__TIME)
+#define ENGINE_SYSTEM__TIME
+
+void engine_system__time_init(void);
+void engine_system__time_deinit(void);
+
+#endif // ENGINE_SYSTEM__TIME
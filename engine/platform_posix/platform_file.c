@@ -0,0 +1,76 @@
+#include "engine/api/code.h"
+
+#include <sys/stat.h>
+
+//
+// API
+//
+
+#include "engine/api/platform_file.h"
+
+u64 engine_file_time(cstring path) {
+	struct stat file_stat;
+	if (stat(path, &file_stat)) {
+		printf("[err]: failed to find file: `%s`", path);
+		return 0;
+	}
+
+	u64 const time = (u64)file_stat.st_mtime;
+	return time ? time : 1;
+}
+
+size_t engine_file_read(cstring path, u8 ** buffer, size_t * buffer_size) {
+	FILE * file = fopen(path, "rb");
+	if (!file) {
+		printf("[err]: failed to open file: `%s`", path);
+		return 0;
+	}
+
+	if (fseek(file, 0, SEEK_END)) {
+		printf("[err]: failed to get file size: `%s`", path);
+		fclose(file); return 0;
+	}
+
+	long file_size = ftell(file);
+	if (file_size < 0) {
+		printf("[err]: failed to get file size: `%s`", path);
+		fclose(file); return 0;
+	}
+
+	if ((u64)file_size > UINT32_MAX) {
+		printf("[err]: file size is too large: `%s`", path);
+		fclose(file); return 0;
+	}
+
+	rewind(file);
+
+	*buffer_size = (size_t)file_size;
+	*buffer = ENGINE_MALLOC(*buffer_size);
+
+	size_t number_of_bytes_read = fread(*buffer, 1, *buffer_size, file);
+	if (number_of_bytes_read != *buffer_size) {
+		printf("[err]: failed to read file: `%s`", path);
+		ENGINE_FREE(*buffer); *buffer = NULL; *buffer_size = 0;
+		fclose(file); return 0;
+	}
+
+	fclose(file);
+	return number_of_bytes_read;
+}
+
+bool engine_file_write(cstring path, u8 const * buffer, size_t buffer_size) {
+	FILE * file = fopen(path, "wb");
+	if (!file) {
+		printf("[err]: failed to create file: `%s`", path);
+		return false;
+	}
+
+	size_t number_of_bytes_written = fwrite(buffer, 1, buffer_size, file);
+	if (number_of_bytes_written != buffer_size) {
+		printf("[err]: failed to write file: `%s`", path);
+		fclose(file); return false;
+	}
+
+	fclose(file);
+	return true;
+}
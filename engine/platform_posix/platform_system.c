@@ -0,0 +1,49 @@
+#include "engine/api/code.h"
+
+#include "interoperations/system__time.h"
+
+#include <signal.h>
+
+// headless platform layer: no windows and no rendering context
+
+//
+static void impl_signal_handler(int value);
+
+//
+// API
+//
+
+#include "engine/api/platform_system.h"
+
+bool engine_system_should_close;
+
+void engine_system_init(void) {
+	engine_system__time_init();
+
+	signal(SIGABRT, impl_signal_handler);
+	signal(SIGFPE,  impl_signal_handler);
+	signal(SIGILL,  impl_signal_handler);
+	signal(SIGINT,  impl_signal_handler);
+	signal(SIGSEGV, impl_signal_handler);
+	signal(SIGTERM, impl_signal_handler);
+}
+
+void engine_system_deinit(void) {
+	engine_system__time_deinit();
+}
+
+void engine_system_poll_events(void) {
+}
+
+//
+// internal implementation
+//
+
+static void impl_signal_handler(int value) {
+	switch (value) {
+		case SIGINT:  break;
+		case SIGTERM: break;
+		default: ENGINE_DEBUG_BREAK(); signal(value, SIG_DFL); raise(value); return;
+	}
+	engine_system_should_close = true;
+}
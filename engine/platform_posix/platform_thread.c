@@ -0,0 +1,74 @@
+#include "engine/api/code.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+static void * impl_thread_proc(void * data);
+
+//
+// API
+//
+
+#include "engine/api/platform_thread.h"
+
+struct Engine_Thread {
+	pthread_t handle;
+	Engine_Thread_Proc * proc;
+	void * data;
+};
+
+struct Engine_Thread * engine_thread_create(Engine_Thread_Proc * proc, void * data) {
+	struct Engine_Thread * thread = ENGINE_MALLOC(sizeof(*thread));
+	memset(thread, 0, sizeof(*thread));
+	thread->proc = proc;
+	thread->data = data;
+
+	if (pthread_create(&thread->handle, NULL, impl_thread_proc, thread)) {
+		printf("[err]: failed to create a thread\n");
+		ENGINE_FREE(thread); return NULL;
+	}
+
+	return thread;
+}
+
+void engine_thread_join(struct Engine_Thread * thread) {
+	pthread_join(thread->handle, NULL);
+	ENGINE_FREE(thread);
+}
+
+struct Engine_Semaphore {
+	sem_t handle;
+};
+
+struct Engine_Semaphore * engine_semaphore_create(u32 count) {
+	struct Engine_Semaphore * semaphore = ENGINE_MALLOC(sizeof(*semaphore));
+	if (sem_init(&semaphore->handle, 0, count)) {
+		printf("[err]: failed to create a semaphore\n");
+		ENGINE_FREE(semaphore); return NULL;
+	}
+	return semaphore;
+}
+
+void engine_semaphore_destroy(struct Engine_Semaphore * semaphore) {
+	sem_destroy(&semaphore->handle);
+	ENGINE_FREE(semaphore);
+}
+
+void engine_semaphore_wait(struct Engine_Semaphore * semaphore) {
+	while (sem_wait(&semaphore->handle) && errno == EINTR) { }
+}
+
+void engine_semaphore_signal(struct Engine_Semaphore * semaphore) {
+	sem_post(&semaphore->handle);
+}
+
+//
+// internal implementation
+//
+
+static void * impl_thread_proc(void * data) {
+	struct Engine_Thread * thread = data;
+	thread->proc(thread->data);
+	return NULL;
+}
@@ -0,0 +1,64 @@
+#include "engine/api/code.h"
+#include "engine/api/maths.h"
+
+#include <time.h>
+#include <sched.h>
+
+//
+static u64 engine_time_precision;
+
+//
+// API
+//
+
+#include "engine/api/platform_time.h"
+
+u64 engine_time_get_precision(void) {
+	return engine_time_precision;
+}
+
+u64 engine_time_get_ticks(void) {
+	struct timespec value;
+	clock_gettime(CLOCK_MONOTONIC, &value);
+	return (u64)value.tv_sec * ENGINE_TIME_NANOS + (u64)value.tv_nsec;
+}
+
+void engine_time_wait_idle(u64 start_ticks, u64 duration, u64 precision) {
+	u64 duration_ticks = mul_div_u64(duration, engine_time_precision, precision);
+	u64 frame_end_ticks = start_ticks + duration_ticks;
+	u64 current_ticks;
+	while (true) {
+		current_ticks = engine_time_get_ticks();
+		if (current_ticks >= frame_end_ticks) { break; }
+		sched_yield();
+	}
+}
+
+void engine_time_wait_sleep(u64 start_ticks, u64 duration, u64 precision) {
+	u64 duration_ticks = mul_div_u64(duration, engine_time_precision, precision);
+	u64 frame_end_ticks = start_ticks + duration_ticks;
+	u64 current_ticks;
+	while (true) {
+		current_ticks = engine_time_get_ticks();
+		if (current_ticks >= frame_end_ticks) { break; }
+		u64 sleep_nanos = mul_div_u64(frame_end_ticks - current_ticks, ENGINE_TIME_NANOS, engine_time_precision);
+		struct timespec const sleep_time = {
+			.tv_sec  = (time_t)(sleep_nanos / ENGINE_TIME_NANOS),
+			.tv_nsec = (long)(sleep_nanos % ENGINE_TIME_NANOS),
+		};
+		nanosleep(&sleep_time, NULL);
+	}
+}
+
+//
+// system API
+//
+
+#include "interoperations/system__time.h"
+
+void engine_system__time_init(void) {
+	engine_time_precision = ENGINE_TIME_NANOS;
+}
+
+void engine_system__time_deinit(void) {
+}
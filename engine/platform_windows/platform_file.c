@@ -56,3 +56,25 @@ size_t engine_file_read(cstring path, u8 ** buffer, size_t * buffer_size) {
 
 	return (size_t)number_of_bytes_read;
 }
+
+bool engine_file_write(cstring path, u8 const * buffer, size_t buffer_size) {
+	if (buffer_size > UINT32_MAX) {
+		printf("[err]: file size is too large: `%s`", path);
+		return false;
+	}
+
+	HANDLE handle = CreateFileA(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (handle == INVALID_HANDLE_VALUE) {
+		printf("[err]: failed to create file: `%s`", path);
+		return false;
+	}
+
+	DWORD number_of_bytes_written;
+	if (!WriteFile(handle, buffer, (DWORD)buffer_size, &number_of_bytes_written, NULL) || number_of_bytes_written != buffer_size) {
+		printf("[err]: failed to write file: `%s`", path);
+		CloseHandle(handle); return false;
+	}
+
+	CloseHandle(handle);
+	return true;
+}
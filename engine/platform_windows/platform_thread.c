@@ -0,0 +1,78 @@
+#include "engine/api/code.h"
+
+#include <Windows.h>
+
+static DWORD WINAPI impl_thread_proc(LPVOID data);
+
+//
+// API
+//
+
+#include "engine/api/platform_thread.h"
+
+struct Engine_Thread {
+	HANDLE handle;
+	Engine_Thread_Proc * proc;
+	void * data;
+};
+
+struct Engine_Thread * engine_thread_create(Engine_Thread_Proc * proc, void * data) {
+	struct Engine_Thread * thread = ENGINE_MALLOC(sizeof(*thread));
+	*thread = (struct Engine_Thread){
+		.proc = proc,
+		.data = data,
+	};
+
+	thread->handle = CreateThread(NULL, 0, impl_thread_proc, thread, 0, NULL);
+	if (!thread->handle) {
+		printf("[err]: failed to create a thread\n");
+		ENGINE_FREE(thread); return NULL;
+	}
+
+	return thread;
+}
+
+void engine_thread_join(struct Engine_Thread * thread) {
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+	ENGINE_FREE(thread);
+}
+
+struct Engine_Semaphore {
+	HANDLE handle;
+};
+
+struct Engine_Semaphore * engine_semaphore_create(u32 count) {
+	HANDLE handle = CreateSemaphoreA(NULL, (LONG)count, LONG_MAX, NULL);
+	if (!handle) {
+		printf("[err]: failed to create a semaphore\n");
+		return NULL;
+	}
+
+	struct Engine_Semaphore * semaphore = ENGINE_MALLOC(sizeof(*semaphore));
+	semaphore->handle = handle;
+	return semaphore;
+}
+
+void engine_semaphore_destroy(struct Engine_Semaphore * semaphore) {
+	CloseHandle(semaphore->handle);
+	ENGINE_FREE(semaphore);
+}
+
+void engine_semaphore_wait(struct Engine_Semaphore * semaphore) {
+	WaitForSingleObject(semaphore->handle, INFINITE);
+}
+
+void engine_semaphore_signal(struct Engine_Semaphore * semaphore) {
+	ReleaseSemaphore(semaphore->handle, 1, NULL);
+}
+
+//
+// internal implementation
+//
+
+static DWORD WINAPI impl_thread_proc(LPVOID data) {
+	struct Engine_Thread * thread = data;
+	thread->proc(thread->data);
+	return 0;
+}
@@ -28,6 +28,7 @@ static LRESULT CALLBACK impl_window_procedure(HWND hwnd, UINT message, WPARAM wP
 struct Engine_Window {
 	HWND handle;
 	struct Rendering_Context * rendering_context;
+	bool closed; // the context might belong to another thread, so destruction waits `engine_window_destroy`
 
 	svec2 size;
 	u8 vsync;
@@ -73,7 +74,7 @@ void engine_window_destroy(struct Engine_Window * window) {
 }
 
 bool engine_window_is_active(struct Engine_Window * window) {
-	return window->handle;
+	return window->handle && !window->closed;
 }
 
 void engine_window_init_context(struct Engine_Window * window) {
@@ -91,7 +92,10 @@ void engine_window_update(struct Engine_Window * window) {
 	memcpy(window->keyboard.prev, window->keyboard.keys, sizeof(window->keyboard.keys));
 	window->mouse.delta = SVEC2(0, 0);
 	window->mouse.wheel = VEC2(0, 0);
+}
 
+void engine_window_display(struct Engine_Window * window) {
+	if (!window->rendering_context) { return; }
 	engine_rendering_context_update(window->rendering_context);
 }
 
@@ -521,8 +525,7 @@ static LRESULT CALLBACK impl_window_procedure(HWND hwnd, UINT message, WPARAM wP
 			// if (window->callbacks.close) {
 			// 	(*window->callbacks.close)(window);
 			// }
-			window->handle = NULL;
-			DestroyWindow(hwnd);
+			window->closed = true;
 		} return 0;
 
 		case WM_DESTROY: {
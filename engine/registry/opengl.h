@@ -70,6 +70,12 @@ REGISTRY_OPENGL(PFNGLUNIFORM1UIVPROC, Uniform1uiv)
 REGISTRY_OPENGL(PFNGLUNIFORM2UIVPROC, Uniform2uiv)
 REGISTRY_OPENGL(PFNGLUNIFORM3UIVPROC, Uniform3uiv)
 REGISTRY_OPENGL(PFNGLUNIFORM4UIVPROC, Uniform4uiv)
+// >= 3.1
+REGISTRY_OPENGL(PFNGLGETACTIVEUNIFORMSIVPROC,       GetActiveUniformsiv)
+REGISTRY_OPENGL(PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC, GetActiveUniformBlockName)
+REGISTRY_OPENGL(PFNGLGETACTIVEUNIFORMBLOCKIVPROC,   GetActiveUniformBlockiv)
+REGISTRY_OPENGL(PFNGLUNIFORMBLOCKBINDINGPROC,       UniformBlockBinding)
+REGISTRY_OPENGL(PFNGLBINDBUFFERRANGEPROC,           BindBufferRange)
 // >= 4.1
 REGISTRY_OPENGL(PFNGLPROGRAMUNIFORM1FVPROC, ProgramUniform1fv)
 REGISTRY_OPENGL(PFNGLPROGRAMUNIFORM2FVPROC, ProgramUniform2fv)
@@ -96,6 +102,9 @@ REGISTRY_OPENGL(PFNGLBINDTEXTUREPROC,    BindTexture)
 REGISTRY_OPENGL(PFNGLTEXIMAGE2DPROC,     TexImage2D)
 REGISTRY_OPENGL(PFNGLTEXPARAMETERIPROC,  TexParameteri)
 REGISTRY_OPENGL(PFNGLTEXSUBIMAGE2DPROC,  TexSubImage2D)
+REGISTRY_OPENGL(PFNGLPIXELSTOREIPROC,    PixelStorei)
+// >= 3.0
+REGISTRY_OPENGL(PFNGLGENERATEMIPMAPPROC, GenerateMipmap)
 // >= 4.2
 REGISTRY_OPENGL(PFNGLTEXSTORAGE2DPROC, TexStorage2D)
 // >= 4.5
@@ -105,8 +114,28 @@ REGISTRY_OPENGL(PFNGLTEXTUREPARAMETERIPROC, TextureParameteri)
 REGISTRY_OPENGL(PFNGLBINDTEXTUREUNITPROC,   BindTextureUnit)
 REGISTRY_OPENGL(PFNGLTEXTURESUBIMAGE2DPROC, TextureSubImage2D)
 
+// FRAMEBUFFERS
+// >= 3.0
+REGISTRY_OPENGL(PFNGLGENFRAMEBUFFERSPROC,                   GenFramebuffers)
+REGISTRY_OPENGL(PFNGLDELETEFRAMEBUFFERSPROC,                DeleteFramebuffers)
+REGISTRY_OPENGL(PFNGLBINDFRAMEBUFFERPROC,                   BindFramebuffer)
+REGISTRY_OPENGL(PFNGLFRAMEBUFFERTEXTURE2DPROC,              FramebufferTexture2D)
+REGISTRY_OPENGL(PFNGLFRAMEBUFFERRENDERBUFFERPROC,           FramebufferRenderbuffer)
+REGISTRY_OPENGL(PFNGLCHECKFRAMEBUFFERSTATUSPROC,            CheckFramebufferStatus)
+REGISTRY_OPENGL(PFNGLBLITFRAMEBUFFERPROC,                   BlitFramebuffer)
+REGISTRY_OPENGL(PFNGLDRAWBUFFERSPROC,                       DrawBuffers)
+REGISTRY_OPENGL(PFNGLREADBUFFERPROC,                        ReadBuffer)
+REGISTRY_OPENGL(PFNGLGENRENDERBUFFERSPROC,                  GenRenderbuffers)
+REGISTRY_OPENGL(PFNGLDELETERENDERBUFFERSPROC,               DeleteRenderbuffers)
+REGISTRY_OPENGL(PFNGLBINDRENDERBUFFERPROC,                  BindRenderbuffer)
+REGISTRY_OPENGL(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC,    RenderbufferStorageMultisample)
+REGISTRY_OPENGL(PFNGLCLEARBUFFERFVPROC,                     ClearBufferfv)
+REGISTRY_OPENGL(PFNGLCLEARBUFFERIVPROC,                     ClearBufferiv)
+REGISTRY_OPENGL(PFNGLCLEARBUFFERUIVPROC,                    ClearBufferuiv)
+REGISTRY_OPENGL(PFNGLCLEARBUFFERFIPROC,                     ClearBufferfi)
+
 // SAMPLERS
-// >= 3.2
+// >= 3.3
 REGISTRY_OPENGL(PFNGLGENSAMPLERSPROC,       GenSamplers)
 REGISTRY_OPENGL(PFNGLDELETESAMPLERSPROC,    DeleteSamplers)
 REGISTRY_OPENGL(PFNGLBINDSAMPLERPROC,       BindSampler)
@@ -124,14 +153,21 @@ REGISTRY_OPENGL(PFNGLDISABLEVERTEXATTRIBARRAYPROC, DisableVertexAttribArray)
 REGISTRY_OPENGL(PFNGLENABLEVERTEXATTRIBARRAYPROC,  EnableVertexAttribArray)
 REGISTRY_OPENGL(PFNGLVERTEXATTRIBPOINTERPROC,      VertexAttribPointer)
 REGISTRY_OPENGL(PFNGLBUFFERSUBDATAPROC,            BufferSubData)
+REGISTRY_OPENGL(PFNGLVERTEXATTRIB4FVPROC,          VertexAttrib4fv)
 // >= 3.0
 REGISTRY_OPENGL(PFNGLGENVERTEXARRAYSPROC,    GenVertexArrays)
 REGISTRY_OPENGL(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays)
 REGISTRY_OPENGL(PFNGLBINDVERTEXARRAYPROC,    BindVertexArray)
+REGISTRY_OPENGL(PFNGLMAPBUFFERRANGEPROC,     MapBufferRange)
+REGISTRY_OPENGL(PFNGLUNMAPBUFFERPROC,        UnmapBuffer)
+// >= 3.3
+REGISTRY_OPENGL(PFNGLVERTEXATTRIBDIVISORPROC, VertexAttribDivisor)
 // >= 4.3
 REGISTRY_OPENGL(PFNGLBINDVERTEXBUFFERPROC,    BindVertexBuffer)
 REGISTRY_OPENGL(PFNGLVERTEXATTRIBFORMATPROC,  VertexAttribFormat)
 REGISTRY_OPENGL(PFNGLVERTEXATTRIBBINDINGPROC, VertexAttribBinding)
+// >= 4.4
+REGISTRY_OPENGL(PFNGLBUFFERSTORAGEPROC, BufferStorage)
 // >= 4.5
 REGISTRY_OPENGL(PFNGLCREATEVERTEXARRAYSPROC,       CreateVertexArrays)
 REGISTRY_OPENGL(PFNGLCREATEBUFFERSPROC,            CreateBuffers)
@@ -144,10 +180,20 @@ REGISTRY_OPENGL(PFNGLVERTEXARRAYATTRIBFORMATPROC,  VertexArrayAttribFormat)
 REGISTRY_OPENGL(PFNGLVERTEXARRAYATTRIBBINDINGPROC, VertexArrayAttribBinding)
 REGISTRY_OPENGL(PFNGLNAMEDBUFFERSUBDATAPROC,       NamedBufferSubData)
 
+// SYNC
+// >= 3.2
+REGISTRY_OPENGL(PFNGLFENCESYNCPROC,      FenceSync)
+REGISTRY_OPENGL(PFNGLCLIENTWAITSYNCPROC, ClientWaitSync)
+REGISTRY_OPENGL(PFNGLDELETESYNCPROC,     DeleteSync)
+
 // DISPLAY
 REGISTRY_OPENGL(PFNGLDRAWELEMENTSPROC, DrawElements)
 REGISTRY_OPENGL(PFNGLDRAWARRAYSPROC,   DrawArrays)
 REGISTRY_OPENGL(PFNGLCLEARPROC,        Clear)
 REGISTRY_OPENGL(PFNGLFINISHPROC,       Finish)
 REGISTRY_OPENGL(PFNGLFLUSHPROC,        Flush)
+// >= 3.1
+REGISTRY_OPENGL(PFNGLDRAWARRAYSINSTANCEDPROC, DrawArraysInstanced)
+// >= 4.3
+REGISTRY_OPENGL(PFNGLMULTIDRAWARRAYSINDIRECTPROC, MultiDrawArraysIndirect)
 #undef REGISTRY_OPENGL
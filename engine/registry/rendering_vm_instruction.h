@@ -1,53 +1,67 @@
-REGISTRY_RVM_INSTRUCTION(Common_Set_Clip)
-REGISTRY_RVM_INSTRUCTION(Common_Set_Viewport)
-
-REGISTRY_RVM_INSTRUCTION(Color_Set_Write)
-REGISTRY_RVM_INSTRUCTION(Color_Set_Clear)
-REGISTRY_RVM_INSTRUCTION(Color_Set_Blend)
-
-REGISTRY_RVM_INSTRUCTION(Depth_Set_Read)
-REGISTRY_RVM_INSTRUCTION(Depth_Set_Write)
-REGISTRY_RVM_INSTRUCTION(Depth_Set_Clear)
-REGISTRY_RVM_INSTRUCTION(Depth_Set_Comparison)
-REGISTRY_RVM_INSTRUCTION(Depth_Set_Range)
-
-REGISTRY_RVM_INSTRUCTION(Stencil_Set_Read)
-REGISTRY_RVM_INSTRUCTION(Stencil_Set_Write)
-REGISTRY_RVM_INSTRUCTION(Stencil_Set_Clear)
-REGISTRY_RVM_INSTRUCTION(Stencil_Set_Comparison)
-REGISTRY_RVM_INSTRUCTION(Stencil_Set_Operation)
-
-REGISTRY_RVM_INSTRUCTION(Face_Set_Cull)
-REGISTRY_RVM_INSTRUCTION(Face_Set_Front)
-
-REGISTRY_RVM_INSTRUCTION(Shader_Allocate)
-REGISTRY_RVM_INSTRUCTION(Shader_Free)
-REGISTRY_RVM_INSTRUCTION(Shader_Load)
-REGISTRY_RVM_INSTRUCTION(Shader_Use)
-REGISTRY_RVM_INSTRUCTION(Shader_Uniform)
-
-REGISTRY_RVM_INSTRUCTION(Mesh_Allocate)
-REGISTRY_RVM_INSTRUCTION(Mesh_Free)
-REGISTRY_RVM_INSTRUCTION(Mesh_Load)
-REGISTRY_RVM_INSTRUCTION(Mesh_Use)
-
-REGISTRY_RVM_INSTRUCTION(Texture_Allocate)
-REGISTRY_RVM_INSTRUCTION(Texture_Free)
-REGISTRY_RVM_INSTRUCTION(Texture_Load)
-
-// REGISTRY_RVM_INSTRUCTION(Sampler_Allocate)
-// REGISTRY_RVM_INSTRUCTION(Sampler_Free)
-
-// REGISTRY_RVM_INSTRUCTION(Target_Allocate)
-// REGISTRY_RVM_INSTRUCTION(Target_Free)
-// REGISTRY_RVM_INSTRUCTION(Target_Load)
-// REGISTRY_RVM_INSTRUCTION(Target_Use)
-// REGISTRY_RVM_INSTRUCTION(Target_Clear)
-
-REGISTRY_RVM_INSTRUCTION(Unit_Allocate)
-REGISTRY_RVM_INSTRUCTION(Unit_Free)
-
-REGISTRY_RVM_INSTRUCTION(Render_Clear)
-REGISTRY_RVM_INSTRUCTION(Render_Draw)
+// the scope tells where an instruction may go: `Bundle` ones are recorded into bundles too,
+// `Stream` ones only in streams, as the stream owns the resources and the bundles
+REGISTRY_RVM_INSTRUCTION(Common_Set_Clip,        Bundle)
+REGISTRY_RVM_INSTRUCTION(Common_Set_Viewport,    Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Color_Set_Write,        Bundle)
+REGISTRY_RVM_INSTRUCTION(Color_Set_Clear,        Bundle)
+REGISTRY_RVM_INSTRUCTION(Color_Set_Blend,        Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Depth_Set_Read,         Bundle)
+REGISTRY_RVM_INSTRUCTION(Depth_Set_Write,        Bundle)
+REGISTRY_RVM_INSTRUCTION(Depth_Set_Clear,        Bundle)
+REGISTRY_RVM_INSTRUCTION(Depth_Set_Comparison,   Bundle)
+REGISTRY_RVM_INSTRUCTION(Depth_Set_Range,        Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Stencil_Set_Read,       Bundle)
+REGISTRY_RVM_INSTRUCTION(Stencil_Set_Write,      Bundle)
+REGISTRY_RVM_INSTRUCTION(Stencil_Set_Clear,      Bundle)
+REGISTRY_RVM_INSTRUCTION(Stencil_Set_Comparison, Bundle)
+REGISTRY_RVM_INSTRUCTION(Stencil_Set_Operation,  Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Face_Set_Cull,          Bundle)
+REGISTRY_RVM_INSTRUCTION(Face_Set_Front,         Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Shader_Allocate,        Stream)
+REGISTRY_RVM_INSTRUCTION(Shader_Free,            Stream)
+REGISTRY_RVM_INSTRUCTION(Shader_Load,            Stream)
+REGISTRY_RVM_INSTRUCTION(Shader_Use,             Bundle)
+REGISTRY_RVM_INSTRUCTION(Shader_Uniform,         Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Mesh_Allocate,          Stream)
+REGISTRY_RVM_INSTRUCTION(Mesh_Free,              Stream)
+REGISTRY_RVM_INSTRUCTION(Mesh_Load,              Stream)
+REGISTRY_RVM_INSTRUCTION(Mesh_Use,               Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Texture_Allocate,       Stream)
+REGISTRY_RVM_INSTRUCTION(Texture_Free,           Stream)
+REGISTRY_RVM_INSTRUCTION(Texture_Load,           Stream)
+
+REGISTRY_RVM_INSTRUCTION(Unit_Allocate,          Bundle)
+REGISTRY_RVM_INSTRUCTION(Unit_Free,              Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Render_Clear,           Bundle)
+REGISTRY_RVM_INSTRUCTION(Render_Draw,            Bundle)
+REGISTRY_RVM_INSTRUCTION(Render_Draw_Instanced,  Bundle)
+REGISTRY_RVM_INSTRUCTION(Render_Draw_Indirect,   Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Pipeline_Allocate,      Stream)
+REGISTRY_RVM_INSTRUCTION(Pipeline_Free,          Stream)
+REGISTRY_RVM_INSTRUCTION(Pipeline_Use,           Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Bundle_Allocate,        Stream)
+REGISTRY_RVM_INSTRUCTION(Bundle_Free,            Stream)
+REGISTRY_RVM_INSTRUCTION(Bundle_Call,            Stream)
+REGISTRY_RVM_INSTRUCTION(Bundle_Patch,           Stream)
+
+REGISTRY_RVM_INSTRUCTION(Target_Allocate,        Stream)
+REGISTRY_RVM_INSTRUCTION(Target_Free,            Stream)
+REGISTRY_RVM_INSTRUCTION(Target_Load,            Stream)
+REGISTRY_RVM_INSTRUCTION(Target_Use,             Bundle)
+REGISTRY_RVM_INSTRUCTION(Target_Clear,           Bundle)
+
+REGISTRY_RVM_INSTRUCTION(Sampler_Allocate,       Stream)
+REGISTRY_RVM_INSTRUCTION(Sampler_Free,           Stream)
+REGISTRY_RVM_INSTRUCTION(Sampler_Use,            Bundle)
 
 #undef REGISTRY_RVM_INSTRUCTION
@@ -0,0 +1,9 @@
+// handlers of the GL rendering VM for newer contexts, `impl_<name>_<major><minor>` in place of `impl_<name>`
+// - picked once at init; list the variants of an instruction from the oldest, the newest the context supports wins
+REGISTRY_RVM_OPENGL(Common_Set_Clip,       4, 5)
+REGISTRY_RVM_OPENGL(Depth_Set_Clear,       4, 1)
+REGISTRY_RVM_OPENGL(Depth_Set_Range,       4, 1)
+REGISTRY_RVM_OPENGL(Shader_Uniform,        4, 1)
+REGISTRY_RVM_OPENGL(Render_Draw_Indirect,  4, 3)
+
+#undef REGISTRY_RVM_OPENGL
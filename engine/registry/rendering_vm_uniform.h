@@ -0,0 +1,8 @@
+// the block groups uniforms by how often they change, a GLSL block of the same name holds them
+// - `Frame` for the view, `Material` per surface, `Draw` per object; `None` stays in the default block
+REGISTRY_RVM_UNIFORM(u_Camera,    Frame)
+REGISTRY_RVM_UNIFORM(u_Transform, Draw)
+REGISTRY_RVM_UNIFORM(u_Color,     Material)
+REGISTRY_RVM_UNIFORM(u_Texture,   None)
+
+#undef REGISTRY_RVM_UNIFORM
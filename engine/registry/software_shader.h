@@ -0,0 +1,4 @@
+REGISTRY_SOFTWARE_SHADER(texture_tint)
+REGISTRY_SOFTWARE_SHADER(instanced_tint)
+
+#undef REGISTRY_SOFTWARE_SHADER
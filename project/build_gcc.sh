@@ -0,0 +1,26 @@
+#!/bin/sh
+# builds headless targets, e.g. `./build_gcc.sh rvm_benchmark`
+# the windowed sandbox requires `build_cl.bat` or `build_clang.bat`
+
+debug=${debug-}
+target=${1:-rvm_benchmark}
+
+# > OPTIONS
+includes="-I.. -I../third_party"
+defines="-D_POSIX_C_SOURCE=200809L"
+libs="-lm -lpthread"
+warnings="-Werror -Wall -Wextra -Wpedantic"
+compiler="$includes $defines"
+
+if [ -n "$debug" ]; then
+	compiler="$compiler -O0 -g"
+else
+	compiler="$compiler -O2"
+fi
+
+# > COMPILE AND LINK
+cd "$(dirname "$0")/.." || exit 1
+mkdir -p bin
+cd bin || exit 1
+
+${CC:-cc} -std=c99 "../project/unity_build_$target.c" -o "$target" $compiler $warnings $libs || exit 1
@@ -1,14 +1,37 @@
 #include "engine/internal/maths.c"
+#include "engine/internal/ref_pool.c"
+#include "engine/internal/rendering_buffer.c"
+#include "engine/internal/rendering_queue.c"
+#include "engine/internal/rendering_batch.c"
+#include "engine/internal/rendering_capture.c"
+#include "engine/internal/rendering_optimizer.c"
+#include "engine/internal/rendering_graph.c"
+#if defined(_WIN64) || defined(_WIN32)
+#include "engine/internal/rendering_thread.c" // requires a window
+#endif // platform
 #include "engine/internal/opengl/opengl.c"
+#if defined(ENGINE_RVM_SOFTWARE)
+#include "engine/internal/software/software_shaders.c"
+#include "engine/internal/software/rendering_vm.c"
+#elif defined(ENGINE_RVM_NULL)
+#include "engine/internal/null/rendering_vm.c"
+#else
 #include "engine/internal/opengl/rendering_vm.c"
+#endif // backend
 
 #if defined(_WIN64) || defined(_WIN32)
 #include "engine/platform_windows/platform_file.c"
 #include "engine/platform_windows/platform_window.c"
 #include "engine/platform_windows/platform_time.c"
 #include "engine/platform_windows/platform_system.c"
+#include "engine/platform_windows/platform_thread.c"
 #include "engine/platform_windows/opengl/rendering_context.c"
 #include "engine/platform_windows/opengl/rendering_library.c"
+#elif defined(__linux__)
+#include "engine/platform_posix/platform_file.c"
+#include "engine/platform_posix/platform_time.c"
+#include "engine/platform_posix/platform_system.c"
+#include "engine/platform_posix/platform_thread.c"
 #else
 #error "unknown platform"
 #endif // platform
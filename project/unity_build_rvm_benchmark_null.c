@@ -0,0 +1,3 @@
+#define ENGINE_RVM_NULL
+#include "tools/rvm_benchmark.c"
+#include "unity_build_engine.c"
@@ -0,0 +1,2 @@
+#include "tools/rvm_disasm.c"
+#include "unity_build_engine.c"
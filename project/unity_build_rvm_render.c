@@ -0,0 +1,3 @@
+#define ENGINE_RVM_SOFTWARE
+#include "tools/rvm_render.c"
+#include "unity_build_engine.c"
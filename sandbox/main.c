@@ -3,6 +3,8 @@
 #include "engine/api/maths.h"
 #include "engine/api/key_codes.h"
 #include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+#include "engine/api/rendering_thread.h"
 #include "engine/api/platform_system.h"
 #include "engine/api/platform_time.h"
 #include "engine/api/platform_window.h"
@@ -30,17 +32,12 @@ int main(int argc, char * argv[]) {
 
 	ENGINE_FREE(buffer);
 
-	//
-	size_t rendering_buffer_length = 0;
-	size_t rendering_buffer_capacity = 1024;
-	u8 * rendering_buffer = ENGINE_MALLOC(rendering_buffer_capacity);
-
 	//
 	u64 start_ticks = engine_time_get_ticks();
 	struct Engine_Window * window = engine_window_create();
 	engine_window_toggle_raw_input(window);
-	engine_window_init_context(window);
-	while (!engine_system_should_close && window && engine_window_is_active(window)) {
+	struct Rendering_Thread * rendering_thread = engine_rendering_thread_create(window, 2);
+	while (!engine_system_should_close && window && rendering_thread && engine_window_is_active(window)) {
 		// update OS
 		engine_window_update(window);
 		engine_system_poll_events();
@@ -59,7 +56,17 @@ int main(int argc, char * argv[]) {
 
 		// update logic
 		(void)dt;
-		engine_rendering_vm_update(rendering_buffer, rendering_buffer_length);
+
+		// draw frame
+		struct Rendering_Buffer * rendering_buffer = engine_rendering_thread_begin_frame(rendering_thread);
+		engine_rendering_buffer_emit_Color_Set_Clear(rendering_buffer, (struct RVM_Color_Set_Clear){
+			.value = VEC4(0.2f, 0.2f, 0.2f, 1),
+		});
+		engine_rendering_buffer_emit_Render_Clear(rendering_buffer, (struct RVM_Render_Clear){
+			.mask = RVM_Clear_All,
+		});
+
+		engine_rendering_thread_end_frame(rendering_thread);
 
 		// process system input
 		if (engine_window_key(window, KC_Alt) && engine_window_key_transition(window, KC_F4, true)) { break; }
@@ -71,7 +78,12 @@ int main(int argc, char * argv[]) {
 		if (engine_window_key_transition(window, KC_F12, true)) {
 			engine_window_toggle_raw_input(window);
 		}
+
+		if (engine_window_key_transition(window, KC_F11, true)) {
+			engine_rendering_thread_toggle_capture(rendering_thread, "capture.rvmc");
+		}
 	}
+	if (rendering_thread) { engine_rendering_thread_destroy(rendering_thread); }
 	if (window) { engine_window_destroy(window); }
 
 	//
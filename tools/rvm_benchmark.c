@@ -0,0 +1,1054 @@
+#include "engine/api/primitive_types.h"
+
+#include <stdlib.h>
+
+// every engine allocation is counted, so the VM can be checked to run allocation free
+static u64 benchmark_allocations;
+
+static void * benchmark_malloc(size_t size) { benchmark_allocations++; return malloc(size); }
+static void * benchmark_realloc(void * block, size_t size) { benchmark_allocations++; return realloc(block, size); }
+
+#define ENGINE_MALLOC(size)         benchmark_malloc(size)
+#define ENGINE_REALLOC(block, size) benchmark_realloc(block, size)
+#define ENGINE_FREE(block)          free(block)
+
+#include "engine/api/code.h"
+#include "engine/api/ref_pool.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+#include "engine/api/rendering_capture.h"
+#include "engine/api/rendering_graph.h"
+#include "engine/api/platform_system.h"
+#include "engine/api/platform_time.h"
+#include "engine/internal/opengl/opengl.h"
+
+// headless decode throughput of `engine_rendering_vm_update`
+// - GL entry points are replaced with counting stubs, so no context is required
+// - `rvm_benchmark_null` measures the VM layer alone, through the null backend
+// - usage: `rvm_benchmark [instructions] [iterations]`
+// - usage: `rvm_benchmark -replay capture.rvmc [iterations]`, replays a capture at full speed
+// - reports ns per instruction, the share of redundant state skipped and allocations per iteration; the null backend leaves the share out
+// - an iteration is a frame, streamed bytes per frame and the stalls size the stream ring
+
+static u64 stub_calls;
+static u64 benchmark_errors;
+static struct Rendering_Graph_Stats benchmark_graph; // of the stream being generated
+static void * stub_mapping;
+
+static void impl_stub_gl(void);
+static void impl_stream_state(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_draws(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_churn(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_instanced(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_indirect(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_streaming(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_pipelines(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_bundles(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_targets(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_graph(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_samplers(struct Rendering_Buffer * buffer, u32 count);
+static void impl_stream_uploads(struct Rendering_Buffer * buffer, u32 count);
+static void impl_run(cstring name, void (* generate)(struct Rendering_Buffer * buffer, u32 count), u32 count, u32 iterations);
+static void impl_replay(cstring path, u32 iterations);
+
+int main(int argc, char * argv[]) {
+	bool const replay = (argc > 2) && strcmp(argv[1], "-replay") == 0;
+	int const iterations_index = replay ? 3 : 2;
+
+	u32 count      = (!replay && argc > 1)      ? (u32)strtoul(argv[1], NULL, 10) : 100000;
+	u32 iterations = (argc > iterations_index) ? (u32)strtoul(argv[iterations_index], NULL, 10) : 100;
+
+	engine_system_init();
+	impl_stub_gl();
+	engine_rendering_vm_init();
+
+	printf("%-10s %12s %10s %14s %10s %10s %8s %10s\n", "stream", "instructions", "bytes", "instructions/s", "ns/instr", "MB/s", "skipped", "allocs/it");
+	if (replay) {
+		impl_replay(argv[2], iterations);
+	}
+	else {
+		impl_run("state", impl_stream_state, count, iterations);
+		impl_run("draws", impl_stream_draws, count, iterations);
+		impl_run("churn", impl_stream_churn, count, iterations);
+		impl_run("instanced", impl_stream_instanced, count, iterations);
+		impl_run("indirect", impl_stream_indirect, count, iterations);
+		impl_run("streaming", impl_stream_streaming, count, iterations);
+		impl_run("pipelines", impl_stream_pipelines, count, iterations);
+		impl_run("bundles", impl_stream_bundles, count, iterations);
+		impl_run("targets", impl_stream_targets, count, iterations);
+		impl_run("graph", impl_stream_graph, count, iterations);
+		impl_run("samplers", impl_stream_samplers, count, iterations);
+		impl_run("uploads", impl_stream_uploads, count, iterations);
+	}
+
+	engine_rendering_vm_deinit();
+	engine_system_deinit();
+	free(stub_mapping);
+
+	printf("gl calls: %llu, errors: %llu\n", (unsigned long long)stub_calls, (unsigned long long)benchmark_errors);
+	return benchmark_errors ? 2 : 0;
+}
+
+//
+// streams
+//
+
+static void impl_stream_state(struct Rendering_Buffer * buffer, u32 count) {
+	for (u32 i = 0; i < count; i += 8) {
+		engine_rendering_buffer_emit_Color_Set_Blend(buffer, (struct RVM_Color_Set_Blend){
+			.value = (enum RVM_Color_Blend)(i % 6),
+		});
+		engine_rendering_buffer_emit_Depth_Set_Read(buffer, (struct RVM_Depth_Set_Read){
+			.value = (i & 8) == 8,
+		});
+		engine_rendering_buffer_emit_Depth_Set_Comparison(buffer, (struct RVM_Depth_Set_Comparison){
+			.value = RVM_Comparison_LEqual,
+		});
+		engine_rendering_buffer_emit_Stencil_Set_Comparison(buffer, (struct RVM_Stencil_Set_Comparison){
+			.comparison = RVM_Comparison_Equal, .reference = 1, .mask = 0xff,
+		});
+		engine_rendering_buffer_emit_Stencil_Set_Operation(buffer, (struct RVM_Stencil_Set_Operation){
+			.stencil_fail__depth_any        = RVM_Operation_Keep,
+			.stencil_success__depth_fail    = RVM_Operation_Keep,
+			.stencil_success__depth_success = RVM_Operation_Replace,
+		});
+		engine_rendering_buffer_emit_Face_Set_Cull(buffer, (struct RVM_Face_Set_Cull){
+			.value = (enum RVM_Face_Cull)(i % 4),
+		});
+		engine_rendering_buffer_emit_Color_Set_Write(buffer, (struct RVM_Color_Set_Write){
+			.value = RVM_Color_Write_All,
+		});
+		engine_rendering_buffer_emit_Common_Set_Viewport(buffer, (struct RVM_Common_Set_Viewport){
+			.pos = SVEC2(0, 0), .size = SVEC2(1920, 1080),
+		});
+	}
+}
+
+// streams allocate what they use and free it at the end, so they can be replayed
+static void impl_stream_draws(struct Rendering_Buffer * buffer, u32 count) {
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	for (u32 i = 0; i < 4; ++i) {
+		engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){
+			.ref = {.id = i},
+		});
+		engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+			.ref = {.id = i},
+			.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+		});
+	}
+	for (u32 i = 0; i < 16; ++i) {
+		engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+			.ref = {.id = i},
+			.asset = {.length = 36 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+		});
+	}
+
+	mat4 const transform = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+	for (u32 i = 1; i < count; i += 4) {
+		engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){
+			.ref = {.id = i % 4},
+		});
+		engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){
+			.ref = {.id = i % 16},
+		});
+		engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+			.ref = {.id = i % 4}, .uniform = RVM_Uniform_u_Transform, .type = Data_Type_mat4, .count = 1,
+		}, &transform, sizeof(transform));
+		engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){
+			.offset = 0, .length = 36,
+		});
+	}
+
+	for (u32 i = 0; i < 4; ++i) {
+		engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = i}});
+	}
+	for (u32 i = 0; i < 16; ++i) {
+		engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = i}});
+	}
+}
+
+static void impl_stream_churn(struct Rendering_Buffer * buffer, u32 count) {
+	// refs come from a pool, as a client takes them: a freed slot is reused with a new generation each round
+	struct Ref_Pool * refs = engine_ref_pool_create(0);
+	for (u32 i = 0; i < count; i += 10) {
+		struct Ref const ref = engine_ref_pool_acquire(refs);
+		struct Asset_Mesh const mesh = {.length = 1024, .type = Data_Type_r32, .attributes = {3, 2}};
+		struct Asset_Texture const texture = {
+			.size = {16, 16}, .type = Data_Type_u8, .channels = 4,
+			.kind = Texture_Type_Color, .filter_max = Filter_Type_Linear,
+		};
+
+		engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){.ref = ref, .asset = mesh});
+		engine_rendering_buffer_emit_Mesh_Load(buffer, (struct RVM_Mesh_Load){.ref = ref, .asset = mesh});
+		engine_rendering_buffer_emit_Texture_Allocate(buffer, (struct RVM_Texture_Allocate){.ref = ref, .asset = texture});
+		engine_rendering_buffer_emit_Texture_Load(buffer, (struct RVM_Texture_Load){.ref = ref, .asset = texture});
+		engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){.unit = ref.id % 16, .texture = ref});
+		engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = ref});
+		engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = REF_EMPTY_ID}});
+		engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = ref.id % 16});
+		engine_rendering_buffer_emit_Texture_Free(buffer, (struct RVM_Texture_Free){.ref = ref});
+		engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = ref});
+		engine_ref_pool_release(refs, ref);
+	}
+	engine_ref_pool_destroy(refs);
+}
+
+static void impl_stream_instanced(struct Rendering_Buffer * buffer, u32 count) {
+	// the `draws` stream, with a batch of instances per draw: offset and tint per instance
+	u32 const instances = 64;
+	static u8 shader_source[] = "#pragma software(instanced_tint)\n";
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 0},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 0},
+		.asset = {.length = 36 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 1},
+		.asset = {
+			.length = 16 * instances * 7 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 4},
+			.divisor = 1, .location = 2, .frequency = Mesh_Frequency_Stream, .transient = true,
+		},
+	});
+
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 0}});
+	for (u32 i = 4; i < count; ++i) {
+		engine_rendering_buffer_emit_Render_Draw_Instanced(buffer, (struct RVM_Render_Draw_Instanced){
+			.offset = 0, .length = 36,
+			.instances = {.id = 1}, .instances_offset = ((i / 256) % 16) * instances, .count = instances,
+		});
+	}
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 1}});
+}
+
+static void impl_stream_indirect(struct Rendering_Buffer * buffer, u32 count) {
+	// objects packed into one shared mesh, a multi-draw per batch of sub-ranges
+	u32 const objects = 64;
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 0},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 0},
+		.asset = {.length = objects * 36 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+	});
+
+	// every other object is skipped, so the ranges do not merge
+	struct RVM_Render_Draw ranges[32];
+	for (u32 i = 0; i < 32; ++i) {
+		ranges[i] = (struct RVM_Render_Draw){.offset = i * 2 * 36, .length = 36};
+	}
+	struct RVM_Draw_Arguments arguments[32];
+	u32 const arguments_count = engine_rendering_buffer_fill_draws(arguments, ranges, 32);
+
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 0}});
+	for (u32 i = 3; i < count; ++i) {
+		engine_rendering_buffer_emit_draws(buffer, (struct RVM_Render_Draw_Indirect){
+			.instances = {.id = REF_EMPTY_ID}, .count = arguments_count,
+		}, arguments);
+	}
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 0}});
+}
+
+static void impl_stream_streaming(struct Rendering_Buffer * buffer, u32 count) {
+	// geometry rebuilt on the CPU every frame, a load and a draw per object
+	static r32 vertices[36 * 5];
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 0},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	struct Asset_Mesh const mesh = {
+		.data = (u8 *)vertices, .length = sizeof(vertices), .type = Data_Type_r32, .attributes = {3, 2},
+		.frequency = Mesh_Frequency_Stream, .transient = true,
+	};
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){.ref = {.id = 0}, .asset = mesh});
+
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 0}});
+	for (u32 i = 3; i < count; i += 2) {
+		engine_rendering_buffer_emit_Mesh_Load(buffer, (struct RVM_Mesh_Load){.ref = {.id = 0}, .asset = mesh});
+		engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 36});
+	}
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 0}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 0}});
+}
+
+static void impl_stream_pipelines(struct Rendering_Buffer * buffer, u32 count) {
+	// the `state` stream baked: materials switch between pipelines that differ in a few fields, half of them twice
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	for (u32 i = 0; i < 2; ++i) {
+		engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = i}});
+		engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+			.ref = {.id = i},
+			.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+		});
+	}
+	for (u32 i = 0; i < 16; ++i) {
+		engine_rendering_buffer_emit_Pipeline_Allocate(buffer, (struct RVM_Pipeline_Allocate){
+			.ref = {.id = i},
+			.value = {
+				.shader = {.ref = {.id = (i / 4) % 2}},
+				.color_write = {.value = RVM_Color_Write_All},
+				.blend = {.value = (enum RVM_Color_Blend)((i / 2) % 6)},
+				.depth_read = {.value = (i & 1) == 1},
+				.depth_write = {.value = true},
+				.depth_comparison = {.value = RVM_Comparison_LEqual},
+				.stencil_write = {.value = 0xff},
+				.stencil_comparison = {.comparison = RVM_Comparison_Equal, .reference = 1, .mask = 0xff},
+				.stencil_operation = {
+					.stencil_fail__depth_any        = RVM_Operation_Keep,
+					.stencil_success__depth_fail    = RVM_Operation_Keep,
+					.stencil_success__depth_success = RVM_Operation_Replace,
+				},
+				.cull = {.value = RVM_Face_Cull_Back},
+			},
+		});
+	}
+
+	for (u32 i = 18; i < count; ++i) {
+		engine_rendering_buffer_emit_Pipeline_Use(buffer, (struct RVM_Pipeline_Use){
+			.ref = {.id = (i / 2) % 16},
+		});
+	}
+
+	for (u32 i = 0; i < 16; ++i) {
+		engine_rendering_buffer_emit_Pipeline_Free(buffer, (struct RVM_Pipeline_Free){.ref = {.id = i}});
+	}
+	for (u32 i = 0; i < 2; ++i) {
+		engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = i}});
+	}
+}
+
+static void impl_stream_bundles(struct Rendering_Buffer * buffer, u32 count) {
+	// the `draws` stream recorded once: each call replays 64 draws, the transform of the first is patched in between
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	for (u32 i = 0; i < 4; ++i) {
+		engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = i}});
+		engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+			.ref = {.id = i},
+			.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+		});
+	}
+	for (u32 i = 0; i < 16; ++i) {
+		engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+			.ref = {.id = i},
+			.asset = {.length = 36 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+		});
+	}
+
+	mat4 transform = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}};
+	struct Rendering_Buffer * bundle = engine_rendering_buffer_create(0);
+	u32 slot = 0;
+	for (u32 i = 1; i < 64 * 4; i += 4) {
+		engine_rendering_buffer_emit_Shader_Use(bundle, (struct RVM_Shader_Use){.ref = {.id = i % 4}});
+		engine_rendering_buffer_emit_Mesh_Use(bundle, (struct RVM_Mesh_Use){.ref = {.id = i % 16}});
+		if (i == 1) { slot = engine_rendering_buffer_get_instructions_count(bundle); }
+		engine_rendering_buffer_emit_uniform(bundle, (struct RVM_Shader_Uniform){
+			.ref = {.id = i % 4}, .uniform = RVM_Uniform_u_Transform, .type = Data_Type_mat4, .count = 1,
+		}, &transform, sizeof(transform));
+		engine_rendering_buffer_emit_Render_Draw(bundle, (struct RVM_Render_Draw){.offset = 0, .length = 36});
+	}
+	engine_rendering_buffer_emit_bundle(buffer, (struct RVM_Bundle_Allocate){.ref = {.id = 0}}, bundle);
+
+	for (u32 i = 0; i < count; i += 64 * 4) {
+		transform.w.x = (r32)(i % 7);
+		engine_rendering_buffer_reset(bundle);
+		engine_rendering_buffer_emit_uniform(bundle, (struct RVM_Shader_Uniform){
+			.ref = {.id = 1}, .uniform = RVM_Uniform_u_Transform, .type = Data_Type_mat4, .count = 1,
+		}, &transform, sizeof(transform));
+		engine_rendering_buffer_emit_patch(buffer, (struct RVM_Bundle_Patch){.ref = {.id = 0}, .slot = slot}, bundle);
+		engine_rendering_buffer_emit_Bundle_Call(buffer, (struct RVM_Bundle_Call){.ref = {.id = 0}});
+	}
+	engine_rendering_buffer_destroy(bundle);
+
+	engine_rendering_buffer_emit_Bundle_Free(buffer, (struct RVM_Bundle_Free){.ref = {.id = 0}});
+	for (u32 i = 0; i < 4; ++i) {
+		engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = i}});
+	}
+	for (u32 i = 0; i < 16; ++i) {
+		engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = i}});
+	}
+}
+
+static void impl_stream_targets(struct Rendering_Buffer * buffer, u32 count) {
+	// a post-processing chain: a multisampled scene, resolved when left, then passes ping-ponging between transient targets
+	// - each pass allocates its target and frees its source, the pool serves them after the first frame
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 1},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 1},
+		.asset = {.length = 6 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+	});
+
+	struct Ref_Pool * refs = engine_ref_pool_create(0);
+	struct Ref source = engine_ref_pool_acquire(refs);
+	engine_rendering_buffer_emit_Target_Allocate(buffer, (struct RVM_Target_Allocate){
+		.ref = source, .size = SVEC2(1920, 1080), .samples = 4, .count = 2, .attachments = {
+			{.texture = source, .kind = Texture_Type_Color, .type = Data_Type_u8, .channels = 4},
+			{.texture = {.id = REF_EMPTY_ID}, .kind = Texture_Type_DStencil, .type = Data_Type_u32},
+		},
+	});
+	engine_rendering_buffer_emit_Target_Use(buffer, (struct RVM_Target_Use){.ref = source});
+	engine_rendering_buffer_emit_Target_Clear(buffer, (struct RVM_Target_Clear){.attachment = 0, .color = VEC4(0, 0, 0, 1)});
+	engine_rendering_buffer_emit_Target_Clear(buffer, (struct RVM_Target_Clear){.attachment = 1, .depth = 1});
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+
+	for (u32 i = 0; i < count; i += 5) {
+		struct Ref const target = engine_ref_pool_acquire(refs);
+		engine_rendering_buffer_emit_Target_Allocate(buffer, (struct RVM_Target_Allocate){
+			.ref = target, .size = SVEC2(960, 540), .transient = true, .count = 1, .attachments = {
+				{.texture = target, .kind = Texture_Type_Color, .type = Data_Type_u8, .channels = 4},
+			},
+		});
+		engine_rendering_buffer_emit_Target_Use(buffer, (struct RVM_Target_Use){.ref = target});
+		engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){.unit = 0, .texture = source});
+		engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+		engine_rendering_buffer_emit_Target_Free(buffer, (struct RVM_Target_Free){.ref = source});
+		engine_ref_pool_release(refs, source);
+		source = target;
+	}
+
+	engine_rendering_buffer_emit_Target_Use(buffer, (struct RVM_Target_Use){.ref = {.id = REF_EMPTY_ID}});
+	engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){.unit = 0, .texture = source});
+	engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+	engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = 0});
+	engine_rendering_buffer_emit_Target_Free(buffer, (struct RVM_Target_Free){.ref = source});
+	engine_ref_pool_destroy(refs);
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 1}});
+}
+
+struct Graph_Pass_Context {
+	u32 inputs[2], count;
+	bool clear;
+};
+
+static void impl_graph_pass(struct Rendering_Graph const * graph, struct Rendering_Buffer * buffer, void * context) {
+	struct Graph_Pass_Context const * pass = context;
+	if (pass->clear) {
+		engine_rendering_buffer_emit_Target_Clear(buffer, (struct RVM_Target_Clear){.attachment = 0, .color = VEC4(0, 0, 0, 1)});
+		engine_rendering_buffer_emit_Target_Clear(buffer, (struct RVM_Target_Clear){.attachment = 1, .depth = 1});
+	}
+	for (u32 i = 0; i < pass->count; ++i) {
+		engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){
+			.unit = i, .texture = engine_rendering_graph_get_texture(graph, pass->inputs[i], 0),
+		});
+	}
+	engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+}
+
+static void impl_stream_graph(struct Rendering_Buffer * buffer, u32 count) {
+	// a post stack through a frame graph: a multisampled scene, a bloom chain and a composite into the window
+	// - the ambient occlusion feature is toggled each other frame, its passes are culled when nothing reads them
+	// - the bright pass and the vertical blur share a VM target, their lifetimes don't overlap
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 1},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 1},
+		.asset = {.length = 6 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+	});
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 1}});
+
+	struct Rendering_Graph_Target const scene_desc = {
+		.size = SVEC2(1920, 1080), .samples = 4, .count = 2, .attachments = {
+			{.kind = Texture_Type_Color, .type = Data_Type_u8, .channels = 4, .sampled = true},
+			{.kind = Texture_Type_DStencil, .type = Data_Type_u32},
+		},
+	};
+	struct Rendering_Graph_Target const half_desc = {
+		.size = SVEC2(960, 540), .count = 1, .attachments = {
+			{.kind = Texture_Type_Color, .type = Data_Type_u8, .channels = 4, .sampled = true},
+		},
+	};
+
+	struct Ref_Pool * target_refs  = engine_ref_pool_create(0);
+	struct Ref_Pool * texture_refs = engine_ref_pool_create(0);
+	struct Rendering_Graph * graph = engine_rendering_graph_create(target_refs, texture_refs);
+
+	for (u32 frame = 0; frame < count; frame += 20) {
+		bool const occlusion = (frame / 20) % 2;
+		u32 const window = engine_rendering_graph_import_target(graph, (struct Ref){.id = REF_EMPTY_ID});
+		u32 const scene  = engine_rendering_graph_create_target(graph, &scene_desc);
+		u32 const ao     = engine_rendering_graph_create_target(graph, &half_desc);
+		u32 const bright = engine_rendering_graph_create_target(graph, &half_desc);
+		u32 const blur_h = engine_rendering_graph_create_target(graph, &half_desc);
+		u32 const blur_v = engine_rendering_graph_create_target(graph, &half_desc);
+
+		// added out of order, the composite goes last anyway
+		struct Graph_Pass_Context const composite_context = {.inputs = {scene, blur_v}, .count = 2};
+		u32 const composite = engine_rendering_graph_add_pass(graph, window, impl_graph_pass, (void *)&composite_context);
+		engine_rendering_graph_read(graph, composite, scene);
+		engine_rendering_graph_read(graph, composite, blur_v);
+
+		struct Graph_Pass_Context const scene_context = {.clear = true};
+		engine_rendering_graph_add_pass(graph, scene, impl_graph_pass, (void *)&scene_context);
+
+		struct Graph_Pass_Context const ao_context = {.inputs = {scene}, .count = 1};
+		u32 const ao_pass = engine_rendering_graph_add_pass(graph, ao, impl_graph_pass, (void *)&ao_context);
+		engine_rendering_graph_read(graph, ao_pass, scene);
+		if (occlusion) { engine_rendering_graph_read(graph, composite, ao); }
+
+		struct Graph_Pass_Context const bright_context = {.inputs = {scene}, .count = 1};
+		u32 const bright_pass = engine_rendering_graph_add_pass(graph, bright, impl_graph_pass, (void *)&bright_context);
+		engine_rendering_graph_read(graph, bright_pass, scene);
+
+		struct Graph_Pass_Context const blur_h_context = {.inputs = {bright}, .count = 1};
+		u32 const blur_h_pass = engine_rendering_graph_add_pass(graph, blur_h, impl_graph_pass, (void *)&blur_h_context);
+		engine_rendering_graph_read(graph, blur_h_pass, bright);
+
+		struct Graph_Pass_Context const blur_v_context = {.inputs = {blur_h}, .count = 1};
+		u32 const blur_v_pass = engine_rendering_graph_add_pass(graph, blur_v, impl_graph_pass, (void *)&blur_v_context);
+		engine_rendering_graph_read(graph, blur_v_pass, blur_h);
+
+		engine_rendering_graph_flush(graph, buffer);
+		if (!occlusion) { benchmark_graph = engine_rendering_graph_get_stats(graph); }
+	}
+
+	engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = 0});
+	engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = 1});
+	engine_rendering_graph_release(graph, buffer);
+	engine_rendering_graph_destroy(graph);
+	engine_ref_pool_destroy(target_refs);
+	engine_ref_pool_destroy(texture_refs);
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 1}});
+}
+
+static void impl_stream_samplers(struct Rendering_Buffer * buffer, u32 count) {
+	// a material set: many textures with a few distinct settings, some units sampling them differently
+	// - the textures share four settings, one of the samplers repeats them and shares too
+	// - units switch textures more often than samplers, a sampler change alone rebinds nothing else
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 1},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 1},
+		.asset = {.length = 6 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+	});
+
+	u32 const textures_count = 64;
+	for (u32 i = 0; i < textures_count; ++i) {
+		engine_rendering_buffer_emit_Texture_Allocate(buffer, (struct RVM_Texture_Allocate){
+			.ref = {.id = i}, .asset = {
+				.size = {16, 16}, .type = Data_Type_u8, .channels = 4, .kind = Texture_Type_Color,
+				.filter_mipmap = (enum Filter_Type)(i % 2 * 2), .filter_min = Filter_Type_Linear, .filter_max = Filter_Type_Linear,
+				.wrap_x = (enum Wrap_Type)(i / 2 % 2), .wrap_y = (enum Wrap_Type)(i / 2 % 2),
+			},
+		});
+	}
+
+	struct RVM_Sampler const samplers[] = {
+		{.filter_mipmap = Filter_Type_Linear, .filter_min = Filter_Type_Linear, .filter_max = Filter_Type_Linear, .wrap_x = Wrap_Type_Repeat, .wrap_y = Wrap_Type_Repeat, .anisotropy = 8},
+		{.filter_mipmap = Filter_Type_None, .filter_min = Filter_Type_Point, .filter_max = Filter_Type_Point, .wrap_x = Wrap_Type_Clamp, .wrap_y = Wrap_Type_Clamp},
+		{.filter_mipmap = Filter_Type_Linear, .filter_min = Filter_Type_Linear, .filter_max = Filter_Type_Linear, .wrap_x = Wrap_Type_Repeat, .wrap_y = Wrap_Type_Repeat},
+	};
+	u32 const samplers_count = sizeof(samplers) / sizeof(*samplers);
+	for (u32 i = 0; i < samplers_count; ++i) {
+		engine_rendering_buffer_emit_Sampler_Allocate(buffer, (struct RVM_Sampler_Allocate){.ref = {.id = i}, .value = samplers[i]});
+	}
+
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 1}});
+	for (u32 i = 0; i < count; i += 3) {
+		u32 const unit = i / 3 % 4;
+		if (i % 24 == 0) {
+			// an empty ref goes back to the settings of the texture
+			u32 const sampler = i / 24 % (samplers_count + 1);
+			engine_rendering_buffer_emit_Sampler_Use(buffer, (struct RVM_Sampler_Use){
+				.unit = unit, .ref = {.id = (sampler < samplers_count) ? sampler : REF_EMPTY_ID},
+			});
+		}
+		engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){
+			.unit = unit, .texture = {.id = i / 3 % textures_count},
+		});
+		engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+	}
+
+	for (u32 unit = 0; unit < 4; ++unit) {
+		engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = unit});
+	}
+	for (u32 i = 0; i < samplers_count; ++i) {
+		engine_rendering_buffer_emit_Sampler_Free(buffer, (struct RVM_Sampler_Free){.ref = {.id = i}});
+	}
+	for (u32 i = 0; i < textures_count; ++i) {
+		engine_rendering_buffer_emit_Texture_Free(buffer, (struct RVM_Texture_Free){.ref = {.id = i}});
+	}
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 1}});
+}
+
+static void impl_stream_uploads(struct Rendering_Buffer * buffer, u32 count) {
+	// a level streaming in: the frame loads more texture data than its upload budget lets through
+	// - a reload of a texture with rows still pending replaces them, the copies set aside are bounded by the textures
+	static u8 shader_source[] = "#pragma software(texture_tint)\n";
+	static u8 texels[64 * 64 * 4];
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = 1},
+		.asset = {.data = shader_source, .length = sizeof(shader_source) - 1},
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = 1},
+		.asset = {.length = 6 * 5 * sizeof(r32), .type = Data_Type_r32, .attributes = {3, 2}},
+	});
+
+	u32 const textures_count = 32;
+	for (u32 i = 0; i < textures_count; ++i) {
+		engine_rendering_buffer_emit_Texture_Allocate(buffer, (struct RVM_Texture_Allocate){
+			.ref = {.id = i}, .asset = {
+				.size = {64, 64}, .type = Data_Type_u8, .channels = 4, .kind = Texture_Type_Color,
+				.filter_mipmap = (enum Filter_Type)(i % 2 * 2), .filter_min = Filter_Type_Linear, .filter_max = Filter_Type_Linear,
+			},
+		});
+	}
+
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = 1}});
+	for (u32 i = 0; i < count; i += 2) {
+		u32 const texture = i / 2 % textures_count;
+		if (i % 32 == 0) {
+			engine_rendering_buffer_emit_Texture_Load(buffer, (struct RVM_Texture_Load){
+				.ref = {.id = texture}, .asset = {
+					.data = texels, .length = sizeof(texels),
+					.size = {64, 64}, .type = Data_Type_u8, .channels = 4, .kind = Texture_Type_Color,
+					.filter_mipmap = (enum Filter_Type)(texture % 2 * 2), .filter_min = Filter_Type_Linear, .filter_max = Filter_Type_Linear,
+				},
+			});
+		}
+		engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){.unit = 0, .texture = {.id = texture}});
+		engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+	}
+
+	engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = 0});
+	for (u32 i = 0; i < textures_count; ++i) {
+		engine_rendering_buffer_emit_Texture_Free(buffer, (struct RVM_Texture_Free){.ref = {.id = i}});
+	}
+
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = 1}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = 1}});
+}
+
+static u32 impl_count_instructions(u8 const * buffer, size_t length) {
+	u32 count = 0;
+	for (size_t offset = 0; offset < length; ++count) {
+		struct RVM_Header const * header = (void const *)(buffer + offset);
+		offset += sizeof(*header) + header->size;
+	}
+	return count;
+}
+
+static void impl_print(cstring name, u64 instructions, size_t bytes, u32 iterations, u64 ticks, u64 allocations) {
+	struct RVM_Stats const stats = engine_rendering_vm_get_stats();
+	benchmark_errors += stats.errors;
+
+	// the null backend has no binds to shadow, its share of skipped calls isn't the same metric
+	char skipped[16] = "-";
+#if !defined(ENGINE_RVM_NULL)
+	u64 const calls = stats.calls_issued + stats.calls_skipped;
+	snprintf(skipped, sizeof(skipped), "%.1f%%", calls ? 100.0 * (r64)stats.calls_skipped / (r64)calls : 0.0);
+#endif
+
+	r64 seconds = (r64)ticks / (r64)engine_time_get_precision();
+	r64 total   = (r64)instructions * (r64)iterations;
+	printf(
+		"%-10s %12llu %10zu %14.0f %10.2f %10.1f %8s %10.1f\n",
+		name, (unsigned long long)instructions, bytes,
+		total / seconds,
+		seconds * 1e9 / total,
+		(r64)bytes * (r64)iterations / seconds / (1024.0 * 1024.0),
+		skipped,
+		iterations ? (r64)allocations / (r64)iterations : 0.0
+	);
+	if (benchmark_graph.passes) {
+		printf("%-10s graph passes: %u, culled: %u, targets: %u -> %u, MB: %.1f -> %.1f\n", "",
+			benchmark_graph.passes, benchmark_graph.passes_culled,
+			benchmark_graph.targets, benchmark_graph.targets_placed,
+			(r64)benchmark_graph.bytes / (1024.0 * 1024.0), (r64)benchmark_graph.bytes_placed / (1024.0 * 1024.0)
+		);
+		memset(&benchmark_graph, 0, sizeof(benchmark_graph));
+	}
+	if (stats.bytes_streamed) {
+		printf("%-10s streamed KB/frame: %.1f, stalls: %llu\n", "",
+			iterations ? (r64)stats.bytes_streamed / (r64)iterations / 1024.0 : 0.0,
+			(unsigned long long)stats.stalls
+		);
+	}
+}
+
+static void impl_run(cstring name, void (* generate)(struct Rendering_Buffer * buffer, u32 count), u32 count, u32 iterations) {
+	struct Rendering_Buffer * buffer = engine_rendering_buffer_create(ENGINE_RENDERING_BUFFER_CHUNK_SIZE);
+	generate(buffer, count);
+
+	u64 instructions = 0; size_t bytes = 0;
+	u32 chunks_count = engine_rendering_buffer_get_chunks_count(buffer);
+	for (u32 chunk_i = 0; chunk_i < chunks_count; ++chunk_i) {
+		size_t chunk_length;
+		u8 const * chunk = engine_rendering_buffer_get_chunk(buffer, chunk_i, &chunk_length);
+		instructions += impl_count_instructions(chunk, chunk_length);
+		bytes += chunk_length;
+	}
+
+	engine_rendering_vm_reset_stats();
+	u64 const start_allocations = benchmark_allocations;
+	u64 start_ticks = engine_time_get_ticks();
+	for (u32 i = 0; i < iterations; ++i) {
+		for (u32 chunk_i = 0; chunk_i < chunks_count; ++chunk_i) {
+			size_t chunk_length;
+			u8 const * chunk = engine_rendering_buffer_get_chunk(buffer, chunk_i, &chunk_length);
+			if (engine_rendering_vm_update(chunk, chunk_length) != chunk_length) { ENGINE_DEBUG_BREAK(); }
+		}
+		engine_rendering_vm_end_frame();
+	}
+	u64 ticks = engine_time_get_ticks() - start_ticks;
+
+	impl_print(name, instructions, bytes, iterations, ticks, benchmark_allocations - start_allocations);
+	engine_rendering_buffer_destroy(buffer);
+}
+
+static void impl_replay(cstring path, u32 iterations) {
+	struct Rendering_Capture * capture = engine_rendering_capture_load(path);
+	if (!capture) { return; }
+	if (!engine_rendering_capture_is_complete(capture)) {
+		printf("[err]: capture began mid-session, it can't be replayed: `%s`\n", path);
+		engine_rendering_capture_free(capture); return;
+	}
+
+	u64 instructions = 0; size_t bytes = 0;
+	u32 const frames_count = engine_rendering_capture_get_frames_count(capture);
+	for (u32 frame_i = 0; frame_i < frames_count; ++frame_i) {
+		u32 const streams_count = engine_rendering_capture_get_streams_count(capture, frame_i);
+		for (u32 stream_i = 0; stream_i < streams_count; ++stream_i) {
+			size_t stream_length;
+			u8 const * stream = engine_rendering_capture_get_stream(capture, frame_i, stream_i, &stream_length);
+			instructions += impl_count_instructions(stream, stream_length);
+			bytes += stream_length;
+		}
+	}
+
+	engine_rendering_vm_reset_stats();
+	u64 const start_allocations = benchmark_allocations;
+	u64 start_ticks = engine_time_get_ticks();
+	for (u32 i = 0; i < iterations; ++i) {
+		for (u32 frame_i = 0; frame_i < frames_count; ++frame_i) {
+			engine_rendering_capture_replay(capture, frame_i);
+		}
+		engine_rendering_capture_release(capture);
+	}
+	u64 ticks = engine_time_get_ticks() - start_ticks;
+
+	impl_print("replay", instructions, bytes, iterations, ticks, benchmark_allocations - start_allocations);
+
+	r64 seconds = (r64)ticks / (r64)engine_time_get_precision();
+	r64 frames  = (r64)frames_count * (r64)iterations;
+	printf("frames: %u, frames/s: %.0f, us/frame: %.2f\n", frames_count, frames / seconds, seconds * 1e6 / frames);
+
+	engine_rendering_capture_free(capture);
+}
+
+//
+// GL stubs
+//
+
+#define STUB_CALL() ++stub_calls
+
+static void APIENTRY stub_GetIntegerv(GLenum pname, GLint * data) {
+	STUB_CALL();
+	switch (pname) {
+		case GL_MAJOR_VERSION: *data = 4; break;
+		case GL_MINOR_VERSION: *data = 6; break;
+		case GL_VIEWPORT: data[0] = 0; data[1] = 0; data[2] = 1920; data[3] = 1080; break;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: *data = 256; break;
+		case GL_MAX_SAMPLES: *data = 8; break;
+		case GL_MAX_TEXTURE_MAX_ANISOTROPY: *data = 16; break;
+		default:               *data = 0; break;
+	}
+}
+
+static void APIENTRY stub_Viewport(GLint x, GLint y, GLsizei width, GLsizei height) { (void)x; (void)y; (void)width; (void)height; STUB_CALL(); }
+static void APIENTRY stub_ClipControl(GLenum origin, GLenum depth) { (void)origin; (void)depth; STUB_CALL(); }
+static void APIENTRY stub_Disable(GLenum cap) { (void)cap; STUB_CALL(); }
+static void APIENTRY stub_Enable(GLenum cap) { (void)cap; STUB_CALL(); }
+static void APIENTRY stub_DepthMask(GLboolean flag) { (void)flag; STUB_CALL(); }
+static void APIENTRY stub_DepthRange(GLdouble n, GLdouble f) { (void)n; (void)f; STUB_CALL(); }
+static void APIENTRY stub_DepthRangef(GLfloat n, GLfloat f) { (void)n; (void)f; STUB_CALL(); }
+static void APIENTRY stub_DepthFunc(GLenum func) { (void)func; STUB_CALL(); }
+static void APIENTRY stub_ClearDepth(GLdouble depth) { (void)depth; STUB_CALL(); }
+static void APIENTRY stub_ClearDepthf(GLfloat d) { (void)d; STUB_CALL(); }
+static void APIENTRY stub_ColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) { (void)red; (void)green; (void)blue; (void)alpha; STUB_CALL(); }
+static void APIENTRY stub_ClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) { (void)red; (void)green; (void)blue; (void)alpha; STUB_CALL(); }
+static void APIENTRY stub_BlendFunc(GLenum sfactor, GLenum dfactor) { (void)sfactor; (void)dfactor; STUB_CALL(); }
+static void APIENTRY stub_CullFace(GLenum mode) { (void)mode; STUB_CALL(); }
+static void APIENTRY stub_FrontFace(GLenum mode) { (void)mode; STUB_CALL(); }
+static void APIENTRY stub_ClearStencil(GLint s) { (void)s; STUB_CALL(); }
+static void APIENTRY stub_StencilMask(GLuint mask) { (void)mask; STUB_CALL(); }
+static void APIENTRY stub_StencilFunc(GLenum func, GLint ref, GLuint mask) { (void)func; (void)ref; (void)mask; STUB_CALL(); }
+static void APIENTRY stub_StencilOp(GLenum fail, GLenum zfail, GLenum zpass) { (void)fail; (void)zfail; (void)zpass; STUB_CALL(); }
+static GLuint APIENTRY stub_CreateProgram(void) { STUB_CALL(); return (GLuint)stub_calls; }
+static void APIENTRY stub_DeleteProgram(GLuint program) { (void)program; STUB_CALL(); }
+static void APIENTRY stub_UseProgram(GLuint program) { (void)program; STUB_CALL(); }
+static GLuint APIENTRY stub_CreateShader(GLenum type) { (void)type; STUB_CALL(); return (GLuint)stub_calls; }
+static void APIENTRY stub_DeleteShader(GLuint shader) { (void)shader; STUB_CALL(); }
+static void APIENTRY stub_ShaderSource(GLuint shader, GLsizei count, GLchar const * const * string, GLint const * length) { (void)shader; (void)count; (void)string; (void)length; STUB_CALL(); }
+static void APIENTRY stub_CompileShader(GLuint shader) { (void)shader; STUB_CALL(); }
+static void APIENTRY stub_GetShaderiv(GLuint shader, GLenum pname, GLint * params) { (void)shader; (void)pname; STUB_CALL(); *params = GL_TRUE; }
+static void APIENTRY stub_AttachShader(GLuint program, GLuint shader) { (void)program; (void)shader; STUB_CALL(); }
+static void APIENTRY stub_DetachShader(GLuint program, GLuint shader) { (void)program; (void)shader; STUB_CALL(); }
+static void APIENTRY stub_LinkProgram(GLuint program) { (void)program; STUB_CALL(); }
+
+// reflection of the stock shaders: a block per frequency, `u_Texture` in the default block
+static cstring const stub_uniforms[]   = {"u_Camera", "u_Color", "u_Transform", "u_Texture"};
+static cstring const stub_attributes[] = {"a_Position", "a_TexCoord"};
+static cstring const stub_blocks[]     = {"Frame", "Material", "Draw"};
+
+static void stub_name(cstring value, GLsizei size, GLsizei * length, GLchar * name) {
+	GLsizei const value_length = (GLsizei)strlen(value);
+	*length = (value_length < size) ? value_length : size - 1;
+	memcpy(name, value, (size_t)*length);
+	name[*length] = '\0';
+}
+
+static void APIENTRY stub_GetProgramiv(GLuint program, GLenum pname, GLint * params) {
+	(void)program; STUB_CALL();
+	switch (pname) {
+		case GL_ACTIVE_UNIFORMS:       *params = sizeof(stub_uniforms) / sizeof(*stub_uniforms); break;
+		case GL_ACTIVE_ATTRIBUTES:     *params = sizeof(stub_attributes) / sizeof(*stub_attributes); break;
+		case GL_ACTIVE_UNIFORM_BLOCKS: *params = sizeof(stub_blocks) / sizeof(*stub_blocks); break;
+		case GL_ACTIVE_UNIFORM_MAX_LENGTH:            *params = 16; break;
+		case GL_ACTIVE_ATTRIBUTE_MAX_LENGTH:          *params = 16; break;
+		case GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH: *params = 16; break;
+		default: *params = GL_TRUE; break;
+	}
+}
+static void APIENTRY stub_GetActiveUniform(GLuint program, GLuint index, GLsizei size, GLsizei * length, GLint * count, GLenum * type, GLchar * name) {
+	(void)program; STUB_CALL();
+	*count = 1; *type = (index == 3) ? GL_SAMPLER_2D : (index == 1) ? GL_FLOAT_VEC4 : GL_FLOAT_MAT4;
+	stub_name(stub_uniforms[index], size, length, name);
+}
+static void APIENTRY stub_GetActiveAttrib(GLuint program, GLuint index, GLsizei size, GLsizei * length, GLint * count, GLenum * type, GLchar * name) {
+	(void)program; STUB_CALL();
+	*count = 1; *type = (index == 0) ? GL_FLOAT_VEC3 : GL_FLOAT_VEC2;
+	stub_name(stub_attributes[index], size, length, name);
+}
+static GLint APIENTRY stub_GetAttribLocation(GLuint program, GLchar const * name) { (void)program; (void)name; STUB_CALL(); return 0; }
+static void APIENTRY stub_GetActiveUniformBlockName(GLuint program, GLuint index, GLsizei size, GLsizei * length, GLchar * name) {
+	(void)program; STUB_CALL();
+	stub_name(stub_blocks[index], size, length, name);
+}
+static void APIENTRY stub_GetActiveUniformBlockiv(GLuint program, GLuint index, GLenum pname, GLint * params) { (void)program; (void)index; (void)pname; STUB_CALL(); *params = 64; }
+static void APIENTRY stub_UniformBlockBinding(GLuint program, GLuint index, GLuint binding) { (void)program; (void)index; (void)binding; STUB_CALL(); }
+static void APIENTRY stub_GetActiveUniformsiv(GLuint program, GLsizei count, GLuint const * indices, GLenum pname, GLint * params) {
+	(void)program; STUB_CALL();
+	for (GLsizei i = 0; i < count; ++i) {
+		switch (pname) {
+			case GL_UNIFORM_BLOCK_INDEX:   params[i] = (indices[i] < 3) ? (GLint)indices[i] : -1; break;
+			case GL_UNIFORM_MATRIX_STRIDE: params[i] = 16; break;
+			default:                       params[i] = 0; break;
+		}
+	}
+}
+static GLint APIENTRY stub_GetUniformLocation(GLuint program, GLchar const * name) { (void)program; (void)name; STUB_CALL(); return 0; }
+static void APIENTRY stub_BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) { (void)target; (void)index; (void)buffer; (void)offset; (void)size; STUB_CALL(); }
+static void APIENTRY stub_Uniform1iv(GLint location, GLsizei count, GLint const * value) { (void)location; (void)count; (void)value; STUB_CALL(); }
+static void APIENTRY stub_Uniform4fv(GLint location, GLsizei count, GLfloat const * value) { (void)location; (void)count; (void)value; STUB_CALL(); }
+static void APIENTRY stub_UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, GLfloat const * value) { (void)location; (void)count; (void)transpose; (void)value; STUB_CALL(); }
+static void APIENTRY stub_ProgramUniform1iv(GLuint program, GLint location, GLsizei count, GLint const * value) { (void)program; (void)location; (void)count; (void)value; STUB_CALL(); }
+static void APIENTRY stub_ProgramUniform4fv(GLuint program, GLint location, GLsizei count, GLfloat const * value) { (void)program; (void)location; (void)count; (void)value; STUB_CALL(); }
+static void APIENTRY stub_ProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, GLfloat const * value) { (void)program; (void)location; (void)count; (void)transpose; (void)value; STUB_CALL(); }
+static void APIENTRY stub_Clear(GLbitfield mask) { (void)mask; STUB_CALL(); }
+static void APIENTRY stub_BindVertexArray(GLuint array) { (void)array; STUB_CALL(); }
+static void APIENTRY stub_ActiveTexture(GLenum texture) { (void)texture; STUB_CALL(); }
+static void APIENTRY stub_BindTexture(GLenum target, GLuint texture) { (void)target; (void)texture; STUB_CALL(); }
+static void APIENTRY stub_GenVertexArrays(GLsizei n, GLuint * arrays) { for (GLsizei i = 0; i < n; ++i) { arrays[i] = (GLuint)++stub_calls; } }
+static void APIENTRY stub_DeleteVertexArrays(GLsizei n, GLuint const * arrays) { (void)n; (void)arrays; STUB_CALL(); }
+static void APIENTRY stub_GenBuffers(GLsizei n, GLuint * buffers) { for (GLsizei i = 0; i < n; ++i) { buffers[i] = (GLuint)++stub_calls; } }
+static void APIENTRY stub_DeleteBuffers(GLsizei n, GLuint const * buffers) { (void)n; (void)buffers; STUB_CALL(); }
+static void APIENTRY stub_BindBuffer(GLenum target, GLuint buffer) { (void)target; (void)buffer; STUB_CALL(); }
+static void APIENTRY stub_BufferData(GLenum target, GLsizeiptr size, void const * data, GLenum usage) { (void)target; (void)size; (void)data; (void)usage; STUB_CALL(); }
+static void APIENTRY stub_EnableVertexAttribArray(GLuint index) { (void)index; STUB_CALL(); }
+static void APIENTRY stub_DisableVertexAttribArray(GLuint index) { (void)index; STUB_CALL(); }
+static void APIENTRY stub_VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, void const * pointer) { (void)index; (void)size; (void)type; (void)normalized; (void)stride; (void)pointer; STUB_CALL(); }
+static void APIENTRY stub_VertexAttribDivisor(GLuint index, GLuint divisor) { (void)index; (void)divisor; STUB_CALL(); }
+static void APIENTRY stub_VertexAttrib4fv(GLuint index, GLfloat const * v) { (void)index; (void)v; STUB_CALL(); }
+static void APIENTRY stub_DrawArrays(GLenum mode, GLint first, GLsizei count) { (void)mode; (void)first; (void)count; STUB_CALL(); }
+static void APIENTRY stub_MultiDrawArraysIndirect(GLenum mode, void const * indirect, GLsizei drawcount, GLsizei stride) { (void)mode; (void)indirect; (void)drawcount; (void)stride; STUB_CALL(); }
+static void APIENTRY stub_BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void const * data) { (void)target; (void)offset; (void)size; (void)data; STUB_CALL(); }
+static void APIENTRY stub_BufferStorage(GLenum target, GLsizeiptr size, void const * data, GLbitfield flags) { (void)target; (void)size; (void)data; (void)flags; STUB_CALL(); }
+static void * APIENTRY stub_MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	(void)target; (void)offset; (void)access; STUB_CALL();
+	// one mapping serves every buffer, it lives as long as the benchmark, outside of the counted allocations
+	// - persistent ones are kept by the VM, so it never moves
+	size_t const mapping_length = 16 * 1024 * 1024;
+	if ((size_t)length > mapping_length) { return NULL; }
+	if (!stub_mapping) { stub_mapping = malloc(mapping_length); }
+	return stub_mapping;
+}
+static GLboolean APIENTRY stub_UnmapBuffer(GLenum target) { (void)target; STUB_CALL(); return GL_TRUE; }
+static GLsync APIENTRY stub_FenceSync(GLenum condition, GLbitfield flags) { (void)condition; (void)flags; STUB_CALL(); return (GLsync)(size_t)stub_calls; }
+static GLenum APIENTRY stub_ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { (void)sync; (void)flags; (void)timeout; STUB_CALL(); return GL_ALREADY_SIGNALED; }
+static void APIENTRY stub_DeleteSync(GLsync sync) { (void)sync; STUB_CALL(); }
+static void APIENTRY stub_DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) { (void)mode; (void)first; (void)count; (void)instancecount; STUB_CALL(); }
+static void APIENTRY stub_GenTextures(GLsizei n, GLuint * textures) { for (GLsizei i = 0; i < n; ++i) { textures[i] = (GLuint)++stub_calls; } }
+static void APIENTRY stub_DeleteTextures(GLsizei n, GLuint const * textures) { (void)n; (void)textures; STUB_CALL(); }
+static void APIENTRY stub_TexParameteri(GLenum target, GLenum pname, GLint param) { (void)target; (void)pname; (void)param; STUB_CALL(); }
+static void APIENTRY stub_TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, void const * pixels) { (void)target; (void)level; (void)xoffset; (void)yoffset; (void)width; (void)height; (void)format; (void)type; (void)pixels; STUB_CALL(); }
+static void APIENTRY stub_PixelStorei(GLenum pname, GLint param) { (void)pname; (void)param; STUB_CALL(); }
+static void APIENTRY stub_GenerateMipmap(GLenum target) { (void)target; STUB_CALL(); }
+static void APIENTRY stub_TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, void const * pixels) { (void)target; (void)level; (void)internalformat; (void)width; (void)height; (void)border; (void)format; (void)type; (void)pixels; STUB_CALL(); }
+static void APIENTRY stub_GenFramebuffers(GLsizei n, GLuint * framebuffers) { for (GLsizei i = 0; i < n; ++i) { framebuffers[i] = (GLuint)++stub_calls; } }
+static void APIENTRY stub_DeleteFramebuffers(GLsizei n, GLuint const * framebuffers) { (void)n; (void)framebuffers; STUB_CALL(); }
+static void APIENTRY stub_BindFramebuffer(GLenum target, GLuint framebuffer) { (void)target; (void)framebuffer; STUB_CALL(); }
+static void APIENTRY stub_FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) { (void)target; (void)attachment; (void)textarget; (void)texture; (void)level; STUB_CALL(); }
+static void APIENTRY stub_FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) { (void)target; (void)attachment; (void)renderbuffertarget; (void)renderbuffer; STUB_CALL(); }
+static GLenum APIENTRY stub_CheckFramebufferStatus(GLenum target) { (void)target; STUB_CALL(); return GL_FRAMEBUFFER_COMPLETE; }
+static void APIENTRY stub_BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) { (void)srcX0; (void)srcY0; (void)srcX1; (void)srcY1; (void)dstX0; (void)dstY0; (void)dstX1; (void)dstY1; (void)mask; (void)filter; STUB_CALL(); }
+static void APIENTRY stub_DrawBuffers(GLsizei n, GLenum const * bufs) { (void)n; (void)bufs; STUB_CALL(); }
+static void APIENTRY stub_ReadBuffer(GLenum src) { (void)src; STUB_CALL(); }
+static void APIENTRY stub_GenRenderbuffers(GLsizei n, GLuint * renderbuffers) { for (GLsizei i = 0; i < n; ++i) { renderbuffers[i] = (GLuint)++stub_calls; } }
+static void APIENTRY stub_DeleteRenderbuffers(GLsizei n, GLuint const * renderbuffers) { (void)n; (void)renderbuffers; STUB_CALL(); }
+static void APIENTRY stub_BindRenderbuffer(GLenum target, GLuint renderbuffer) { (void)target; (void)renderbuffer; STUB_CALL(); }
+static void APIENTRY stub_RenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height) { (void)target; (void)samples; (void)internalformat; (void)width; (void)height; STUB_CALL(); }
+static void APIENTRY stub_ClearBufferfv(GLenum buffer, GLint drawbuffer, GLfloat const * value) { (void)buffer; (void)drawbuffer; (void)value; STUB_CALL(); }
+static void APIENTRY stub_ClearBufferiv(GLenum buffer, GLint drawbuffer, GLint const * value) { (void)buffer; (void)drawbuffer; (void)value; STUB_CALL(); }
+static void APIENTRY stub_ClearBufferuiv(GLenum buffer, GLint drawbuffer, GLuint const * value) { (void)buffer; (void)drawbuffer; (void)value; STUB_CALL(); }
+static void APIENTRY stub_ClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil) { (void)buffer; (void)drawbuffer; (void)depth; (void)stencil; STUB_CALL(); }
+static void APIENTRY stub_GenSamplers(GLsizei count, GLuint * samplers) { for (GLsizei i = 0; i < count; ++i) { samplers[i] = (GLuint)++stub_calls; } }
+static void APIENTRY stub_DeleteSamplers(GLsizei count, GLuint const * samplers) { (void)count; (void)samplers; STUB_CALL(); }
+static void APIENTRY stub_BindSampler(GLuint unit, GLuint sampler) { (void)unit; (void)sampler; STUB_CALL(); }
+static void APIENTRY stub_SamplerParameteri(GLuint sampler, GLenum pname, GLint param) { (void)sampler; (void)pname; (void)param; STUB_CALL(); }
+
+#undef STUB_CALL
+
+static void impl_stub_gl(void) {
+	glGetIntegerv  = stub_GetIntegerv;
+	glViewport     = stub_Viewport;
+	glClipControl  = stub_ClipControl;
+	glDisable      = stub_Disable;
+	glEnable       = stub_Enable;
+	glDepthMask    = stub_DepthMask;
+	glDepthRange   = stub_DepthRange;
+	glDepthRangef  = stub_DepthRangef;
+	glDepthFunc    = stub_DepthFunc;
+	glClearDepth   = stub_ClearDepth;
+	glClearDepthf  = stub_ClearDepthf;
+	glColorMask    = stub_ColorMask;
+	glClearColor   = stub_ClearColor;
+	glBlendFunc    = stub_BlendFunc;
+	glCullFace     = stub_CullFace;
+	glFrontFace    = stub_FrontFace;
+	glClearStencil = stub_ClearStencil;
+	glStencilMask  = stub_StencilMask;
+	glStencilFunc  = stub_StencilFunc;
+	glStencilOp    = stub_StencilOp;
+	glCreateProgram = stub_CreateProgram;
+	glDeleteProgram = stub_DeleteProgram;
+	glUseProgram    = stub_UseProgram;
+	glCreateShader  = stub_CreateShader;
+	glDeleteShader  = stub_DeleteShader;
+	glShaderSource  = stub_ShaderSource;
+	glCompileShader = stub_CompileShader;
+	glGetShaderiv   = stub_GetShaderiv;
+	glAttachShader  = stub_AttachShader;
+	glDetachShader  = stub_DetachShader;
+	glLinkProgram   = stub_LinkProgram;
+	glGetProgramiv  = stub_GetProgramiv;
+	glGetActiveUniform        = stub_GetActiveUniform;
+	glGetActiveAttrib         = stub_GetActiveAttrib;
+	glGetAttribLocation       = stub_GetAttribLocation;
+	glGetActiveUniformBlockName = stub_GetActiveUniformBlockName;
+	glGetActiveUniformBlockiv = stub_GetActiveUniformBlockiv;
+	glUniformBlockBinding     = stub_UniformBlockBinding;
+	glGetActiveUniformsiv     = stub_GetActiveUniformsiv;
+	glGetUniformLocation      = stub_GetUniformLocation;
+	glBindBufferRange         = stub_BindBufferRange;
+	glUniform1iv              = stub_Uniform1iv;
+	glUniform4fv              = stub_Uniform4fv;
+	glUniformMatrix4fv        = stub_UniformMatrix4fv;
+	glProgramUniform1iv       = stub_ProgramUniform1iv;
+	glProgramUniform4fv       = stub_ProgramUniform4fv;
+	glProgramUniformMatrix4fv = stub_ProgramUniformMatrix4fv;
+	glClear         = stub_Clear;
+	glBindVertexArray = stub_BindVertexArray;
+	glActiveTexture   = stub_ActiveTexture;
+	glBindTexture     = stub_BindTexture;
+	glGenVertexArrays    = stub_GenVertexArrays;
+	glDeleteVertexArrays = stub_DeleteVertexArrays;
+	glGenBuffers         = stub_GenBuffers;
+	glDeleteBuffers      = stub_DeleteBuffers;
+	glBindBuffer         = stub_BindBuffer;
+	glBufferData         = stub_BufferData;
+	glBufferSubData      = stub_BufferSubData;
+	glBufferStorage      = stub_BufferStorage;
+	glMapBufferRange     = stub_MapBufferRange;
+	glUnmapBuffer        = stub_UnmapBuffer;
+	glFenceSync          = stub_FenceSync;
+	glClientWaitSync     = stub_ClientWaitSync;
+	glDeleteSync         = stub_DeleteSync;
+	glEnableVertexAttribArray  = stub_EnableVertexAttribArray;
+	glDisableVertexAttribArray = stub_DisableVertexAttribArray;
+	glVertexAttribPointer      = stub_VertexAttribPointer;
+	glVertexAttribDivisor      = stub_VertexAttribDivisor;
+	glVertexAttrib4fv          = stub_VertexAttrib4fv;
+	glDrawArrays          = stub_DrawArrays;
+	glDrawArraysInstanced = stub_DrawArraysInstanced;
+	glMultiDrawArraysIndirect = stub_MultiDrawArraysIndirect;
+	glGenTextures    = stub_GenTextures;
+	glDeleteTextures = stub_DeleteTextures;
+	glTexParameteri  = stub_TexParameteri;
+	glTexImage2D     = stub_TexImage2D;
+	glTexSubImage2D  = stub_TexSubImage2D;
+	glPixelStorei    = stub_PixelStorei;
+	glGenerateMipmap = stub_GenerateMipmap;
+	glGenFramebuffers         = stub_GenFramebuffers;
+	glDeleteFramebuffers      = stub_DeleteFramebuffers;
+	glBindFramebuffer         = stub_BindFramebuffer;
+	glFramebufferTexture2D    = stub_FramebufferTexture2D;
+	glFramebufferRenderbuffer = stub_FramebufferRenderbuffer;
+	glCheckFramebufferStatus  = stub_CheckFramebufferStatus;
+	glBlitFramebuffer         = stub_BlitFramebuffer;
+	glDrawBuffers             = stub_DrawBuffers;
+	glReadBuffer              = stub_ReadBuffer;
+	glGenRenderbuffers        = stub_GenRenderbuffers;
+	glDeleteRenderbuffers     = stub_DeleteRenderbuffers;
+	glBindRenderbuffer        = stub_BindRenderbuffer;
+	glRenderbufferStorageMultisample = stub_RenderbufferStorageMultisample;
+	glClearBufferfv  = stub_ClearBufferfv;
+	glClearBufferiv  = stub_ClearBufferiv;
+	glClearBufferuiv = stub_ClearBufferuiv;
+	glClearBufferfi  = stub_ClearBufferfi;
+	glGenSamplers       = stub_GenSamplers;
+	glDeleteSamplers    = stub_DeleteSamplers;
+	glBindSampler       = stub_BindSampler;
+	glSamplerParameteri = stub_SamplerParameteri;
+}
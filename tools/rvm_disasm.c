@@ -0,0 +1,939 @@
+#include "engine/api/code.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_capture.h"
+#include "engine/api/rendering_optimizer.h"
+#include "engine/api/platform_file.h"
+
+#include <stdarg.h>
+
+// offline disassembler and validator of rendering VM streams, requires no GL context
+// - usage: `rvm_disasm [-s] [-c] [-o optimized.bin] stream.bin`, where `-s` skips the disassembly and prints the report only,
+//   `-c` reads a capture made with `engine_rendering_capture_begin`
+//   and `-o` writes the stream rewritten by `engine_rendering_optimizer_run`, then disassembles that
+// - validates headers, enum ranges and references against allocations seen earlier in the stream
+// - reports instruction histogram, bytes, redundant state changes, draws per shader and texture
+
+#define DISASM_UNITS 16
+
+struct Id_Map {
+	u32 * keys, * values;
+	u32 count, capacity;
+};
+
+struct Disasm_Stats {
+	u32 count[RVM_Instruction_Count];
+	u64 bytes[RVM_Instruction_Count];
+	u32 redundant[RVM_Instruction_Count];
+	u32 errors;
+	char errors_text[512]; size_t errors_length; // of the current instruction
+	//
+	struct Id_Map shaders, meshes, textures, pipelines, bundles, targets, samplers; // alive resources
+	struct Id_Map pipeline_shaders; // shader id + 1, `UINT32_MAX` for none
+	struct Id_Map bundle_slots;     // recorded instructions count + 1
+	struct Id_Map target_textures;  // by texture, the owning target id + 2, `1` once released
+	struct Id_Map draws_per_shader, draws_per_texture;
+	//
+	// the last payload of each state instruction, to spot redundant ones
+	u8 const * last_state[RVM_Instruction_Count];
+	u8 const * last_unit[DISASM_UNITS], * last_sampler[DISASM_UNITS];
+	u32 shader, texture;
+};
+
+static cstring const instruction_names[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) # name,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static u32 const payload_sizes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_PAYLOAD_SIZE(name),
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static enum RVM_Scope const scopes[] = {
+	#define REGISTRY_RVM_INSTRUCTION(name, scope) RVM_Scope_ ## scope,
+	#include "engine/registry/rendering_vm_instruction.h"
+};
+
+static void impl_disasm(u8 const * buffer, size_t length, bool print, struct Disasm_Stats * stats);
+static void impl_report(struct Disasm_Stats const * stats);
+static void impl_report_optimizer(struct Rendering_Optimizer_Report const * report);
+static void impl_id_map_free(struct Id_Map * map);
+
+int main(int argc, char * argv[]) {
+	bool print = true, capture = false;
+	cstring path = NULL, optimized_path = NULL;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-s") == 0) { print = false; continue; }
+		if (strcmp(argv[i], "-c") == 0) { capture = true; continue; }
+		if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) { optimized_path = argv[++i]; continue; }
+		path = argv[i];
+	}
+
+	if (!path || (capture && optimized_path)) {
+		printf("usage: rvm_disasm [-s] [-c] [-o optimized.bin] stream.bin\n");
+		return 1;
+	}
+
+	struct Disasm_Stats stats;
+	memset(&stats, 0, sizeof(stats));
+	stats.shader  = REF_EMPTY_ID;
+	stats.texture = REF_EMPTY_ID;
+
+	if (capture) {
+		struct Rendering_Capture * rendering_capture = engine_rendering_capture_load(path);
+		if (!rendering_capture) { return 1; }
+		if (!engine_rendering_capture_is_complete(rendering_capture)) {
+			printf("; the capture began mid-session, allocations of live resources are missing\n");
+		}
+
+		// offsets are relative to each stream
+		u32 const frames_count = engine_rendering_capture_get_frames_count(rendering_capture);
+		for (u32 frame_i = 0; frame_i < frames_count; ++frame_i) {
+			u32 const streams_count = engine_rendering_capture_get_streams_count(rendering_capture, frame_i);
+			for (u32 stream_i = 0; stream_i < streams_count; ++stream_i) {
+				if (print) { printf("; frame %u, stream %u\n", frame_i, stream_i); }
+				size_t stream_length;
+				u8 const * stream = engine_rendering_capture_get_stream(rendering_capture, frame_i, stream_i, &stream_length);
+				impl_disasm(stream, stream_length, print, &stats);
+			}
+		}
+
+		engine_rendering_capture_free(rendering_capture);
+	}
+	else {
+		u8 * buffer = NULL; size_t buffer_size = 0;
+		engine_file_read(path, &buffer, &buffer_size);
+		if (!buffer) { return 1; }
+
+		if (optimized_path) {
+			struct Rendering_Optimizer_Report report;
+			memset(&report, 0, sizeof(report));
+
+			u8 * optimized = ENGINE_MALLOC(buffer_size ? buffer_size : 1);
+			size_t const optimized_size = engine_rendering_optimizer_run(buffer, buffer_size, optimized, &report, NULL);
+			if (!engine_file_write(optimized_path, optimized, optimized_size)) { printf("can't write %s\n", optimized_path); }
+			impl_report_optimizer(&report);
+
+			ENGINE_FREE(buffer);
+			buffer = optimized; buffer_size = optimized_size;
+		}
+
+		impl_disasm(buffer, buffer_size, print, &stats);
+		ENGINE_FREE(buffer);
+	}
+
+	impl_report(&stats);
+
+	impl_id_map_free(&stats.shaders);
+	impl_id_map_free(&stats.meshes);
+	impl_id_map_free(&stats.textures);
+	impl_id_map_free(&stats.pipelines);
+	impl_id_map_free(&stats.bundles);
+	impl_id_map_free(&stats.targets);
+	impl_id_map_free(&stats.samplers);
+	impl_id_map_free(&stats.pipeline_shaders);
+	impl_id_map_free(&stats.bundle_slots);
+	impl_id_map_free(&stats.target_textures);
+	impl_id_map_free(&stats.draws_per_shader);
+	impl_id_map_free(&stats.draws_per_texture);
+
+	return stats.errors ? 2 : 0;
+}
+
+//
+// id map, open addressing
+//
+
+static u32 impl_id_map_hash(u32 value) {
+	value ^= value >> 16; value *= 0x7feb352dU;
+	value ^= value >> 15; value *= 0x846ca68bU;
+	value ^= value >> 16;
+	return value;
+}
+
+static u32 * impl_id_map_find(struct Id_Map const * map, u32 key) {
+	if (!map->capacity) { return NULL; }
+	u32 const mask = map->capacity - 1;
+	for (u32 i = impl_id_map_hash(key) & mask; ; i = (i + 1) & mask) {
+		if (map->values[i] == 0) { return NULL; }
+		if (map->keys[i] == key) { return map->values + i; }
+	}
+}
+
+static void impl_id_map_set(struct Id_Map * map, u32 key, u32 value);
+
+static void impl_id_map_grow(struct Id_Map * map) {
+	struct Id_Map grown = {.capacity = map->capacity ? map->capacity * 2 : 64};
+	grown.keys   = ENGINE_MALLOC(grown.capacity * sizeof(*grown.keys));
+	grown.values = ENGINE_MALLOC(grown.capacity * sizeof(*grown.values));
+	memset(grown.values, 0, grown.capacity * sizeof(*grown.values));
+
+	for (u32 i = 0; i < map->capacity; ++i) {
+		if (map->values[i]) { impl_id_map_set(&grown, map->keys[i], map->values[i]); }
+	}
+
+	impl_id_map_free(map);
+	*map = grown;
+}
+
+// a zero value marks an empty slot; stored values are positive
+static void impl_id_map_set(struct Id_Map * map, u32 key, u32 value) {
+	u32 * existing = impl_id_map_find(map, key);
+	if (existing) { *existing = value; return; }
+
+	if ((map->count + 1) * 4 > map->capacity * 3) { impl_id_map_grow(map); }
+
+	u32 const mask = map->capacity - 1;
+	for (u32 i = impl_id_map_hash(key) & mask; ; i = (i + 1) & mask) {
+		if (map->values[i]) { continue; }
+		map->keys[i] = key; map->values[i] = value;
+		map->count++;
+		return;
+	}
+}
+
+static void impl_id_map_free(struct Id_Map * map) {
+	ENGINE_FREE(map->keys);
+	ENGINE_FREE(map->values);
+	*map = (struct Id_Map){0};
+}
+
+//
+// validation
+//
+
+static cstring const comparison_names[] = {"False", "True", "Less", "LEqual", "Equal", "NEqual", "Greater", "GEqual"};
+static cstring const operation_names[]  = {"Keep", "Invert", "Zero", "Replace", "Incr", "Incr_Wrap", "Decr", "Decr_Wrap"};
+static cstring const blend_names[]      = {"Opaque", "Alpha", "Additive", "Multiply", "PMAlpha", "PMAdditive"};
+static cstring const face_cull_names[]  = {"None", "Back", "Front", "Both"};
+static cstring const face_front_names[] = {"CCW", "CW"};
+
+static cstring const uniform_names[] = {
+	#define REGISTRY_RVM_UNIFORM(name, block) # name,
+	#include "engine/registry/rendering_vm_uniform.h"
+};
+
+static cstring const data_type_names[] = {
+	#define REGISTRY_DATA_TYPE(name) # name,
+	#include "engine/registry/data_type.h"
+};
+
+#define ENUM_NAME(names, value) (((u32)(value) < sizeof(names) / sizeof(names[0])) ? names[value] : "?")
+
+static void impl_error(struct Disasm_Stats * stats, size_t offset, cstring format, ...) {
+	stats->errors++;
+	size_t const capacity = sizeof(stats->errors_text) - stats->errors_length;
+	if (capacity <= 1) { return; }
+
+	int written = snprintf(stats->errors_text + stats->errors_length, capacity, "[err] %08zx: ", offset);
+	if (written < 0 || (size_t)written >= capacity) { stats->errors_length = sizeof(stats->errors_text) - 1; return; }
+	stats->errors_length += (size_t)written;
+
+	va_list args;
+	va_start(args, format);
+	written = vsnprintf(stats->errors_text + stats->errors_length, capacity - (size_t)written, format, args);
+	va_end(args);
+	if (written < 0 || stats->errors_length + (size_t)written + 1 >= sizeof(stats->errors_text)) { stats->errors_length = sizeof(stats->errors_text) - 1; return; }
+	stats->errors_length += (size_t)written;
+
+	stats->errors_text[stats->errors_length++] = '\n';
+	stats->errors_text[stats->errors_length] = '\0';
+}
+
+static void impl_flush_errors(struct Disasm_Stats * stats) {
+	if (!stats->errors_length) { return; }
+	printf("%s", stats->errors_text);
+	stats->errors_length = 0;
+}
+
+static void impl_check_enum(struct Disasm_Stats * stats, size_t offset, u32 value, u32 count, cstring what) {
+	if (value < count) { return; }
+	impl_error(stats, offset, "%s out of range: %u", what, value);
+}
+
+static void impl_check_bool(struct Disasm_Stats * stats, size_t offset, bool const * value) {
+	u8 raw; memcpy(&raw, value, sizeof(raw));
+	if (raw <= 1) { return; }
+	impl_error(stats, offset, "bool out of range: %u", raw);
+}
+
+static void impl_check_ref(struct Disasm_Stats * stats, size_t offset, struct Id_Map const * alive, struct Ref ref, bool allow_empty, cstring what) {
+	if (ref.id == REF_EMPTY_ID) {
+		if (!allow_empty) { impl_error(stats, offset, "empty ref"); }
+		return;
+	}
+	if (impl_id_map_find(alive, ref.id)) { return; }
+	impl_error(stats, offset, "%s %u is not allocated", what, ref.id);
+}
+
+static void impl_allocate(struct Disasm_Stats * stats, size_t offset, struct Id_Map * alive, struct Ref ref) {
+	if (ref.id == REF_EMPTY_ID) { impl_error(stats, offset, "empty ref"); return; }
+	u32 * value = impl_id_map_find(alive, ref.id);
+	if (value && *value == 2) { impl_error(stats, offset, "ref is allocated twice"); return; }
+	impl_id_map_set(alive, ref.id, 2);
+}
+
+static void impl_free(struct Disasm_Stats * stats, size_t offset, struct Id_Map * alive, struct Ref ref) {
+	u32 * value = impl_id_map_find(alive, ref.id);
+	if (!value || *value != 2) { impl_error(stats, offset, "ref is not allocated"); return; }
+	*value = 1; // keeps the slot, marks it as freed
+}
+
+static void impl_check_pipeline(struct Disasm_Stats * stats, size_t offset, struct RVM_Pipeline const * value) {
+	u32 const comparisons = sizeof(comparison_names) / sizeof(*comparison_names);
+	u32 const operations  = sizeof(operation_names) / sizeof(*operation_names);
+	impl_check_ref(stats, offset, &stats->shaders, value->shader.ref, true, "shader");
+	if ((u32)value->color_write.value & ~(u32)RVM_Color_Write_All) { impl_error(stats, offset, "color write mask out of range"); }
+	impl_check_enum(stats, offset, value->blend.value, sizeof(blend_names) / sizeof(*blend_names), "blend");
+	impl_check_bool(stats, offset, &value->depth_read.value);
+	impl_check_bool(stats, offset, &value->depth_write.value);
+	impl_check_enum(stats, offset, value->depth_comparison.value, comparisons, "comparison");
+	impl_check_bool(stats, offset, &value->stencil_read.value);
+	impl_check_enum(stats, offset, value->stencil_comparison.comparison, comparisons, "comparison");
+	impl_check_enum(stats, offset, value->stencil_operation.stencil_fail__depth_any,        operations, "operation");
+	impl_check_enum(stats, offset, value->stencil_operation.stencil_success__depth_fail,    operations, "operation");
+	impl_check_enum(stats, offset, value->stencil_operation.stencil_success__depth_success, operations, "operation");
+	impl_check_enum(stats, offset, value->cull.value, sizeof(face_cull_names) / sizeof(*face_cull_names), "face cull");
+	impl_check_enum(stats, offset, value->front.value, sizeof(face_front_names) / sizeof(*face_front_names), "face front");
+}
+
+// the recorded instructions count, or `UINT32_MAX` for a malformed record; their payloads are checked by the VM on each call
+static u32 impl_check_bundle(struct Disasm_Stats * stats, size_t offset, u8 const * data, u32 length) {
+	u32 count = 0;
+	for (u32 position = 0; position < length; count++) {
+		struct RVM_Header header;
+		if (length - position < sizeof(header)) { impl_error(stats, offset, "recorded header is truncated"); return UINT32_MAX; }
+		memcpy(&header, data + position, sizeof(header));
+		position += sizeof(header);
+
+		if (header.instruction >= RVM_Instruction_Count) { impl_error(stats, offset, "recorded instruction %u is unknown", count); return UINT32_MAX; }
+		if (scopes[header.instruction] != RVM_Scope_Bundle) { impl_error(stats, offset, "recorded instruction %u can't be bundled: %s", count, instruction_names[header.instruction]); return UINT32_MAX; }
+		if (header.size % RVM_ALIGNMENT || header.size < payload_sizes[header.instruction] || header.size > length - position) {
+			impl_error(stats, offset, "recorded instruction %u is malformed", count);
+			return UINT32_MAX;
+		}
+		position += header.size;
+	}
+	return count;
+}
+
+static u32 impl_data_size(enum Data_Type value) {
+	switch (value) {
+		case Data_Type_s8:  case Data_Type_u8:  return 1;
+		case Data_Type_s16: case Data_Type_u16: return 2;
+		case Data_Type_s32: case Data_Type_u32: case Data_Type_r32: case Data_Type_unit_id: return 4;
+		case Data_Type_r64: return 8;
+		case Data_Type_vec2: case Data_Type_svec2: case Data_Type_uvec2: return 4 * 2;
+		case Data_Type_vec3: case Data_Type_svec3: case Data_Type_uvec3: return 4 * 3;
+		case Data_Type_vec4: case Data_Type_svec4: case Data_Type_uvec4: return 4 * 4;
+		case Data_Type_mat2: return 4 * 2 * 2;
+		case Data_Type_mat3: return 4 * 3 * 3;
+		case Data_Type_mat4: return 4 * 4 * 4;
+	}
+	return 0;
+}
+
+static void impl_count(struct Id_Map * map, u32 id) {
+	u32 * value = impl_id_map_find(map, id);
+	if (value) { (*value)++; return; }
+	impl_id_map_set(map, id, 2); // values are offset by one, zero is an empty slot
+}
+
+//
+// disassembly
+//
+
+static void impl_disasm_instruction(enum RVM_Instruction instruction, void const * data, u32 size, size_t offset, bool print, struct Disasm_Stats * stats) {
+	#define PRINT(...) do { if (print) { printf(__VA_ARGS__); } } while (false)
+	switch (instruction) {
+		case RVM_Instruction_Common_Set_Clip: {
+			struct RVM_Common_Set_Clip const * payload = data;
+			impl_check_bool(stats, offset, &payload->lower_left);
+			impl_check_bool(stats, offset, &payload->zero_one);
+			PRINT("lower_left: %d, zero_one: %d", payload->lower_left, payload->zero_one);
+		} break;
+
+		case RVM_Instruction_Common_Set_Viewport: {
+			struct RVM_Common_Set_Viewport const * payload = data;
+			if (payload->size.x < 0 || payload->size.y < 0) { impl_error(stats, offset, "negative viewport size"); }
+			PRINT("pos: (%d, %d), size: (%d, %d)", payload->pos.x, payload->pos.y, payload->size.x, payload->size.y);
+		} break;
+
+		case RVM_Instruction_Color_Set_Write: {
+			struct RVM_Color_Set_Write const * payload = data;
+			if ((u32)payload->value & ~(u32)RVM_Color_Write_All) { impl_error(stats, offset, "color write mask out of range"); }
+			PRINT("%c%c%c%c",
+				(payload->value & RVM_Color_Write_R) ? 'R' : '-',
+				(payload->value & RVM_Color_Write_G) ? 'G' : '-',
+				(payload->value & RVM_Color_Write_B) ? 'B' : '-',
+				(payload->value & RVM_Color_Write_A) ? 'A' : '-'
+			);
+		} break;
+
+		case RVM_Instruction_Color_Set_Clear: {
+			struct RVM_Color_Set_Clear const * payload = data;
+			PRINT("(%g, %g, %g, %g)", (r64)payload->value.x, (r64)payload->value.y, (r64)payload->value.z, (r64)payload->value.w);
+		} break;
+
+		case RVM_Instruction_Color_Set_Blend: {
+			struct RVM_Color_Set_Blend const * payload = data;
+			impl_check_enum(stats, offset, payload->value, sizeof(blend_names) / sizeof(*blend_names), "blend");
+			PRINT("%s", ENUM_NAME(blend_names, payload->value));
+		} break;
+
+		case RVM_Instruction_Depth_Set_Read: {
+			struct RVM_Depth_Set_Read const * payload = data;
+			impl_check_bool(stats, offset, &payload->value);
+			PRINT("%d", payload->value);
+		} break;
+
+		case RVM_Instruction_Depth_Set_Write: {
+			struct RVM_Depth_Set_Write const * payload = data;
+			impl_check_bool(stats, offset, &payload->value);
+			PRINT("%d", payload->value);
+		} break;
+
+		case RVM_Instruction_Depth_Set_Clear: {
+			struct RVM_Depth_Set_Clear const * payload = data;
+			PRINT("%g", (r64)payload->value);
+		} break;
+
+		case RVM_Instruction_Depth_Set_Comparison: {
+			struct RVM_Depth_Set_Comparison const * payload = data;
+			impl_check_enum(stats, offset, payload->value, sizeof(comparison_names) / sizeof(*comparison_names), "comparison");
+			PRINT("%s", ENUM_NAME(comparison_names, payload->value));
+		} break;
+
+		case RVM_Instruction_Depth_Set_Range: {
+			struct RVM_Depth_Set_Range const * payload = data;
+			PRINT("(%g, %g)", (r64)payload->value.x, (r64)payload->value.y);
+		} break;
+
+		case RVM_Instruction_Stencil_Set_Read: {
+			struct RVM_Stencil_Set_Read const * payload = data;
+			impl_check_bool(stats, offset, &payload->value);
+			PRINT("%d", payload->value);
+		} break;
+
+		case RVM_Instruction_Stencil_Set_Write: {
+			struct RVM_Stencil_Set_Write const * payload = data;
+			PRINT("0x%02x", payload->value);
+		} break;
+
+		case RVM_Instruction_Stencil_Set_Clear: {
+			struct RVM_Stencil_Set_Clear const * payload = data;
+			PRINT("0x%02x", payload->value);
+		} break;
+
+		case RVM_Instruction_Stencil_Set_Comparison: {
+			struct RVM_Stencil_Set_Comparison const * payload = data;
+			impl_check_enum(stats, offset, payload->comparison, sizeof(comparison_names) / sizeof(*comparison_names), "comparison");
+			PRINT("%s, reference: 0x%02x, mask: 0x%02x", ENUM_NAME(comparison_names, payload->comparison), payload->reference, payload->mask);
+		} break;
+
+		case RVM_Instruction_Stencil_Set_Operation: {
+			struct RVM_Stencil_Set_Operation const * payload = data;
+			u32 const count = sizeof(operation_names) / sizeof(*operation_names);
+			impl_check_enum(stats, offset, payload->stencil_fail__depth_any,        count, "operation");
+			impl_check_enum(stats, offset, payload->stencil_success__depth_fail,    count, "operation");
+			impl_check_enum(stats, offset, payload->stencil_success__depth_success, count, "operation");
+			PRINT("%s, %s, %s",
+				ENUM_NAME(operation_names, payload->stencil_fail__depth_any),
+				ENUM_NAME(operation_names, payload->stencil_success__depth_fail),
+				ENUM_NAME(operation_names, payload->stencil_success__depth_success)
+			);
+		} break;
+
+		case RVM_Instruction_Face_Set_Cull: {
+			struct RVM_Face_Set_Cull const * payload = data;
+			impl_check_enum(stats, offset, payload->value, sizeof(face_cull_names) / sizeof(*face_cull_names), "face cull");
+			PRINT("%s", ENUM_NAME(face_cull_names, payload->value));
+		} break;
+
+		case RVM_Instruction_Face_Set_Front: {
+			struct RVM_Face_Set_Front const * payload = data;
+			impl_check_enum(stats, offset, payload->value, sizeof(face_front_names) / sizeof(*face_front_names), "face front");
+			PRINT("%s", ENUM_NAME(face_front_names, payload->value));
+		} break;
+
+		case RVM_Instruction_Shader_Allocate: {
+			struct RVM_Shader_Allocate const * payload = data;
+			impl_allocate(stats, offset, &stats->shaders, payload->ref);
+			PRINT("shader %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Shader_Free: {
+			struct RVM_Shader_Free const * payload = data;
+			impl_free(stats, offset, &stats->shaders, payload->ref);
+			if (stats->shader == payload->ref.id) { stats->shader = REF_EMPTY_ID; }
+			PRINT("shader %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Shader_Load: {
+			struct RVM_Shader_Load const * payload = data;
+			impl_check_ref(stats, offset, &stats->shaders, payload->ref, false, "shader");
+			PRINT("shader %u:%u, %zu bytes", payload->ref.id, payload->ref.gen, payload->asset.length);
+		} break;
+
+		case RVM_Instruction_Shader_Use: {
+			struct RVM_Shader_Use const * payload = data;
+			impl_check_ref(stats, offset, &stats->shaders, payload->ref, true, "shader");
+			stats->shader = payload->ref.id;
+			PRINT("shader %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Shader_Uniform: {
+			struct RVM_Shader_Uniform const * payload = data;
+			impl_check_ref(stats, offset, &stats->shaders, payload->ref, false, "shader");
+			impl_check_enum(stats, offset, payload->uniform, RVM_Uniform_Count, "uniform");
+			impl_check_enum(stats, offset, payload->type, sizeof(data_type_names) / sizeof(*data_type_names), "data type");
+			u64 const values_size = (u64)impl_data_size(payload->type) * payload->count;
+			if (values_size > size - payload_sizes[instruction]) { impl_error(stats, offset, "uniform values are truncated"); }
+			PRINT("shader %u:%u, %s, %s[%u]", payload->ref.id, payload->ref.gen,
+				ENUM_NAME(uniform_names, payload->uniform),
+				ENUM_NAME(data_type_names, payload->type),
+				payload->count
+			);
+		} break;
+
+		case RVM_Instruction_Mesh_Allocate: {
+			struct RVM_Mesh_Allocate const * payload = data;
+			impl_allocate(stats, offset, &stats->meshes, payload->ref);
+			if (payload->asset.location >= ASSET_MESH_ATTRIBUTES) { impl_error(stats, offset, "mesh location out of range"); }
+			PRINT("mesh %u:%u, %zu bytes, divisor %u%s", payload->ref.id, payload->ref.gen, payload->asset.length, payload->asset.divisor, payload->asset.transient ? ", transient" : "");
+		} break;
+
+		case RVM_Instruction_Mesh_Free: {
+			struct RVM_Mesh_Free const * payload = data;
+			impl_free(stats, offset, &stats->meshes, payload->ref);
+			PRINT("mesh %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Mesh_Load: {
+			struct RVM_Mesh_Load const * payload = data;
+			impl_check_ref(stats, offset, &stats->meshes, payload->ref, false, "mesh");
+			if (payload->asset.location >= ASSET_MESH_ATTRIBUTES) { impl_error(stats, offset, "mesh location out of range"); }
+			PRINT("mesh %u:%u, %zu bytes, divisor %u%s", payload->ref.id, payload->ref.gen, payload->asset.length, payload->asset.divisor, payload->asset.transient ? ", transient" : "");
+		} break;
+
+		case RVM_Instruction_Mesh_Use: {
+			struct RVM_Mesh_Use const * payload = data;
+			impl_check_ref(stats, offset, &stats->meshes, payload->ref, true, "mesh");
+			PRINT("mesh %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Texture_Allocate: {
+			struct RVM_Texture_Allocate const * payload = data;
+			impl_allocate(stats, offset, &stats->textures, payload->ref);
+			PRINT("texture %u:%u, %zu bytes", payload->ref.id, payload->ref.gen, payload->asset.length);
+		} break;
+
+		case RVM_Instruction_Texture_Free: {
+			struct RVM_Texture_Free const * payload = data;
+			u32 const * target = impl_id_map_find(&stats->target_textures, payload->ref.id);
+			if (target && *target >= 2) { impl_error(stats, offset, "texture %u is owned by target %u", payload->ref.id, *target - 2); }
+			else { impl_free(stats, offset, &stats->textures, payload->ref); }
+			if (stats->texture == payload->ref.id) { stats->texture = REF_EMPTY_ID; }
+			PRINT("texture %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Texture_Load: {
+			struct RVM_Texture_Load const * payload = data;
+			impl_check_ref(stats, offset, &stats->textures, payload->ref, false, "texture");
+			PRINT("texture %u:%u, %zu bytes", payload->ref.id, payload->ref.gen, payload->asset.length);
+		} break;
+
+		case RVM_Instruction_Unit_Allocate: {
+			struct RVM_Unit_Allocate const * payload = data;
+			impl_check_enum(stats, offset, payload->unit, DISASM_UNITS, "unit");
+			impl_check_ref(stats, offset, &stats->textures, payload->texture, true, "texture");
+			if (payload->unit == 0) { stats->texture = payload->texture.id; }
+			PRINT("unit %u, texture %u:%u", payload->unit, payload->texture.id, payload->texture.gen);
+		} break;
+
+		case RVM_Instruction_Unit_Free: {
+			struct RVM_Unit_Free const * payload = data;
+			impl_check_enum(stats, offset, payload->unit, DISASM_UNITS, "unit");
+			if (payload->unit == 0) { stats->texture = REF_EMPTY_ID; }
+			PRINT("unit %u", payload->unit);
+		} break;
+
+		case RVM_Instruction_Render_Clear: {
+			struct RVM_Render_Clear const * payload = data;
+			if ((u32)payload->mask & ~(u32)RVM_Clear_All) { impl_error(stats, offset, "clear mask out of range"); }
+			PRINT("%s%s%s",
+				(payload->mask & RVM_Clear_Color)   ? "color "   : "",
+				(payload->mask & RVM_Clear_Depth)   ? "depth "   : "",
+				(payload->mask & RVM_Clear_Stencil) ? "stencil " : ""
+			);
+		} break;
+
+		case RVM_Instruction_Render_Draw: {
+			struct RVM_Render_Draw const * payload = data;
+			impl_count(&stats->draws_per_shader, stats->shader);
+			impl_count(&stats->draws_per_texture, stats->texture);
+			PRINT("offset: %u, length: %u", payload->offset, payload->length);
+		} break;
+
+		case RVM_Instruction_Render_Draw_Instanced: {
+			struct RVM_Render_Draw_Instanced const * payload = data;
+			impl_check_ref(stats, offset, &stats->meshes, payload->instances, false, "mesh");
+			impl_count(&stats->draws_per_shader, stats->shader);
+			impl_count(&stats->draws_per_texture, stats->texture);
+			PRINT("offset: %u, length: %u, instances %u:%u, offset: %u, count: %u",
+				payload->offset, payload->length,
+				payload->instances.id, payload->instances.gen,
+				payload->instances_offset, payload->count
+			);
+		} break;
+
+		case RVM_Instruction_Render_Draw_Indirect: {
+			struct RVM_Render_Draw_Indirect const * payload = data;
+			if (payload->instances.id != REF_EMPTY_ID) { impl_check_ref(stats, offset, &stats->meshes, payload->instances, false, "mesh"); }
+			u64 const arguments_size = (u64)sizeof(struct RVM_Draw_Arguments) * payload->count;
+			bool const truncated = arguments_size > size - payload_sizes[instruction];
+			if (truncated) { impl_error(stats, offset, "draw arguments are truncated"); }
+			for (u32 i = 0; !truncated && i < payload->count; ++i) {
+				impl_count(&stats->draws_per_shader, stats->shader);
+				impl_count(&stats->draws_per_texture, stats->texture);
+			}
+			PRINT("instances %u:%u, count: %u", payload->instances.id, payload->instances.gen, payload->count);
+		} break;
+
+		case RVM_Instruction_Pipeline_Allocate: {
+			struct RVM_Pipeline_Allocate const * payload = data;
+			struct RVM_Pipeline const * value = &payload->value;
+			impl_allocate(stats, offset, &stats->pipelines, payload->ref);
+			impl_check_pipeline(stats, offset, value);
+			u32 const shader = value->shader.ref.id;
+			impl_id_map_set(&stats->pipeline_shaders, payload->ref.id, (shader == REF_EMPTY_ID) ? UINT32_MAX : shader + 1);
+			PRINT("pipeline %u:%u, shader %u:%u, %s, depth %d%d %s, stencil %d, cull %s",
+				payload->ref.id, payload->ref.gen,
+				value->shader.ref.id, value->shader.ref.gen,
+				ENUM_NAME(blend_names, value->blend.value),
+				value->depth_read.value, value->depth_write.value, ENUM_NAME(comparison_names, value->depth_comparison.value),
+				value->stencil_read.value,
+				ENUM_NAME(face_cull_names, value->cull.value)
+			);
+		} break;
+
+		case RVM_Instruction_Pipeline_Free: {
+			struct RVM_Pipeline_Free const * payload = data;
+			impl_free(stats, offset, &stats->pipelines, payload->ref);
+			PRINT("pipeline %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Pipeline_Use: {
+			struct RVM_Pipeline_Use const * payload = data;
+			impl_check_ref(stats, offset, &stats->pipelines, payload->ref, false, "pipeline");
+			u32 const * shader = impl_id_map_find(&stats->pipeline_shaders, payload->ref.id);
+			stats->shader = (shader && *shader != UINT32_MAX) ? *shader - 1 : REF_EMPTY_ID;
+			PRINT("pipeline %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Bundle_Allocate: {
+			struct RVM_Bundle_Allocate const * payload = data;
+			u32 const length = size - payload_sizes[instruction];
+			impl_allocate(stats, offset, &stats->bundles, payload->ref);
+			u32 const count = impl_check_bundle(stats, offset, (u8 const *)data + payload_sizes[instruction], length);
+			impl_id_map_set(&stats->bundle_slots, payload->ref.id, (count == UINT32_MAX) ? 1 : count + 1);
+			PRINT("bundle %u:%u, %u instructions, %u bytes", payload->ref.id, payload->ref.gen, (count == UINT32_MAX) ? 0 : count, length);
+		} break;
+
+		case RVM_Instruction_Bundle_Free: {
+			struct RVM_Bundle_Free const * payload = data;
+			impl_free(stats, offset, &stats->bundles, payload->ref);
+			PRINT("bundle %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Bundle_Call: {
+			struct RVM_Bundle_Call const * payload = data;
+			impl_check_ref(stats, offset, &stats->bundles, payload->ref, false, "bundle");
+			stats->shader = REF_EMPTY_ID;
+			stats->texture = REF_EMPTY_ID;
+			PRINT("bundle %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Bundle_Patch: {
+			struct RVM_Bundle_Patch const * payload = data;
+			impl_check_ref(stats, offset, &stats->bundles, payload->ref, false, "bundle");
+			u32 const * slots = impl_id_map_find(&stats->bundle_slots, payload->ref.id);
+			if (slots && payload->slot >= *slots - 1) { impl_error(stats, offset, "slot %u is out of range", payload->slot); }
+
+			struct RVM_Header header = {.instruction = RVM_Instruction_Count};
+			u32 const length = size - payload_sizes[instruction];
+			if (length >= sizeof(header)) { memcpy(&header, (u8 const *)data + payload_sizes[instruction], sizeof(header)); }
+			if (length < sizeof(header) || header.instruction >= RVM_Instruction_Count || header.size > length - sizeof(header)) {
+				impl_error(stats, offset, "replacing instruction is malformed");
+				header.instruction = RVM_Instruction_Count;
+			}
+			PRINT("bundle %u:%u, slot %u, %s", payload->ref.id, payload->ref.gen, payload->slot,
+				(header.instruction < RVM_Instruction_Count) ? instruction_names[header.instruction] : "?"
+			);
+		} break;
+
+		case RVM_Instruction_Target_Allocate: {
+			struct RVM_Target_Allocate const * payload = data;
+			impl_allocate(stats, offset, &stats->targets, payload->ref);
+			impl_check_bool(stats, offset, &payload->transient);
+			if (payload->size.x <= 0 || payload->size.y <= 0) { impl_error(stats, offset, "size is empty"); }
+			if (payload->count == 0 || payload->count > RVM_TARGET_ATTACHMENTS) { impl_error(stats, offset, "attachments count out of range"); }
+			for (u32 i = 0; i < payload->count && i < RVM_TARGET_ATTACHMENTS; ++i) {
+				struct RVM_Target_Attachment const * attachment = payload->attachments + i;
+				impl_check_enum(stats, offset, attachment->kind, Texture_Type_DStencil + 1, "texture type");
+				if (attachment->texture.id == REF_EMPTY_ID) { continue; }
+				impl_allocate(stats, offset, &stats->textures, attachment->texture);
+				impl_id_map_set(&stats->target_textures, attachment->texture.id, payload->ref.id + 2);
+			}
+			PRINT("target %u:%u, %dx%d, %u attachments, %u samples%s",
+				payload->ref.id, payload->ref.gen,
+				payload->size.x, payload->size.y, payload->count, payload->samples,
+				payload->transient ? ", transient" : ""
+			);
+		} break;
+
+		case RVM_Instruction_Target_Free: {
+			struct RVM_Target_Free const * payload = data;
+			impl_free(stats, offset, &stats->targets, payload->ref);
+			// the attachment textures go along
+			struct Id_Map * map = &stats->target_textures;
+			for (u32 i = 0; i < map->capacity; ++i) {
+				if (map->values[i] != payload->ref.id + 2) { continue; }
+				impl_free(stats, offset, &stats->textures, (struct Ref){.id = map->keys[i]});
+				if (stats->texture == map->keys[i]) { stats->texture = REF_EMPTY_ID; }
+				map->values[i] = 1;
+			}
+			PRINT("target %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Target_Load: {
+			struct RVM_Target_Load const * payload = data;
+			impl_check_ref(stats, offset, &stats->targets, payload->ref, false, "target");
+			if (payload->size.x <= 0 || payload->size.y <= 0) { impl_error(stats, offset, "size is empty"); }
+			PRINT("target %u:%u, %dx%d", payload->ref.id, payload->ref.gen, payload->size.x, payload->size.y);
+		} break;
+
+		case RVM_Instruction_Target_Use: {
+			struct RVM_Target_Use const * payload = data;
+			impl_check_ref(stats, offset, &stats->targets, payload->ref, true, "target");
+			if (payload->ref.id == REF_EMPTY_ID) { PRINT("window"); }
+			else { PRINT("target %u:%u", payload->ref.id, payload->ref.gen); }
+		} break;
+
+		case RVM_Instruction_Target_Clear: {
+			struct RVM_Target_Clear const * payload = data;
+			impl_check_enum(stats, offset, payload->attachment, RVM_TARGET_ATTACHMENTS, "attachment");
+			PRINT("attachment %u", payload->attachment);
+		} break;
+
+		case RVM_Instruction_Sampler_Allocate: {
+			struct RVM_Sampler_Allocate const * payload = data;
+			struct RVM_Sampler const * value = &payload->value;
+			impl_allocate(stats, offset, &stats->samplers, payload->ref);
+			impl_check_enum(stats, offset, value->filter_mipmap, Filter_Type_Linear + 1, "filter");
+			impl_check_enum(stats, offset, value->filter_min,    Filter_Type_Linear + 1, "filter");
+			impl_check_enum(stats, offset, value->filter_max,    Filter_Type_Linear + 1, "filter");
+			impl_check_enum(stats, offset, value->wrap_x,        Wrap_Type_MRepeat + 1,  "wrap");
+			impl_check_enum(stats, offset, value->wrap_y,        Wrap_Type_MRepeat + 1,  "wrap");
+			PRINT("sampler %u:%u, filter %u/%u/%u, wrap %u/%u, anisotropy %u",
+				payload->ref.id, payload->ref.gen,
+				value->filter_mipmap, value->filter_min, value->filter_max,
+				value->wrap_x, value->wrap_y, value->anisotropy
+			);
+		} break;
+
+		case RVM_Instruction_Sampler_Free: {
+			struct RVM_Sampler_Free const * payload = data;
+			impl_free(stats, offset, &stats->samplers, payload->ref);
+			PRINT("sampler %u:%u", payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Sampler_Use: {
+			struct RVM_Sampler_Use const * payload = data;
+			impl_check_enum(stats, offset, payload->unit, DISASM_UNITS, "unit");
+			impl_check_ref(stats, offset, &stats->samplers, payload->ref, true, "sampler");
+			PRINT("unit %u, sampler %u:%u", payload->unit, payload->ref.id, payload->ref.gen);
+		} break;
+
+		case RVM_Instruction_Count: break;
+	}
+	#undef PRINT
+}
+
+static bool impl_is_state(enum RVM_Instruction instruction) {
+	switch (instruction) {
+		case RVM_Instruction_Common_Set_Clip:
+		case RVM_Instruction_Common_Set_Viewport:
+		case RVM_Instruction_Color_Set_Write:
+		case RVM_Instruction_Color_Set_Clear:
+		case RVM_Instruction_Color_Set_Blend:
+		case RVM_Instruction_Depth_Set_Read:
+		case RVM_Instruction_Depth_Set_Write:
+		case RVM_Instruction_Depth_Set_Clear:
+		case RVM_Instruction_Depth_Set_Comparison:
+		case RVM_Instruction_Depth_Set_Range:
+		case RVM_Instruction_Stencil_Set_Read:
+		case RVM_Instruction_Stencil_Set_Write:
+		case RVM_Instruction_Stencil_Set_Clear:
+		case RVM_Instruction_Stencil_Set_Comparison:
+		case RVM_Instruction_Stencil_Set_Operation:
+		case RVM_Instruction_Face_Set_Cull:
+		case RVM_Instruction_Face_Set_Front:
+		case RVM_Instruction_Shader_Use:
+		case RVM_Instruction_Mesh_Use:
+		case RVM_Instruction_Pipeline_Use:
+		case RVM_Instruction_Target_Use:
+			return true;
+		default: return false;
+	}
+}
+
+// the state a `Pipeline_Use` sets as a whole
+static bool impl_is_pipeline_state(enum RVM_Instruction instruction) {
+	switch (instruction) {
+		case RVM_Instruction_Color_Set_Write:
+		case RVM_Instruction_Color_Set_Blend:
+		case RVM_Instruction_Depth_Set_Read:
+		case RVM_Instruction_Depth_Set_Write:
+		case RVM_Instruction_Depth_Set_Comparison:
+		case RVM_Instruction_Stencil_Set_Read:
+		case RVM_Instruction_Stencil_Set_Write:
+		case RVM_Instruction_Stencil_Set_Comparison:
+		case RVM_Instruction_Stencil_Set_Operation:
+		case RVM_Instruction_Face_Set_Cull:
+		case RVM_Instruction_Face_Set_Front:
+		case RVM_Instruction_Shader_Use:
+			return true;
+		default: return false;
+	}
+}
+
+static bool impl_is_redundant(enum RVM_Instruction instruction, u8 const * payload, struct Disasm_Stats * stats) {
+	u8 const ** last = NULL;
+	if (instruction == RVM_Instruction_Pipeline_Use) {
+		for (u32 i = 0; i < RVM_Instruction_Count; ++i) {
+			if (impl_is_pipeline_state((enum RVM_Instruction)i)) { stats->last_state[i] = NULL; }
+		}
+	}
+	else if (impl_is_pipeline_state(instruction)) { stats->last_state[RVM_Instruction_Pipeline_Use] = NULL; }
+
+	if (impl_is_state(instruction)) { last = stats->last_state + instruction; }
+	else if (instruction == RVM_Instruction_Unit_Allocate) {
+		struct RVM_Unit_Allocate const * unit = (void const *)payload;
+		if (unit->unit >= DISASM_UNITS) { return false; }
+		last = stats->last_unit + unit->unit;
+	}
+	else if (instruction == RVM_Instruction_Sampler_Use) {
+		struct RVM_Sampler_Use const * unit = (void const *)payload;
+		if (unit->unit >= DISASM_UNITS) { return false; }
+		last = stats->last_sampler + unit->unit;
+	}
+	else {
+		// resources changes invalidate the bindings
+		switch (instruction) {
+			case RVM_Instruction_Shader_Free:  stats->last_state[RVM_Instruction_Shader_Use] = NULL; stats->last_state[RVM_Instruction_Pipeline_Use] = NULL; break;
+			case RVM_Instruction_Pipeline_Free: stats->last_state[RVM_Instruction_Pipeline_Use] = NULL; break;
+			case RVM_Instruction_Bundle_Call: {
+				// the recorded state is unknown here
+				memset(stats->last_state, 0, sizeof(stats->last_state));
+				memset(stats->last_unit, 0, sizeof(stats->last_unit));
+				memset(stats->last_sampler, 0, sizeof(stats->last_sampler));
+			} break;
+			case RVM_Instruction_Mesh_Free:    stats->last_state[RVM_Instruction_Mesh_Use]   = NULL; break;
+			case RVM_Instruction_Texture_Free: memset(stats->last_unit, 0, sizeof(stats->last_unit)); break;
+			case RVM_Instruction_Sampler_Free: memset(stats->last_sampler, 0, sizeof(stats->last_sampler)); break;
+			case RVM_Instruction_Target_Load:  stats->last_state[RVM_Instruction_Target_Use] = NULL; break;
+			case RVM_Instruction_Target_Free: {
+				stats->last_state[RVM_Instruction_Target_Use] = NULL;
+				memset(stats->last_unit, 0, sizeof(stats->last_unit));
+			} break;
+			case RVM_Instruction_Unit_Free: {
+				struct RVM_Unit_Free const * unit = (void const *)payload;
+				if (unit->unit < DISASM_UNITS) { stats->last_unit[unit->unit] = NULL; }
+			} break;
+			default: break;
+		}
+		return false;
+	}
+
+	bool redundant = *last && memcmp(*last, payload, payload_sizes[instruction]) == 0;
+	*last = payload;
+	return redundant;
+}
+
+static void impl_disasm(u8 const * buffer, size_t length, bool print, struct Disasm_Stats * stats) {
+	size_t offset = 0;
+	while (length - offset >= sizeof(struct RVM_Header)) {
+		struct RVM_Header header;
+		memcpy(&header, buffer + offset, sizeof(header));
+		u8 const * payload = buffer + offset + sizeof(header);
+
+		if (header.instruction >= RVM_Instruction_Count) { impl_error(stats, offset, "unknown instruction, stopping"); impl_flush_errors(stats); return; }
+		if (header.size % RVM_ALIGNMENT) { impl_error(stats, offset, "unaligned payload size, stopping"); impl_flush_errors(stats); return; }
+		if (header.size < payload_sizes[header.instruction]) { impl_error(stats, offset, "payload is too short, stopping"); impl_flush_errors(stats); return; }
+		if (header.size > length - offset - sizeof(header)) { impl_error(stats, offset, "payload is truncated, stopping"); impl_flush_errors(stats); return; }
+
+		enum RVM_Instruction const instruction = (enum RVM_Instruction)header.instruction;
+		bool const redundant = impl_is_redundant(instruction, payload, stats);
+
+		stats->count[instruction]++;
+		stats->bytes[instruction] += sizeof(header) + header.size;
+		if (redundant) { stats->redundant[instruction]++; }
+
+		if (print) { printf("%08zx: %-22s ", offset, instruction_names[instruction]); }
+		impl_disasm_instruction(instruction, payload, header.size, offset, print, stats);
+		if (print) { printf("%s\n", redundant ? " ; redundant" : ""); }
+		impl_flush_errors(stats);
+
+		offset += sizeof(header) + header.size;
+	}
+
+	if (offset != length) { impl_error(stats, offset, "trailing bytes"); }
+	impl_flush_errors(stats);
+}
+
+//
+// report
+//
+
+static void impl_report_map(cstring title, struct Id_Map const * map) {
+	printf("\n%-10s %10s\n", title, "draws");
+	for (u32 i = 0; i < map->capacity; ++i) {
+		if (!map->values[i]) { continue; }
+		if (map->keys[i] == REF_EMPTY_ID) { printf("%-10s %10u\n", "none", map->values[i] - 1); continue; }
+		printf("%-10u %10u\n", map->keys[i], map->values[i] - 1);
+	}
+}
+
+static void impl_report(struct Disasm_Stats const * stats) {
+	u32 total_count = 0, total_redundant = 0; u64 total_bytes = 0;
+	printf("\n%-22s %10s %12s %10s\n", "instruction", "count", "bytes", "redundant");
+	for (u32 i = 0; i < RVM_Instruction_Count; ++i) {
+		if (!stats->count[i]) { continue; }
+		printf("%-22s %10u %12llu %10u\n", instruction_names[i], stats->count[i], (unsigned long long)stats->bytes[i], stats->redundant[i]);
+		total_count += stats->count[i];
+		total_bytes += stats->bytes[i];
+		total_redundant += stats->redundant[i];
+	}
+	printf("%-22s %10u %12llu %10u\n", "total", total_count, (unsigned long long)total_bytes, total_redundant);
+
+	impl_report_map("shader", &stats->draws_per_shader);
+	impl_report_map("texture", &stats->draws_per_texture);
+
+	printf("\nerrors: %u\n", stats->errors);
+}
+
+static void impl_report_optimizer(struct Rendering_Optimizer_Report const * report) {
+	printf("; optimized: %llu -> %llu instructions, %llu -> %llu bytes\n",
+		(unsigned long long)report->instructions_in, (unsigned long long)report->instructions_out,
+		(unsigned long long)report->bytes_in, (unsigned long long)report->bytes_out
+	);
+	for (u32 i = 0; i < RVM_Instruction_Count; ++i) {
+		if (!report->removed[i]) { continue; }
+		printf("; removed %-22s %10u\n", instruction_names[i], report->removed[i]);
+	}
+}
+
+//
+#undef ENUM_NAME
+#undef DISASM_UNITS
@@ -0,0 +1,293 @@
+#include "engine/api/code.h"
+#include "engine/api/maths.h"
+#include "engine/api/rendering_vm.h"
+#include "engine/api/rendering_buffer.h"
+#include "engine/api/rendering_capture.h"
+#include "engine/api/rendering_software.h"
+#include "engine/api/platform_system.h"
+#include "engine/api/platform_time.h"
+#include "engine/api/platform_file.h"
+
+// headless rendering through the software backend of the rendering VM
+// - usage: `rvm_render [-o image.ppm] [-s width height] [-t threads] [-f frames] [-c capture.rvmc]`
+// - draws the `texture_tint` and `instanced_tint` sandbox scene, or replays every frame of a capture, then saves the last frame
+
+static struct Asset_Shader scene_shader, scene_instanced_shader;
+
+static void impl_scene(struct Rendering_Buffer * buffer, svec2 size, r32 time);
+static void impl_shader_read(cstring path, struct Asset_Shader * asset, struct Asset_Shader fallback);
+static bool impl_save_ppm(cstring path, u32 const * color, svec2 size);
+
+int main(int argc, char * argv[]) {
+	cstring output_path = "rvm_render.ppm";
+	cstring capture_path = NULL;
+	u32 frames = 1;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) { output_path = argv[++i]; continue; }
+		if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) { capture_path = argv[++i]; continue; }
+		if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) { frames = (u32)strtoul(argv[++i], NULL, 10); continue; }
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) { hint_settings_software.threads = (u32)strtoul(argv[++i], NULL, 10); continue; }
+		if (strcmp(argv[i], "-s") == 0 && i + 2 < argc) {
+			hint_settings_software.size.x = (s32)strtol(argv[++i], NULL, 10);
+			hint_settings_software.size.y = (s32)strtol(argv[++i], NULL, 10);
+			continue;
+		}
+		printf("usage: rvm_render [-o image.ppm] [-s width height] [-t threads] [-f frames] [-c capture.rvmc]\n");
+		return 1;
+	}
+
+	engine_system_init();
+	engine_rendering_vm_init();
+
+	svec2 size;
+	engine_rendering_software_get_color(&size);
+
+	u64 start_ticks = engine_time_get_ticks();
+	if (capture_path) {
+		struct Rendering_Capture * capture = engine_rendering_capture_load(capture_path);
+		if (!capture) { engine_rendering_vm_deinit(); engine_system_deinit(); return 1; }
+		if (!engine_rendering_capture_is_complete(capture)) {
+			printf("[err]: capture began mid-session, it can't be replayed: `%s`\n", capture_path);
+			engine_rendering_capture_free(capture); engine_rendering_vm_deinit(); engine_system_deinit(); return 1;
+		}
+
+		frames = engine_rendering_capture_get_frames_count(capture);
+		for (u32 frame_i = 0; frame_i < frames; ++frame_i) {
+			engine_rendering_capture_replay(capture, frame_i);
+		}
+
+		engine_rendering_capture_free(capture);
+	}
+	else {
+		// the asset names its native counterpart
+		static u8 shader_fallback[] = "#pragma software(texture_tint)\n";
+		static u8 instanced_shader_fallback[] = "#pragma software(instanced_tint)\n";
+		impl_shader_read("assets/shaders/texture_tint.glsl", &scene_shader,
+			(struct Asset_Shader){.data = shader_fallback, .length = sizeof(shader_fallback) - 1}
+		);
+		impl_shader_read("assets/shaders/instanced_tint.glsl", &scene_instanced_shader,
+			(struct Asset_Shader){.data = instanced_shader_fallback, .length = sizeof(instanced_shader_fallback) - 1}
+		);
+
+		struct Rendering_Buffer * buffer = engine_rendering_buffer_create(0);
+		for (u32 frame_i = 0; frame_i < frames; ++frame_i) {
+			impl_scene(buffer, size, (r32)frame_i / 60);
+
+			u32 const chunks_count = engine_rendering_buffer_get_chunks_count(buffer);
+			for (u32 chunk_i = 0; chunk_i < chunks_count; ++chunk_i) {
+				size_t chunk_length;
+				u8 const * chunk = engine_rendering_buffer_get_chunk(buffer, chunk_i, &chunk_length);
+				engine_rendering_vm_update(chunk, chunk_length);
+			}
+			engine_rendering_vm_end_frame();
+			engine_rendering_buffer_reset(buffer);
+		}
+		engine_rendering_buffer_destroy(buffer);
+
+		if (scene_shader.data != shader_fallback) { ENGINE_FREE(scene_shader.data); }
+		if (scene_instanced_shader.data != instanced_shader_fallback) { ENGINE_FREE(scene_instanced_shader.data); }
+	}
+
+	u32 const * color = engine_rendering_software_get_color(&size);
+	u64 ticks = engine_time_get_ticks() - start_ticks;
+
+	r64 seconds = (r64)ticks / (r64)engine_time_get_precision();
+	printf("%dx%d, threads: %u, frames: %u, ms/frame: %.3f\n",
+		size.x, size.y, hint_settings_software.threads, frames,
+		frames ? seconds * 1e3 / (r64)frames : 0.0
+	);
+
+	bool const saved = impl_save_ppm(output_path, color, size);
+	if (!saved) { printf("[err] can't write \"%s\"\n", output_path); }
+
+	engine_rendering_vm_deinit();
+	engine_system_deinit();
+	return saved ? 0 : 1;
+}
+
+//
+// scene
+//
+
+static void impl_scene(struct Rendering_Buffer * buffer, svec2 size, r32 time) {
+	enum { SHADER = 1, INSTANCED_SHADER = 2, MESH = 1, INSTANCES = 2, TEXTURE = 1, TRANSLUCENT = 1 };
+
+	// resources, reloaded each frame to keep the stream self-contained
+	static r32 const quad[] = {
+		// position        tex_coord
+		-1, -1, 0,   0, 0,
+		 1, -1, 0,   4, 0,
+		 1,  1, 0,   4, 4,
+		-1, -1, 0,   0, 0,
+		 1,  1, 0,   4, 4,
+		-1,  1, 0,   0, 4,
+	};
+	static r32 const instances[] = {
+		// offset           color
+		-7.5f, 0, 0,   1.0f, 0.3f, 0.2f, 1,
+		-5.0f, 0, 0,   1.0f, 0.7f, 0.2f, 1,
+		-2.5f, 0, 0,   0.8f, 1.0f, 0.2f, 1,
+		 0.0f, 0, 0,   0.2f, 1.0f, 0.4f, 1,
+		 2.5f, 0, 0,   0.2f, 0.9f, 1.0f, 1,
+		 5.0f, 0, 0,   0.3f, 0.4f, 1.0f, 1,
+		 7.5f, 0, 0,   0.8f, 0.3f, 1.0f, 1,
+	};
+	static u8 const checker[] = {
+		0xff, 0xff, 0xff, 0xff,   0x40, 0x40, 0x40, 0xff,
+		0x40, 0x40, 0x40, 0xff,   0xff, 0xff, 0xff, 0xff,
+	};
+
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = SHADER}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = SHADER},
+		.asset = scene_shader,
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = MESH},
+		.asset = {
+			.data = (u8 *)quad, .length = sizeof(quad),
+			.type = Data_Type_r32, .attributes = {3, 2},
+		},
+	});
+	engine_rendering_buffer_emit_Shader_Allocate(buffer, (struct RVM_Shader_Allocate){.ref = {.id = INSTANCED_SHADER}});
+	engine_rendering_buffer_emit_Shader_Load(buffer, (struct RVM_Shader_Load){
+		.ref = {.id = INSTANCED_SHADER},
+		.asset = scene_instanced_shader,
+	});
+	engine_rendering_buffer_emit_Mesh_Allocate(buffer, (struct RVM_Mesh_Allocate){
+		.ref = {.id = INSTANCES},
+		.asset = {
+			.data = (u8 *)instances, .length = sizeof(instances),
+			.type = Data_Type_r32, .attributes = {3, 4},
+			.divisor = 1, .location = 2,
+		},
+	});
+	engine_rendering_buffer_emit_Texture_Allocate(buffer, (struct RVM_Texture_Allocate){
+		.ref = {.id = TEXTURE},
+		.asset = {
+			.data = (u8 *)checker, .length = sizeof(checker),
+			.size = {2, 2},
+			.type = Data_Type_u8, .channels = 4,
+			.kind = Texture_Type_Color,
+			.filter_max = Filter_Type_Point,
+			.wrap_x = Wrap_Type_Repeat, .wrap_y = Wrap_Type_Repeat,
+		},
+	});
+
+	// the translucent pass as a pipeline, it differs from the current state in blending only
+	engine_rendering_buffer_emit_Pipeline_Allocate(buffer, (struct RVM_Pipeline_Allocate){
+		.ref = {.id = TRANSLUCENT},
+		.value = {
+			.shader = {.ref = {.id = SHADER}},
+			.color_write = {.value = RVM_Color_Write_All},
+			.blend = {.value = RVM_Color_Blend_Alpha},
+			.depth_read = {.value = true}, .depth_write = {.value = true},
+			.depth_comparison = {.value = RVM_Comparison_LEqual},
+			.stencil_write = {.value = 0xff},
+			.stencil_comparison = {.comparison = RVM_Comparison_True, .mask = 0xff},
+		},
+	});
+
+	// state
+	engine_rendering_buffer_emit_Common_Set_Clip(buffer, (struct RVM_Common_Set_Clip){.lower_left = true, .zero_one = true});
+	engine_rendering_buffer_emit_Common_Set_Viewport(buffer, (struct RVM_Common_Set_Viewport){.pos = SVEC2(0, 0), .size = size});
+	engine_rendering_buffer_emit_Color_Set_Clear(buffer, (struct RVM_Color_Set_Clear){.value = VEC4(0.2f, 0.2f, 0.2f, 1)});
+	engine_rendering_buffer_emit_Depth_Set_Read(buffer, (struct RVM_Depth_Set_Read){.value = true});
+	engine_rendering_buffer_emit_Depth_Set_Comparison(buffer, (struct RVM_Depth_Set_Comparison){.value = RVM_Comparison_LEqual});
+	engine_rendering_buffer_emit_Render_Clear(buffer, (struct RVM_Render_Clear){.mask = RVM_Clear_All});
+
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = SHADER}});
+	engine_rendering_buffer_emit_Mesh_Use(buffer, (struct RVM_Mesh_Use){.ref = {.id = MESH}});
+	engine_rendering_buffer_emit_Unit_Allocate(buffer, (struct RVM_Unit_Allocate){.unit = 0, .texture = {.id = TEXTURE}});
+
+	s32 const unit = 0;
+	mat4 const camera = mat4_set_projection(VEC2(1, (r32)size.x / (r32)size.y), 0.1f, 100, 0);
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = SHADER}, .uniform = RVM_Uniform_u_Camera, .type = Data_Type_mat4, .count = 1,
+	}, &camera, sizeof(camera));
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = SHADER}, .uniform = RVM_Uniform_u_Texture, .type = Data_Type_unit_id, .count = 1,
+	}, &unit, sizeof(unit));
+
+	// an opaque ground, then a tinted translucent quad crossing it
+	mat4 const ground = mat4_set_transformation(VEC3(0, -1, 4), VEC3(3, 3, 3), quat_set_radians(VEC3(TAU / 4, time, 0)));
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = SHADER}, .uniform = RVM_Uniform_u_Transform, .type = Data_Type_mat4, .count = 1,
+	}, &ground, sizeof(ground));
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = SHADER}, .uniform = RVM_Uniform_u_Color, .type = Data_Type_vec4, .count = 1,
+	}, &VEC4(1, 1, 1, 1), sizeof(vec4));
+	engine_rendering_buffer_emit_Color_Set_Blend(buffer, (struct RVM_Color_Set_Blend){.value = RVM_Color_Blend_Opaque});
+	engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+
+	// a row of tiles in a single draw, offset and tinted per instance
+	mat4 const row = mat4_set_transformation(VEC3(0, 0.6f, 4), VEC3(0.2f, 0.2f, 0.2f), quat_set_radians(VEC3(0, 0, 0)));
+	engine_rendering_buffer_emit_Shader_Use(buffer, (struct RVM_Shader_Use){.ref = {.id = INSTANCED_SHADER}});
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = INSTANCED_SHADER}, .uniform = RVM_Uniform_u_Camera, .type = Data_Type_mat4, .count = 1,
+	}, &camera, sizeof(camera));
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = INSTANCED_SHADER}, .uniform = RVM_Uniform_u_Texture, .type = Data_Type_unit_id, .count = 1,
+	}, &unit, sizeof(unit));
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = INSTANCED_SHADER}, .uniform = RVM_Uniform_u_Transform, .type = Data_Type_mat4, .count = 1,
+	}, &row, sizeof(row));
+	engine_rendering_buffer_emit_Render_Draw_Instanced(buffer, (struct RVM_Render_Draw_Instanced){
+		.offset = 0, .length = 6,
+		.instances = {.id = INSTANCES}, .instances_offset = 0, .count = sizeof(instances) / (7 * sizeof(r32)),
+	});
+
+	mat4 const panel = mat4_set_transformation(VEC3(0, -0.25f, 3), VEC3(1, 1, 1), quat_set_radians(VEC3(0, TAU / 8 + time, 0)));
+	engine_rendering_buffer_emit_Pipeline_Use(buffer, (struct RVM_Pipeline_Use){.ref = {.id = TRANSLUCENT}});
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = SHADER}, .uniform = RVM_Uniform_u_Transform, .type = Data_Type_mat4, .count = 1,
+	}, &panel, sizeof(panel));
+	engine_rendering_buffer_emit_uniform(buffer, (struct RVM_Shader_Uniform){
+		.ref = {.id = SHADER}, .uniform = RVM_Uniform_u_Color, .type = Data_Type_vec4, .count = 1,
+	}, &VEC4(1, 0.3f, 0.2f, 0.6f), sizeof(vec4));
+	engine_rendering_buffer_emit_Render_Draw(buffer, (struct RVM_Render_Draw){.offset = 0, .length = 6});
+
+	// release
+	engine_rendering_buffer_emit_Pipeline_Free(buffer, (struct RVM_Pipeline_Free){.ref = {.id = TRANSLUCENT}});
+	engine_rendering_buffer_emit_Unit_Free(buffer, (struct RVM_Unit_Free){.unit = 0});
+	engine_rendering_buffer_emit_Texture_Free(buffer, (struct RVM_Texture_Free){.ref = {.id = TEXTURE}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = INSTANCES}});
+	engine_rendering_buffer_emit_Mesh_Free(buffer, (struct RVM_Mesh_Free){.ref = {.id = MESH}});
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = INSTANCED_SHADER}});
+	engine_rendering_buffer_emit_Shader_Free(buffer, (struct RVM_Shader_Free){.ref = {.id = SHADER}});
+}
+
+static void impl_shader_read(cstring path, struct Asset_Shader * asset, struct Asset_Shader fallback) {
+	engine_file_read(path, &asset->data, &asset->length);
+	if (!asset->data) { *asset = fallback; }
+}
+
+//
+// output
+//
+
+static bool impl_save_ppm(cstring path, u32 const * color, svec2 size) {
+	char header[32];
+	int const header_length = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", size.x, size.y);
+	if (header_length < 0) { return false; }
+
+	size_t const length = (size_t)header_length + (size_t)size.x * (size_t)size.y * 3;
+	u8 * buffer = ENGINE_MALLOC(length);
+	if (!buffer) { return false; }
+
+	// rows go top down in the image
+	memcpy(buffer, header, (size_t)header_length);
+	u8 * target = buffer + header_length;
+	for (s32 y = size.y - 1; y >= 0; --y) {
+		u32 const * row = color + (size_t)y * (size_t)size.x;
+		for (s32 x = 0; x < size.x; ++x) {
+			*(target++) = (u8)(row[x] >>  0);
+			*(target++) = (u8)(row[x] >>  8);
+			*(target++) = (u8)(row[x] >> 16);
+		}
+	}
+
+	bool const result = engine_file_write(path, buffer, length);
+	ENGINE_FREE(buffer);
+	return result;
+}